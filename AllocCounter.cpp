@@ -0,0 +1,73 @@
+#include "AllocCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<bool> s_enabled{ false };
+
+// a plain integer per thread: no initializer to run, so it is safe to touch from
+// inside operator new, before or after the thread's other locals exist
+thread_local std::uint64_t t_allocations = 0;
+
+void* allocate(std::size_t size)
+{
+    if (s_enabled.load(std::memory_order_relaxed))
+        ++t_allocations;
+    // malloc(0) may return null; operator new must not
+    if (void* p = std::malloc(size > 0 ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void AllocCounter::enable()
+{
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+bool AllocCounter::enabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocCounter::thisThread()
+{
+    return t_allocations;
+}
+
+// the standard library's nothrow and sized forms call these, so replacing the
+// plain ones covers every unaligned allocation in the program
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,40 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstdint>
+
+/**
+ * @brief counts heap allocations, per thread, to find them in the frame loop
+ * @details AllocCounter.cpp replaces the global operator new and delete. Until
+ * enable() is called they only forward to malloc and free; after it, every
+ * operator new also bumps a counter owned by the calling thread, so the sim
+ * thread can measure one tick while the render, audio and writer threads go on
+ * allocating as they please. malloc calls made by C libraries (the GL driver,
+ * the sound backend) are not seen.
+ */
+namespace AllocCounter {
+
+/**
+ * @brief start counting; there is no stopping, the cost is one relaxed load
+ */
+void enable();
+
+/**
+ * @brief whether enable() has been called
+ *
+ * @return true if allocations are being counted
+ */
+bool enabled();
+
+/**
+ * @brief allocations the calling thread has made since counting started
+ * @details Take it before and after a piece of work; the difference is what that
+ * work allocated.
+ *
+ * @return std::uint64_t operator new calls on this thread
+ */
+std::uint64_t thisThread();
+
+} // namespace AllocCounter
+
+#endif // ALLOCCOUNTER_H
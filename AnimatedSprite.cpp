@@ -1,17 +1,25 @@
 #include "AnimatedSprite.h"
+#include "FrameBuffer.h"
+#include "ResourceCache.h"
+
+#include <cmath>
 
 // Constructor initializes the frame time, loop flag, and other member variables.
 AnimatedSprite::AnimatedSprite(sf::Time frameTime, bool loop)
-    : m_frameTime(frameTime)
+    : m_texture(nullptr)
+    , m_frameTime(frameTime)
     , m_elapsedTime(sf::Time::Zero)
     , m_currentFrame(0)
     , m_isPlaying(false)
     , m_loop(loop)
 {
+    // room for any frame set, so switching animations copies without allocating
+    m_frames.reserve(RESERVED_FRAMES);
 }
 
 bool AnimatedSprite::loadTexture(const std::string& filename) {
-    return m_texture.loadFromFile(filename);
+    m_texture = &ResourceCache::texture(filename);
+    return m_texture->getSize().x > 0;
 }
 
 void AnimatedSprite::addFrame(const sf::IntRect& frame) {
@@ -20,7 +28,8 @@ void AnimatedSprite::addFrame(const sf::IntRect& frame) {
 
 void AnimatedSprite::setup() {
     // Assign the texture to the sprite and set the first frame.
-    m_sprite.setTexture(m_texture);
+    if (m_texture)
+        m_sprite.setTexture(*m_texture);
     if (!m_frames.empty()) {
         m_sprite.setTextureRect(m_frames[0]);
     }
@@ -68,7 +77,8 @@ void AnimatedSprite::update(sf::Time dt) {
 }
 
 void AnimatedSprite::setFrames(const std::vector<sf::IntRect>& frames) {
-    m_frames = frames;
+    // into the storage already there, which fits anything up to RESERVED_FRAMES
+    m_frames.assign(frames.begin(), frames.end());
     m_currentFrame = 0;
     // Reset the elapsed time and set the first frame.
     m_elapsedTime = sf::Time::Zero;
@@ -85,7 +95,13 @@ sf::FloatRect AnimatedSprite::getGlobalBounds() const {
     return getTransform().transformRect(m_sprite.getGlobalBounds());
 }
 
-void AnimatedSprite::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    states.transform *= getTransform();
-    target.draw(m_sprite, states);
+void AnimatedSprite::render(FrameSnapshot& frame) const {
+    // the sprite's corner moved onto a whole native pixel, as the glyph pen and the
+    // maze camera are, so a sprite gliding between tiles keeps every texel intact
+    const float pixel = static_cast<float>(FrameBuffer::LAYOUT_SCALE);
+    sf::Transform transform = getTransform();
+    sf::Vector2f corner = transform.transformPoint(0.f, 0.f);
+    sf::Transform snap;
+    snap.translate(std::round(corner.x / pixel) * pixel - corner.x, std::round(corner.y / pixel) * pixel - corner.y);
+    frame.addSprite(m_sprite, snap * transform);
 }
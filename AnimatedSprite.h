@@ -1,16 +1,21 @@
 #ifndef ANIMATEDSPRITE_H
 #define ANIMATEDSPRITE_H
 
+#include "FrameSnapshot.h"
+
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
 
-class AnimatedSprite : public sf::Drawable, public sf::Transformable {
+class AnimatedSprite : public sf::Transformable {
 public:
+    // frames kept room for up front; longer sets still work, they allocate once
+    static constexpr std::size_t RESERVED_FRAMES = 8;
+
     // frameTime: time each frame is shown; loop: whether to loop the animation.
     AnimatedSprite(sf::Time frameTime = sf::seconds(0.1f), bool loop = true);
 
-    // Load the sprite sheet texture.
+    // Use a sprite sheet from the ResourceCache; every sprite on it shares one texture.
     bool loadTexture(const std::string& filename);
 
     // Add a frame (an sf::IntRect) to the animation.
@@ -33,11 +38,11 @@ public:
     sf::FloatRect getLocalBounds() const;
     sf::FloatRect getGlobalBounds() const;
 
-private:
-    // Draw the animated sprite (called by SFML).
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    // Record the current frame into a snapshot.
+    void render(FrameSnapshot& frame) const;
 
-    sf::Texture m_texture;
+private:
+    const sf::Texture* m_texture;
     std::vector<sf::IntRect> m_frames;
     sf::Sprite m_sprite;
     sf::Time m_frameTime;
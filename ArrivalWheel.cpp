@@ -0,0 +1,69 @@
+#include "ArrivalWheel.h"
+
+ArrivalWheel::ArrivalWheel(std::size_t actors)
+    : m_ticks(actors, UNFILED)
+    , m_nextLink(actors, NONE)
+    , m_prevLink(actors, NONE)
+    , m_slots(SLOTS, NONE)
+{
+    // every actor can come due on the same tick
+    m_due.reserve(actors);
+}
+
+void ArrivalWheel::schedule(Actor actor, std::uint64_t tick)
+{
+    if (m_ticks[actor] != UNFILED)
+        unfile(actor);
+    if (tick < m_next)
+        tick = m_next;
+    file(actor, tick < UNFILED ? tick : UNFILED - 1);
+}
+
+void ArrivalWheel::cancel(Actor actor)
+{
+    if (m_ticks[actor] != UNFILED)
+        unfile(actor);
+}
+
+const std::vector<ArrivalWheel::Actor>& ArrivalWheel::due()
+{
+    // take them all out first, so the caller can file them again while going through
+    m_due.clear();
+    Actor actor = m_slots[static_cast<std::size_t>(m_next & (SLOTS - 1))];
+    while (actor != NONE) {
+        Actor next = m_nextLink[actor];
+        if (m_ticks[actor] == m_next) {
+            unfile(actor);
+            m_due.push_back(actor);
+        }
+        actor = next;
+    }
+    ++m_next;
+    return m_due;
+}
+
+void ArrivalWheel::file(Actor actor, std::uint64_t tick)
+{
+    Actor& head = m_slots[static_cast<std::size_t>(tick & (SLOTS - 1))];
+    m_ticks[actor] = tick;
+    m_prevLink[actor] = NONE;
+    m_nextLink[actor] = head;
+    if (head != NONE)
+        m_prevLink[head] = actor;
+    head = actor;
+    ++m_size;
+}
+
+void ArrivalWheel::unfile(Actor actor)
+{
+    Actor prev = m_prevLink[actor];
+    Actor next = m_nextLink[actor];
+    if (prev != NONE)
+        m_nextLink[prev] = next;
+    else
+        m_slots[static_cast<std::size_t>(m_ticks[actor] & (SLOTS - 1))] = next;
+    if (next != NONE)
+        m_prevLink[next] = prev;
+    m_ticks[actor] = UNFILED;
+    --m_size;
+}
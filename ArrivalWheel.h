@@ -0,0 +1,90 @@
+#ifndef ARRIVALWHEEL_H
+#define ARRIVALWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief actors filed under the tick they next have something to decide
+ * @details A hashed timing wheel laid out like TimerWheel: SLOTS slots, and an
+ * actor due at tick t is linked into slot t mod SLOTS through links the wheel
+ * keeps for every actor, so filing, refiling and cancelling are O(1) and nothing
+ * allocates after construction. Most of an actor's ticks are spent between two
+ * tiles with nothing to decide, so a sim asks due() for the actors whose tick has
+ * come, brings only those up to date (TileMover::advance), decides their next move
+ * and files them again under the arrival TileMover::ticksToArrival() gives. A tick
+ * then costs the arrivals in it, not the size of the crowd. A tick further off
+ * than the wheel is wide still works; the actor just stays in its slot for another
+ * lap.
+ */
+class ArrivalWheel
+{
+public:
+    using Actor = std::uint32_t;
+
+    /**
+     * @brief an empty wheel whose next tick is 0
+     *
+     * @param actors how many actors it can hold, numbered from 0
+     */
+    explicit ArrivalWheel(std::size_t actors);
+
+    /**
+     * @brief file an actor under a tick, replacing any tick it was filed under
+     * @details A tick that due() has already returned counts as the next one, so
+     * an actor is never lost.
+     *
+     * @param actor below the count the wheel was made for
+     * @param tick when it next has to be looked at
+     */
+    void schedule(Actor actor, std::uint64_t tick);
+
+    /**
+     * @brief take an actor off the wheel, e.g. one that has stopped
+     */
+    void cancel(Actor actor);
+
+    /**
+     * @brief whether an actor is waiting for its tick
+     */
+    bool scheduled(Actor actor) const { return m_ticks[actor] != UNFILED; }
+
+    /**
+     * @brief take the actors due at the next tick and move on to the one after
+     * @details Ticks come out in order, one per call, starting at 0. Actors
+     * scheduled while going through the list are filed for later ticks.
+     *
+     * @return const std::vector<Actor>& actors due; valid until the next call
+     */
+    const std::vector<Actor>& due();
+
+    /**
+     * @brief the tick the next due() call returns
+     */
+    std::uint64_t next() const { return m_next; }
+
+    /**
+     * @brief actors filed and not yet returned
+     */
+    std::size_t size() const { return m_size; }
+
+private:
+    static constexpr std::size_t SLOTS = 64;   // a power of two; a tile takes 20 ticks at the slowest table speed
+    static constexpr Actor NONE = 0xFFFFFFFFu;
+    static constexpr std::uint64_t UNFILED = ~std::uint64_t(0);
+
+    void file(Actor actor, std::uint64_t tick);
+    void unfile(Actor actor);
+
+    // an actor's links, one array each: walking a slot only reads ticks and nexts
+    std::vector<std::uint64_t> m_ticks;   // UNFILED when not linked into a slot
+    std::vector<Actor> m_nextLink;
+    std::vector<Actor> m_prevLink;
+    std::vector<Actor> m_slots;   // first actor in each slot's list
+    std::vector<Actor> m_due;     // reused by due(); room for every actor
+    std::uint64_t m_next = 0;
+    std::size_t m_size = 0;
+};
+
+#endif // ARRIVALWHEEL_H
@@ -0,0 +1,267 @@
+#include "AudioEngine.h"
+
+#include <SFML/Audio/SoundStream.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+/**
+ * @brief the system device: SFML pulls blocks from the mixer on its own thread
+ */
+class MixerStream : public sf::SoundStream
+{
+public:
+    explicit MixerStream(AudioEngine& engine)
+        : m_engine(engine)
+    {
+        initialize(1, SoundBank::SAMPLE_RATE);
+    }
+
+    ~MixerStream() override { stop(); }
+
+private:
+    bool onGetData(Chunk& data) override
+    {
+        m_engine.mix(m_block.data(), m_block.size());
+        data.samples = m_block.data();
+        data.sampleCount = m_block.size();
+        return true;
+    }
+
+    void onSeek(sf::Time) override {}
+
+    AudioEngine& m_engine;
+    std::array<std::int16_t, AudioEngine::BLOCK_FRAMES> m_block{};
+};
+
+namespace {
+
+constexpr std::uint64_t UNITY_STEP = std::uint64_t(1) << 32;
+
+// mix level of each effect, in Sound order
+constexpr float GAIN[] = { 0.8f, 0.45f, 0.45f, 0.9f, 0.9f };
+static_assert(sizeof(GAIN) / sizeof(GAIN[0]) == static_cast<std::size_t>(Sound::Count), "one gain per sound");
+
+std::uint64_t stepFor(float pitch)
+{
+    return static_cast<std::uint64_t>(std::max(0.05f, pitch) * static_cast<float>(UNITY_STEP));
+}
+
+} // namespace
+
+AudioEngine& AudioEngine::instance()
+{
+    static AudioEngine engine;
+    return engine;
+}
+
+AudioEngine::~AudioEngine()
+{
+    stop();
+}
+
+AudioEngine::Device AudioEngine::start(Device device)
+{
+    if (device == Device::Off)
+        return m_device = Device::Off;
+
+    m_bank.load();
+
+    if (device == Device::System) {
+        m_stream = std::make_unique<MixerStream>(*this);
+        m_stream->play();
+        if (m_stream->getStatus() != sf::SoundSource::Playing) {
+            std::cerr << "No audio device, mixing to the null device" << std::endl;
+            m_stream.reset();
+            device = Device::Null;
+        }
+    }
+
+    m_device = device;
+    if (device == Device::Null) {
+        m_running = true;
+        m_nullThread = std::thread(&AudioEngine::runNullDevice, this);
+    }
+    return m_device;
+}
+
+void AudioEngine::stop()
+{
+    m_running = false;
+    if (m_nullThread.joinable())
+        m_nullThread.join();
+    m_stream.reset();
+    m_device = Device::Off;
+}
+
+void AudioEngine::runNullDevice()
+{
+    // keep real-time pace so commands land in the same blocks they would on a sound card
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(BLOCK_FRAMES) / SoundBank::SAMPLE_RATE));
+    std::array<std::int16_t, BLOCK_FRAMES> block;
+    auto next = Clock::now();
+    while (m_running) {
+        mix(block.data(), block.size());
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void AudioEngine::play(Sound sound)
+{
+    if (m_device != Device::Off)
+        push({ Command::Type::Play, sound, 1.f });
+}
+
+void AudioEngine::loop(Sound sound)
+{
+    if (m_device != Device::Off)
+        push({ Command::Type::Loop, sound, 1.f });
+}
+
+void AudioEngine::stopLoop()
+{
+    if (m_device != Device::Off)
+        push({ Command::Type::StopLoop, Sound::Count, 1.f });
+}
+
+void AudioEngine::setSirenPitch(float pitch)
+{
+    if (m_device != Device::Off)
+        push({ Command::Type::SirenPitch, Sound::Siren, pitch });
+}
+
+void AudioEngine::push(const Command& command)
+{
+    std::size_t head = m_queueHead.load(std::memory_order_relaxed);
+    std::size_t next = (head + 1) % QUEUE_SIZE;
+    if (next == m_queueTail.load(std::memory_order_acquire)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_queue[head] = command;
+    m_queueHead.store(next, std::memory_order_release);
+}
+
+std::uint64_t AudioEngine::loopStep() const
+{
+    return m_loop.sound == Sound::Siren ? stepFor(m_sirenPitch) : UNITY_STEP;
+}
+
+void AudioEngine::apply(const Command& command)
+{
+    switch (command.type) {
+    case Command::Type::Play: {
+        // a waka still sounding is the arcade's rhythm: let it finish
+        if (command.sound == Sound::Waka) {
+            for (const Voice& v : m_voices) {
+                if (v.active && v.sound == Sound::Waka)
+                    return;
+            }
+        }
+        Voice* voice = &m_voices[0];
+        for (Voice& v : m_voices) {
+            if (!v.active) {
+                voice = &v;
+                break;
+            }
+            if (v.started < voice->started)
+                voice = &v;
+        }
+        if (voice->active)
+            ++m_stolen;
+        *voice = Voice{ command.sound, 0, UNITY_STEP, m_blocks, true };
+        ++m_started;
+        break;
+    }
+    case Command::Type::Loop: {
+        const std::vector<std::int16_t>& samples = m_bank.samples(command.sound);
+        if (samples.empty() || (m_loop.active && m_loop.sound == command.sound))
+            break;
+        // same point in time, new track: no gap at the switch
+        std::uint64_t length = static_cast<std::uint64_t>(samples.size()) << 32;
+        m_loop.position = m_loop.active ? m_loop.position % length : 0;
+        m_loop.sound = command.sound;
+        m_loop.active = true;
+        m_loop.step = loopStep();
+        break;
+    }
+    case Command::Type::StopLoop:
+        m_loop.active = false;
+        break;
+    case Command::Type::SirenPitch:
+        m_sirenPitch = command.value;
+        m_loop.step = loopStep();
+        break;
+    }
+}
+
+void AudioEngine::render(Voice& voice, bool looping, std::int32_t* mix, std::size_t frames)
+{
+    const std::vector<std::int16_t>& samples = m_bank.samples(voice.sound);
+    if (samples.empty()) {
+        voice.active = false;
+        return;
+    }
+    const std::size_t length = samples.size();
+    const std::uint64_t end = static_cast<std::uint64_t>(length) << 32;
+    const float gain = GAIN[static_cast<std::size_t>(voice.sound)];
+
+    for (std::size_t i = 0; i < frames; ++i) {
+        std::size_t at = static_cast<std::size_t>(voice.position >> 32);
+        float fraction = static_cast<float>(voice.position & 0xFFFFFFFFu) * (1.f / 4294967296.f);
+        float here = samples[at];
+        float next = at + 1 < length ? samples[at + 1] : (looping ? samples[0] : 0.f);
+        mix[i] += static_cast<std::int32_t>((here + (next - here) * fraction) * gain);
+
+        voice.position += voice.step;
+        if (voice.position >= end) {
+            if (!looping) {
+                voice.active = false;
+                return;
+            }
+            voice.position %= end;
+        }
+    }
+}
+
+void AudioEngine::mix(std::int16_t* out, std::size_t frames)
+{
+    std::size_t tail = m_queueTail.load(std::memory_order_relaxed);
+    while (tail != m_queueHead.load(std::memory_order_acquire)) {
+        apply(m_queue[tail]);
+        tail = (tail + 1) % QUEUE_SIZE;
+        m_queueTail.store(tail, std::memory_order_release);
+    }
+
+    std::array<std::int32_t, BLOCK_FRAMES> accumulator{};
+    frames = std::min(frames, BLOCK_FRAMES);
+    if (m_loop.active)
+        render(m_loop, true, accumulator.data(), frames);
+    std::size_t playing = 0;
+    for (Voice& voice : m_voices) {
+        if (voice.active) {
+            ++playing;
+            render(voice, false, accumulator.data(), frames);
+        }
+    }
+    m_peakVoices = std::max(m_peakVoices, playing);
+    ++m_blocks;
+
+    for (std::size_t i = 0; i < frames; ++i) {
+        out[i] = static_cast<std::int16_t>(std::clamp<std::int32_t>(accumulator[i],
+            std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max()));
+    }
+}
+
+void AudioEngine::report(std::ostream& out) const
+{
+    out << "Audio mixer\n"
+        << "blocks mixed        " << m_blocks << " (" << BLOCK_FRAMES << " frames at " << SoundBank::SAMPLE_RATE << " Hz)\n"
+        << "one-shots started   " << m_started << ", stolen " << m_stolen << ", peak " << m_peakVoices << " of " << VOICES << " voices\n"
+        << "commands dropped    " << m_dropped.load() << '\n';
+}
@@ -0,0 +1,146 @@
+#ifndef AUDIOENGINE_H
+#define AUDIOENGINE_H
+
+#include "SoundBank.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <thread>
+
+class MixerStream;
+
+/**
+ * @brief software mixer that plays the sound bank through a fixed voice pool
+ * @details Everything is allocated in start(): the decoded buffers, the voices and
+ * the command queue. During play the simulation thread only pushes small commands
+ * into a lock-free queue, and the audio thread applies them at the start of each
+ * mixed block of about 12 ms, so triggering a sound never allocates or locks.
+ * One-shots share VOICES voices; when all are busy the oldest is stolen. The
+ * background loop has a voice of its own. Switching loops or changing the siren's
+ * pitch takes effect on the next sample, with no gap.
+ *
+ * Output goes to the system audio device through SFML, or to a null device that
+ * mixes in real time and discards the result, for headless runs and tests.
+ */
+class AudioEngine
+{
+public:
+    enum class Device
+    {
+        System,    // the default sound card, falling back to Null if it cannot open
+        Null,      // mix on a timer thread and throw the samples away
+        Off        // no mixing at all; every trigger returns straight away
+    };
+
+    static constexpr std::size_t VOICES = 8;
+    static constexpr std::size_t BLOCK_FRAMES = 512;
+
+    /**
+     * @brief get the process-wide engine
+     */
+    static AudioEngine& instance();
+
+    /**
+     * @brief load the sound bank and open an output device
+     *
+     * @param device where to send the mix
+     * @return Device the device actually opened
+     */
+    Device start(Device device);
+
+    /**
+     * @brief stop mixing and close the device; call before exit
+     */
+    void stop();
+
+    /**
+     * @brief start a one-shot effect; a waka already playing is left to finish
+     * @details Simulation thread only, like every trigger below.
+     */
+    void play(Sound sound);
+
+    /**
+     * @brief make sound the background loop, continuing from the same point in time
+     */
+    void loop(Sound sound);
+
+    /**
+     * @brief silence the background loop
+     */
+    void stopLoop();
+
+    /**
+     * @brief playback rate of the siren loop, 1 for its recorded pitch
+     */
+    void setSirenPitch(float pitch);
+
+    /**
+     * @brief mix the next frames of mono output; audio thread only
+     *
+     * @param out destination, frames samples
+     * @param frames at most BLOCK_FRAMES
+     */
+    void mix(std::int16_t* out, std::size_t frames);
+
+    /**
+     * @brief print what the mixer did, for null-device runs
+     *
+     * @param out stream to write to
+     */
+    void report(std::ostream& out) const;
+
+private:
+    AudioEngine() = default;
+    ~AudioEngine();
+
+    struct Voice
+    {
+        Sound sound = Sound::Count;
+        std::uint64_t position = 0;   // 32.32 fixed-point sample index
+        std::uint64_t step = 0;       // added per output sample; 1 << 32 is the recorded pitch
+        std::uint64_t started = 0;    // block it started in, to steal the oldest
+        bool active = false;
+    };
+
+    struct Command
+    {
+        enum class Type : std::uint8_t { Play, Loop, StopLoop, SirenPitch } type;
+        Sound sound;
+        float value;
+    };
+
+    void push(const Command& command);
+    void apply(const Command& command);
+    void render(Voice& voice, bool looping, std::int32_t* mix, std::size_t frames);
+    std::uint64_t loopStep() const;
+    void runNullDevice();
+
+    SoundBank m_bank;
+    Device m_device = Device::Off;
+
+    // simulation thread -> audio thread, single producer and single consumer
+    static constexpr std::size_t QUEUE_SIZE = 64;
+    std::array<Command, QUEUE_SIZE> m_queue{};
+    std::atomic<std::size_t> m_queueHead{ 0 };   // next slot to write
+    std::atomic<std::size_t> m_queueTail{ 0 };   // next slot to read
+    std::atomic<std::uint64_t> m_dropped{ 0 };   // commands lost to a full queue
+
+    // audio thread only
+    std::array<Voice, VOICES> m_voices{};
+    Voice m_loop;
+    float m_sirenPitch = 1.f;
+    std::uint64_t m_blocks = 0;
+    std::uint64_t m_started = 0;
+    std::uint64_t m_stolen = 0;
+    std::size_t m_peakVoices = 0;
+
+    std::unique_ptr<MixerStream> m_stream;
+    std::thread m_nullThread;
+    std::atomic<bool> m_running{ false };
+};
+
+#endif // AUDIOENGINE_H
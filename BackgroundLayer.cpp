@@ -0,0 +1,54 @@
+#include "BackgroundLayer.h"
+
+#include <iostream>
+
+bool BackgroundLayer::create(unsigned int width, unsigned int height, const sf::View& view)
+{
+    if (!m_texture.create(width, height)) {
+        std::cerr << "Failed to create background layer " << width << "x" << height << std::endl;
+        return false;
+    }
+    m_texture.setView(view);
+    m_texture.clear(sf::Color::Black);
+
+    // cover the view's area when drawn back
+    m_sprite.setTexture(m_texture.getTexture(), true);
+    m_sprite.setScale(view.getSize().x / static_cast<float>(width), view.getSize().y / static_cast<float>(height));
+    m_sprite.setPosition(view.getCenter() - view.getSize() / 2.f);
+    m_dirty = true;
+    return true;
+}
+
+void BackgroundLayer::paint(const sf::Drawable& drawable)
+{
+    m_texture.draw(drawable);
+    m_dirty = true;
+}
+
+void BackgroundLayer::fill(const sf::FloatRect& region, const sf::Color& color)
+{
+    // four vertices on the stack; an sf::RectangleShape would allocate its own
+    float right = region.left + region.width;
+    float bottom = region.top + region.height;
+    const sf::Vertex quad[] = {
+        sf::Vertex(sf::Vector2f(region.left, region.top), color),
+        sf::Vertex(sf::Vector2f(right, region.top), color),
+        sf::Vertex(sf::Vector2f(region.left, bottom), color),
+        sf::Vertex(sf::Vector2f(right, bottom), color),
+    };
+    m_texture.draw(quad, 4, sf::TriangleStrip);
+    m_dirty = true;
+}
+
+void BackgroundLayer::commit()
+{
+    if (!m_dirty)
+        return;
+    m_texture.display();
+    m_dirty = false;
+}
+
+void BackgroundLayer::draw(CountedTarget& target) const
+{
+    target.draw(m_sprite);
+}
@@ -0,0 +1,62 @@
+#ifndef BACKGROUNDLAYER_H
+#define BACKGROUNDLAYER_H
+
+#include "CountedTarget.h"
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief a persistent off-screen copy of everything that rarely changes
+ * @details The static scene is painted into a render texture once; later changes
+ * are painted over just the regions they touch. Drawing the layer is then a single
+ * full-screen quad, however much has been patched since it was created.
+ */
+class BackgroundLayer
+{
+public:
+    /**
+     * @brief allocate the layer and clear it to black
+     * @details The layer is drawn back stretched over the view's area, so it can
+     * be stored at a lower resolution than the coordinates painted into it.
+     *
+     * @param width width in pixels
+     * @param height height in pixels
+     * @param view area painted into and covered when drawn
+     * @return true if the render texture could be created
+     */
+    bool create(unsigned int width, unsigned int height, const sf::View& view);
+
+    /**
+     * @brief paint something on top of the layer
+     *
+     * @param drawable anything SFML can draw, in layer coordinates
+     */
+    void paint(const sf::Drawable& drawable);
+
+    /**
+     * @brief fill one region with a solid colour
+     *
+     * @param region rectangle in layer coordinates
+     * @param color fill colour
+     */
+    void fill(const sf::FloatRect& region, const sf::Color& color);
+
+    /**
+     * @brief publish pending patches to the texture; cheap when nothing changed
+     */
+    void commit();
+
+    /**
+     * @brief draw the layer as one quad over its view's area
+     *
+     * @param target target to draw into
+     */
+    void draw(CountedTarget& target) const;
+
+private:
+    sf::RenderTexture m_texture;
+    sf::Sprite m_sprite;
+    bool m_dirty = false;
+};
+
+#endif // BACKGROUNDLAYER_H
@@ -0,0 +1,491 @@
+#include "Benchmarks.h"
+#include "ArrivalWheel.h"
+#include "GhostDecisions.h"
+#include "Leaderboard.h"
+#include "LevelParams.h"
+#include "MazeGenerator.h"
+#include "PelletBoard.h"
+#include "ScoreSnapshot.h"
+#include "TileMover.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+double secondsSince(BenchClock::time_point start)
+{
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+void report(const char* label, double seconds, std::size_t operations)
+{
+    std::cout << std::left << std::setw(28) << label
+              << std::right << std::fixed << std::setprecision(3) << std::setw(9) << seconds << " s";
+    if (operations > 0)
+        std::cout << std::setw(10) << std::setprecision(1) << seconds * 1e9 / static_cast<double>(operations) << " ns/op";
+    std::cout << '\n';
+}
+
+// what the generator promises: mirrored, no dead ends, one connected maze, a house
+bool checkMaze(const MazeLayout& maze, std::string& problem)
+{
+    auto passable = [&maze](int x, int y) {
+        std::uint8_t tile = maze.at(x, y);
+        return tile == MazeLayout::Empty || tile == MazeLayout::Dot || tile == MazeLayout::Energizer;
+    };
+    auto neighbours = [&maze](int x, int y, sf::Vector2i* out) {
+        out[0] = { x, y - 1 };
+        out[1] = { x, y + 1 };
+        out[2] = { x > 0 ? x - 1 : maze.columns - 1, y };   // tunnels wrap
+        out[3] = { x + 1 < maze.columns ? x + 1 : 0, y };
+    };
+
+    std::size_t open = 0;
+    for (int y = 0; y < maze.rows; ++y) {
+        for (int x = 0; x < maze.columns; ++x) {
+            if (maze.at(x, y) != maze.at(maze.columns - 1 - x, y)) {
+                problem = "not mirrored";
+                return false;
+            }
+            if (!passable(x, y))
+                continue;
+            ++open;
+            sf::Vector2i around[4];
+            neighbours(x, y, around);
+            int exits = 0;
+            for (const sf::Vector2i& n : around)
+                exits += n.y >= 0 && n.y < maze.rows && passable(n.x, n.y);
+            if (exits < 2) {
+                problem = "dead end at " + std::to_string(x) + "," + std::to_string(y);
+                return false;
+            }
+        }
+    }
+
+    // flood from Pac-Man's start; every corridor must be reached
+    std::vector<std::uint8_t> seen(maze.tiles.size(), 0);
+    std::vector<sf::Vector2i> pending{ maze.pacStart };
+    seen[static_cast<std::size_t>(maze.pacStart.y * maze.columns + maze.pacStart.x)] = 1;
+    std::size_t reached = 0;
+    while (!pending.empty()) {
+        sf::Vector2i tile = pending.back();
+        pending.pop_back();
+        ++reached;
+        sf::Vector2i around[4];
+        neighbours(tile.x, tile.y, around);
+        for (const sf::Vector2i& n : around) {
+            if (n.y < 0 || n.y >= maze.rows || !passable(n.x, n.y))
+                continue;
+            std::uint8_t& mark = seen[static_cast<std::size_t>(n.y * maze.columns + n.x)];
+            if (!mark) {
+                mark = 1;
+                pending.push_back(n);
+            }
+        }
+    }
+    if (!passable(maze.pacStart.x, maze.pacStart.y) || reached != open) {
+        problem = "only " + std::to_string(reached) + " of " + std::to_string(open) + " corridor tiles connected";
+        return false;
+    }
+
+    for (const sf::Vector2i& start : maze.ghostStarts) {
+        if (maze.at(start.x, start.y) != MazeLayout::GhostHome) {
+            problem = "ghost starts outside the house";
+            return false;
+        }
+    }
+    return true;
+}
+
+// one crowd moved for ten seconds both ways; false if they end up apart
+bool compareMoverSchedules(std::size_t count, std::size_t movingEvery)
+{
+    // every actor starts somewhere on a 32x32 torus at one of the table's speeds, or parked
+    const int GRID = 32;
+    const int TICKS = 10 * TileMover::TICKS_PER_SECOND;
+    const sf::Vector2i DIRS[4] = { { 0, -1 }, { -1, 0 }, { 0, 1 }, { 1, 0 } };
+    std::vector<TileMover> crowd;
+    crowd.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int cell = static_cast<int>(i % (GRID * GRID));
+        crowd.emplace_back(sf::Vector2i(cell % GRID, cell / GRID));
+        float speed = LevelParams::BASE_TILES_PER_SECOND * (0.4f + 0.1f * static_cast<float>(i % 17));
+        crowd.back().setSpeed(i % movingEvery == 0 ? TileMover::speedPerTick(speed) : 0);
+    }
+
+    // the decision an actor at rest makes: wrap onto the grid, turn by a hash
+    auto decide = [&](TileMover& m, int tick) {
+        sf::Vector2i tile = m.tile();
+        tile.x = (tile.x + GRID) % GRID;
+        tile.y = (tile.y + GRID) % GRID;
+        m.wrapTo(tile);
+        std::uint32_t hash = (static_cast<std::uint32_t>(tile.x) * 73856093u)
+            ^ (static_cast<std::uint32_t>(tile.y) * 19349663u) ^ (static_cast<std::uint32_t>(tick) * 83492791u);
+        m.start(DIRS[hash >> 30]);
+    };
+
+    // FNV-1a over every actor's tile and progress
+    auto checksumOf = [](const std::vector<TileMover>& movers) {
+        std::uint64_t checksum = 14695981039346656037ull;
+        for (const TileMover& m : movers) {
+            for (std::uint64_t v : { static_cast<std::uint64_t>(m.tile().x), static_cast<std::uint64_t>(m.tile().y), static_cast<std::uint64_t>(m.progress()) }) {
+                checksum ^= v;
+                checksum *= 1099511628211ull;
+            }
+        }
+        return checksum;
+    };
+
+    // 1. every actor looked at and stepped every tick
+    std::vector<TileMover> movers = crowd;
+    auto start = BenchClock::now();
+    for (int tick = 0; tick < TICKS; ++tick) {
+        for (TileMover& m : movers) {
+            if (!m.moving())
+                decide(m, tick);
+            m.step();
+        }
+    }
+    double stepSeconds = secondsSince(start);
+    report("step", stepSeconds, count * static_cast<std::size_t>(TICKS));
+    std::uint64_t stepped = checksumOf(movers);
+
+    // 2. only the actors that arrive: each is brought up to date at its arrival,
+    // decides there (a tick later, as a stepped actor would) and is filed again;
+    // a parked actor never arrives, so it is not filed again at all
+    std::vector<TileMover> scheduled = crowd;
+    std::vector<std::uint32_t> since(count, 0);   // tick each actor's state was last brought up to
+    ArrivalWheel wheel(count);
+    std::size_t arrivals = 0;
+    start = BenchClock::now();
+    for (std::size_t i = 0; i < count; ++i)
+        wheel.schedule(static_cast<ArrivalWheel::Actor>(i), 0);
+    for (int tick = 0; tick < TICKS; ++tick) {
+        for (ArrivalWheel::Actor i : wheel.due()) {
+            TileMover& m = scheduled[i];
+            m.advance(static_cast<std::uint32_t>(tick) - since[i]);
+            decide(m, tick);
+            since[i] = static_cast<std::uint32_t>(tick);
+            std::uint32_t ticks = m.ticksToArrival();
+            if (ticks != TileMover::NEVER)
+                wheel.schedule(i, static_cast<std::uint64_t>(tick) + ticks);
+            ++arrivals;
+        }
+    }
+    double wheelSeconds = secondsSince(start);
+    report("arrival wheel", wheelSeconds, arrivals);
+
+    // what a frame would do: derive every position without stepping anyone
+    start = BenchClock::now();
+    float sum = 0.f;
+    for (std::size_t i = 0; i < count; ++i)
+        sum += scheduled[i].pixel({ 0.f, 0.f }, { 1.f, 1.f }, static_cast<std::uint32_t>(TICKS) - since[i]).x;
+    report("lazy positions", secondsSince(start), count);
+
+    // then catch everyone up, to compare with the stepped crowd
+    for (std::size_t i = 0; i < count; ++i)
+        scheduled[i].advance(static_cast<std::uint32_t>(TICKS) - since[i]);
+    std::uint64_t wheeled = checksumOf(scheduled);
+
+    // the stepped tick costs the crowd, the wheel's the arrivals in it
+    double actorTicks = static_cast<double>(count) * TICKS;
+    std::cout << "arrivals: " << arrivals << " (" << std::setprecision(1)
+              << (count > 0 ? 100.0 * static_cast<double>(arrivals) / actorTicks : 0.0) << "% of actor ticks)"
+              << ", per tick: step " << stepSeconds * 1e6 / TICKS << " us"
+              << ", wheel " << wheelSeconds * 1e6 / TICKS << " us"
+              << ", mean x " << std::setprecision(3) << (count > 0 ? sum / static_cast<float>(count) : 0.f) << '\n';
+    std::cout << "checksum: " << std::hex << stepped << std::dec;
+    if (wheeled != stepped)
+        std::cout << ", arrival wheel " << std::hex << wheeled << std::dec << " DIFFERS";
+    std::cout << '\n';
+    return wheeled == stepped;
+}
+
+} // namespace
+
+int runLeaderboardBenchmark(std::size_t count)
+{
+    // the rank queries cycle through the entries
+    if (count == 0) {
+        std::cerr << "leaderboard benchmark needs at least one entry" << std::endl;
+        return 1;
+    }
+    std::cout << "Leaderboard benchmark: " << count << " entries\n";
+
+    // Arcade-like spread: most games end early, a long tail scores big. Scores are
+    // multiples of 10 as in the game; initials and days are uniform.
+    std::mt19937_64 rng(20240601);
+    std::exponential_distribution<double> scoreDist(1.0 / 8000.0);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::uniform_int_distribution<std::uint32_t> dayDist(19000, 19364);
+
+    std::vector<ScoreEntry> entries(count);
+    for (ScoreEntry& e : entries) {
+        e.name = { static_cast<char>('A' + letter(rng)), static_cast<char>('A' + letter(rng)), static_cast<char>('A' + letter(rng)) };
+        e.score = static_cast<int>(scoreDist(rng) / 10.0) * 10;
+        e.day = dayDist(rng);
+    }
+
+    // 1. one-by-one inserts, as live submissions arrive
+    Leaderboards incremental;
+    auto start = BenchClock::now();
+    for (const ScoreEntry& e : entries)
+        incremental.insert(e);
+    report("insert (all boards)", secondsSince(start), count);
+
+    // 2. rank queries against the all-time board
+    const std::size_t queries = 1000000;
+    std::size_t checksum = 0;
+    start = BenchClock::now();
+    for (std::size_t i = 0; i < queries; ++i)
+        checksum += incremental.allTime().placement(entries[i % count].score).rank;
+    report("rank query (all-time)", secondsSince(start), queries);
+
+    start = BenchClock::now();
+    for (std::size_t i = 0; i < queries; ++i) {
+        const ScoreEntry& e = entries[i % count];
+        checksum += incremental.player(e.name)->placement(e.score).rank;
+        checksum += incremental.daily(e.day)->placement(e.score).rank;
+    }
+    report("rank query (daily+initials)", secondsSince(start), queries * 2);
+
+    // 3. snapshot round trip
+    const std::string path = "leaderboard_bench.bin";
+    start = BenchClock::now();
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const ScoreEntry& a, const ScoreEntry& b) { return a.score > b.score; });
+    report("sort for snapshot", secondsSince(start), 0);
+
+    start = BenchClock::now();
+    ScoreSnapshot::Writer writer;
+    bool written = writer.open(path, 0);
+    for (const ScoreEntry& e : entries)
+        written = writer.append(e) && written;
+    written = writer.commit() && written;
+    report("snapshot write", secondsSince(start), count);
+
+    Leaderboards loaded;
+    start = BenchClock::now();
+    ScoreSnapshot::Reader reader;
+    if (written && reader.open(path)) {
+        ScoreEntry e;
+        while (reader.next(e))
+            loaded.appendDescending(e);
+    }
+    loaded.finishBulkLoad();
+    report("snapshot load + bulk build", secondsSince(start), count);
+    std::remove(path.c_str());
+
+    // 4. both ways of building the boards must agree
+    bool same = loaded.allTime().size() == incremental.allTime().size();
+    for (std::size_t i = 0; same && i < 100000; ++i) {
+        const ScoreEntry& e = entries[(i * 7919) % count];
+        same = loaded.allTime().placement(e.score).rank == incremental.allTime().placement(e.score).rank
+            && loaded.player(e.name)->placement(e.score).rank == incremental.player(e.name)->placement(e.score).rank
+            && loaded.daily(e.day)->placement(e.score).rank == incremental.daily(e.day)->placement(e.score).rank;
+    }
+    for (std::size_t i = 0; same && i < loaded.allTime().top().size(); ++i)
+        same = loaded.allTime().top()[i].score == incremental.allTime().top()[i].score;
+
+    std::cout << "snapshot size: " << (ScoreSnapshot::HEADER_SIZE + count * ScoreSnapshot::RECORD_SIZE) / (1024 * 1024) << " MiB\n"
+              << "boards agree: " << (same ? "yes" : "NO") << " (checksum " << checksum << ")\n";
+    return same ? 0 : 1;
+}
+
+int runMoverBenchmark(std::size_t count)
+{
+    std::cout << "Tile mover benchmark: " << count << " actors\n";
+    // from all moving to mostly standing still: stepping costs the crowd, the wheel the arrivals
+    const std::size_t MOVING_EVERY[] = { 1, 4, 16, 64 };
+    bool agree = true;
+    for (std::size_t movingEvery : MOVING_EVERY) {
+        std::cout << "-- 1 in " << movingEvery << " moving\n";
+        agree = compareMoverSchedules(count, movingEvery) && agree;
+    }
+    return agree ? 0 : 1;
+}
+
+int runDecisionBenchmark(std::size_t count)
+{
+    using namespace GhostDecisions;
+    std::cout << "Ghost decision benchmark: " << count << " ghosts, best path " << isaName(bestIsa()) << "\n";
+
+    // tiles on the maze, targets up to a maze width outside it (Inky's can be)
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<std::int32_t> column(0, 27), row(0, 30), off(-28, 28);
+    std::uniform_int_distribution<int> mask(0, 15);
+    Batch batch;
+    batch.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        batch.tileX[i] = column(rng);
+        batch.tileY[i] = row(rng);
+        batch.targetX[i] = column(rng) + off(rng);
+        batch.targetY[i] = row(rng) + off(rng);
+        batch.exits[i] = static_cast<std::uint8_t>(mask(rng));
+    }
+
+    const int passes = 100;
+    std::vector<std::uint8_t> reference;
+    bool same = true;
+    for (Isa isa : { Isa::Scalar, Isa::Sse41, Isa::Avx2 }) {
+        if (static_cast<int>(isa) > static_cast<int>(bestIsa()))
+            break;
+        auto start = BenchClock::now();
+        for (int pass = 0; pass < passes; ++pass)
+            chooseAll(batch, isa);
+        report(isaName(isa), secondsSince(start), count * passes);
+
+        if (reference.empty())
+            reference = batch.choice;
+        else if (batch.choice != reference) {
+            std::cout << isaName(isa) << " disagrees with the scalar rule\n";
+            same = false;
+        }
+    }
+    std::cout << "all paths agree: " << (same ? "yes" : "NO") << '\n';
+    return same ? 0 : 1;
+}
+
+int runMazeBenchmark(int size)
+{
+    std::cout << "Maze generator benchmark: up to " << size << "x" << size << " tiles\n";
+
+    const std::uint32_t SEED = 20240601;
+    std::shared_ptr<const MazeLayout> maze;
+    // the arcade's size, then squares up to the one asked for
+    std::vector<std::pair<int, int>> sides = { { 28, 31 } };
+    for (int side = 100; side < size; side *= 10)
+        sides.emplace_back(side, side);
+    sides.emplace_back(size, size);
+    for (const auto& side : sides) {
+        auto start = BenchClock::now();
+        maze = MazeGenerator::generate(side.first, side.second, SEED);
+        std::string label = "generate " + std::to_string(maze->columns) + "x" + std::to_string(maze->rows);
+        std::size_t tiles = maze->tiles.size();
+        report(label.c_str(), secondsSince(start), tiles);
+
+        std::string problem;
+        if (!checkMaze(*maze, problem)) {
+            std::cout << "FAILED: " << label << ": " << problem << '\n';
+            return 1;
+        }
+        if (MazeGenerator::generate(side.first, side.second, SEED)->tiles != maze->tiles) {
+            std::cout << "FAILED: " << label << " differs between runs\n";
+            return 1;
+        }
+    }
+
+    std::size_t dots = 0, energizers = 0;
+    for (std::uint8_t tile : maze->tiles) {
+        dots += tile == MazeLayout::Dot;
+        energizers += tile == MazeLayout::Energizer;
+    }
+    std::cout << "largest: " << dots << " dots, " << energizers << " energizers\n";
+
+    // FNV-1a over the largest maze's tiles
+    std::uint64_t checksum = 14695981039346656037ull;
+    for (std::uint8_t tile : maze->tiles) {
+        checksum ^= tile;
+        checksum *= 1099511628211ull;
+    }
+    std::cout << "checksum: " << std::hex << checksum << std::dec << '\n';
+    return 0;
+}
+
+int runPelletBenchmark(int size)
+{
+    std::cout << "Pellet board benchmark: " << size << "x" << size << " maze\n";
+
+    std::shared_ptr<const MazeLayout> maze = MazeGenerator::generate(size, size, 20240601);
+    PelletBoard board(maze->columns, maze->rows);
+    for (int y = 0; y < maze->rows; ++y) {
+        for (int x = 0; x < maze->columns; ++x) {
+            std::uint8_t tile = maze->at(x, y);
+            if (tile == MazeLayout::Dot || tile == MazeLayout::Energizer)
+                board.add({ x, y }, tile == MazeLayout::Dot ? PelletBoard::Kind::Dot : PelletBoard::Kind::Energizer);
+        }
+    }
+
+    // eat nine in ten, so nearest() has some way to look
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<int> column(0, maze->columns - 1), row(0, maze->rows - 1), radius(0, 12);
+    auto start = BenchClock::now();
+    std::size_t tiles = static_cast<std::size_t>(maze->columns) * static_cast<std::size_t>(maze->rows);
+    for (int y = 0; y < maze->rows; ++y) {
+        for (int x = 0; x < maze->columns; ++x) {
+            if ((x * 7 + y * 13) % 10 != 0)
+                board.eat({ x, y });
+        }
+    }
+    report("eat", secondsSince(start), tiles);
+
+    const int QUERIES = 1000000;
+    start = BenchClock::now();
+    int left = 0;
+    for (int i = 0; i < 1000; ++i)
+        left += board.remaining();
+    report("remaining", secondsSince(start), 1000);
+
+    std::vector<std::pair<sf::Vector2i, int>> queries(QUERIES);
+    for (auto& q : queries)
+        q = { sf::Vector2i(column(rng), row(rng)), radius(rng) };
+
+    start = BenchClock::now();
+    std::uint64_t within = 0;
+    for (const auto& q : queries)
+        within += static_cast<std::uint64_t>(board.countWithin(q.first, q.second));
+    report("within N", secondsSince(start), QUERIES);
+
+    start = BenchClock::now();
+    std::uint64_t distances = 0;
+    sf::Vector2i found;
+    for (const auto& q : queries) {
+        if (board.nearest(q.first, found))
+            distances += static_cast<std::uint64_t>(std::abs(found.x - q.first.x) + std::abs(found.y - q.first.y));
+    }
+    report("nearest", secondsSince(start), QUERIES);
+
+    // the same answers by looking at every tile, on a sample of the queries
+    bool same = left == 1000 * board.remaining();
+    std::vector<sf::Vector2i> pellets;
+    for (int y = 0; y < maze->rows; ++y) {
+        for (int x = 0; x < maze->columns; ++x) {
+            if (board.at({ x, y }) != PelletBoard::Kind::None)
+                pellets.emplace_back(x, y);
+        }
+    }
+    same = same && static_cast<int>(pellets.size()) == board.remaining();
+    for (std::size_t i = 0; same && i < queries.size(); i += 997) {
+        const sf::Vector2i& from = queries[i].first;
+        int count = 0;
+        int best = -1;
+        for (const sf::Vector2i& p : pellets) {
+            int distance = std::abs(p.x - from.x) + std::abs(p.y - from.y);
+            count += distance <= queries[i].second;
+            if (best < 0 || distance < best)
+                best = distance;
+        }
+        bool any = board.nearest(from, found);
+        same = count == board.countWithin(from, queries[i].second) && any == (best >= 0)
+            && (!any || std::abs(found.x - from.x) + std::abs(found.y - from.y) == best);
+    }
+
+    board.reset();
+    same = same && board.eaten() == 0;
+    std::cout << "pellets left: " << pellets.size() << ", " << within << " counted, mean nearest "
+              << std::setprecision(2) << static_cast<double>(distances) / QUERIES << " tiles\n"
+              << "grid scan agrees: " << (same ? "yes" : "NO") << '\n';
+    return same ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <cstddef>
+
+/**
+ * @brief time the leaderboard engine on a synthetic table
+ * @details Inserts count entries one by one, runs rank queries, writes the table as
+ * a snapshot, bulk-loads it back and checks both boards agree. Results go to stdout.
+ *
+ * @param count number of entries to generate, at least 1
+ * @return int process exit code, non-zero if count is 0 or the two boards disagree
+ */
+int runLeaderboardBenchmark(std::size_t count);
+
+/**
+ * @brief time the fixed-point tile mover on a crowd of synthetic actors
+ * @details Moves count actors for ten simulated seconds on an open wrap-around grid,
+ * turning at every tile by a hash of position and tick, once stepping every actor
+ * every tick and once through an ArrivalWheel that only wakes actors as they reach
+ * a tile. Both run on crowds from all moving down to one actor in 64 moving, to show
+ * the wheel's tick cost following the arrivals rather than the size of the crowd. The final checksum depends only on integer state, so the two runs must
+ * agree and it must match across builds, compilers and machines.
+ *
+ * @param count number of actors
+ * @return int process exit code, non-zero if the two runs disagree
+ */
+int runMoverBenchmark(std::size_t count);
+
+/**
+ * @brief time the batched ghost exit decisions against the scalar rule
+ * @details Fills a batch with random tiles, targets and exit masks, decides it
+ * repeatedly on every instruction set the CPU supports and checks each one picks
+ * exactly what the scalar rule picks.
+ *
+ * @param count number of ghosts in the batch
+ * @return int process exit code, non-zero if any path disagrees
+ */
+int runDecisionBenchmark(std::size_t count);
+
+/**
+ * @brief time the maze generator and check what it builds
+ * @details Generates mazes from the arcade's size up to size x size, checks each
+ * is mirrored, free of dead ends, connected, and the same again from the same
+ * seed, and prints a checksum of the largest to compare between builds.
+ *
+ * @param size side of the largest maze, in tiles
+ * @return int process exit code, non-zero if a maze fails a check
+ */
+int runMazeBenchmark(int size);
+
+/**
+ * @brief time the pellet bitboards on a generated maze
+ * @details Lays out a size x size maze's pellets, eats most of them, then times
+ * the remaining count and many "pellets within N tiles" and "nearest pellet"
+ * queries, and checks a sample of them against a scan of every tile.
+ *
+ * @param size side of the maze, in tiles
+ * @return int process exit code, non-zero if the board and the scan disagree
+ */
+int runPelletBenchmark(int size);
+
+#endif // BENCHMARKS_H
@@ -1,68 +1,23 @@
 #include "Blinky.h"
+#include "FrameBuffer.h"
 
 #include <iostream>
 #include <string>
 
 Blinky::Blinky(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int level) :
-    Ghost(startPos, moveSpeed, mapPos, level) // Call Ghost constructor to set m_pos, m_moveSpeed, etc.
+    Ghost(startPos, moveSpeed, mapPos, level) // Call Ghost constructor to set the mover, speed, etc.
 {
     // Initialize sprite animation
     initAnimation();
-
-    // Position the sprite at the start tile
-    m_animation.setPosition(
-        static_cast<float>(startPos.x) * static_cast<float>(m_tileSize.x) + m_animation.getLocalBounds().width + mapPos.x,
-        static_cast<float>(startPos.y) * static_cast<float>(m_tileSize.y) + m_animation.getLocalBounds().height + mapPos.y
-    );
-
-    m_scatterTarget = { 24, 0 };
-}
-
-sf::Vector2i Blinky::calculateTarget(sf::Vector2i playerPos)
-{
-    m_targetTile = playerPos;
-
-    if (m_mode == Ghost::Mode::Scatter) {
-        m_targetTile = { 26, 0 };
-    }
-
-    return m_targetTile;
 }
 
-void Blinky::render(sf::RenderWindow& window)
+void Blinky::render(FrameSnapshot& frame)
 {
-    window.draw(m_animation);
+    m_animation.setPosition(pixelPosition());
+    m_animation.render(frame);
 
     if (m_debug) {
-        sf::Vector2f tileCenter(
-            static_cast<float>(m_targetTile.x) * static_cast<float>(m_tileSize.x) + static_cast<float>(m_tileSize.x) / 2.f + m_mapPos.x,
-            static_cast<float>(m_targetTile.y) * static_cast<float>(m_tileSize.y) + static_cast<float>(m_tileSize.y) / 2.f + m_mapPos.y
-        );
-
-        const float span = 0.6f * static_cast<float>(std::min(m_tileSize.x, m_tileSize.y)); // 60% of tile size.
-        const float thickness = 4.f;                                                             // 4 pixels thick.
-
-        // Create first line: rectangle spanning 'span' with the specified thickness.
-        sf::RectangleShape line1(sf::Vector2f(span, thickness));
-        // Center the rectangle's origin.
-        line1.setOrigin(span / 2.f, thickness / 2.f);
-        line1.setPosition(tileCenter);
-        // Rotate 45 degrees.
-        line1.setRotation(45.f);
-        // Set color (semi‑transparent red).
-        line1.setFillColor(sf::Color(255, 0, 0, 200));
-
-        // Create second line: same dimensions.
-        sf::RectangleShape line2(sf::Vector2f(span, thickness));
-        line2.setOrigin(span / 2.f, thickness / 2.f);
-        line2.setPosition(tileCenter);
-        // Rotate –45 degrees.
-        line2.setRotation(-45.f);
-        line2.setFillColor(sf::Color(255, 0, 0, 200));
-
-        // Draw both lines.
-        window.draw(line1);
-        window.draw(line2);
+        renderTargetCross(frame, sf::Color(255, 0, 0, 200));       // semi-transparent red
     }
 }
 
@@ -98,8 +53,9 @@ void Blinky::initAnimation()
     m_animation.addFrame(m_framesRight[0]);
     m_animation.addFrame(m_framesRight[1]);
 
-    // Set a scale to get desired size.
-    m_animation.setScale(2.5f, 2.5f);
+    // One texel per arcade pixel, so nearest sampling never drops or doubles a column.
+    const float scale = static_cast<float>(FrameBuffer::LAYOUT_SCALE);
+    m_animation.setScale(scale, scale);
 
     // Setup the animation (which applies the frames)
     m_animation.setup();
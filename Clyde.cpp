@@ -1,84 +1,29 @@
 #include "Clyde.h"
+#include "FrameBuffer.h"
 
 #include <SFML/System/Vector2.hpp>
 #include <iostream>
 
 Clyde::Clyde(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int level) :
-    Ghost(startPos, moveSpeed, mapPos, level) // Call Ghost constructor to set m_pos, m_moveSpeed, etc.
+    Ghost(startPos, moveSpeed, mapPos, level) // Call Ghost constructor to set the mover, speed, etc.
 {
     // Initialize sprite animation
     initAnimation();
-
-    // Position the sprite at the start tile
-    m_animation.setPosition(
-        (float)(startPos.x * m_tileSize.x) + m_animation.getLocalBounds().width + mapPos.x,
-        (float)(startPos.y * m_tileSize.y) + m_animation.getLocalBounds().height + mapPos.y
-    );
-
 }
 
-sf::Vector2i Clyde::calculateTarget(sf::Vector2i playerPos)
-{
-    // Define the threshold distance (in tiles) at which Clyde switches behavior.
-    const float threshold = 8.0f;
-
-    // Compute the Euclidean distance from Clyde's current position (m_pos) to Pac-Man's position.
-    float dx = static_cast<float>(playerPos.x - m_pos.x);
-    float dy = static_cast<float>(playerPos.y - m_pos.y);
-    float distance = std::sqrt(dx * dx + dy * dy);
-
-    // If Clyde is farther than the threshold from Pac-Man, his target is Pac-Man's position.
-    if (distance > threshold) {
-        m_targetTile = playerPos;
-    }
-    else {
-        int mapHeight = static_cast<int>(m_mapVector.size());
-        sf::Vector2i scatterCorner(1, mapHeight - 1);
-        m_targetTile = scatterCorner;
-    }
-
-    if (m_mode == Ghost::Mode::Scatter) {
-        m_targetTile = { 1, 30 };
-    }
-
-    return m_targetTile;
-}
-
-
-void Clyde::render(sf::RenderWindow& window, sf::Vector2i pacPos)
+void Clyde::render(FrameSnapshot& frame)
 {
     // Draw Clyde's animation.
-    window.draw(m_animation);
+    m_animation.setPosition(pixelPosition());
+    m_animation.render(frame);
 
     if (m_debug)
     {
         float tileSize = (float)m_tileSize.x;
         // Only draw the debug "X" if the target tile is different from the player's tile.
-        if (m_targetTile != pacPos)
+        if (m_targetTile != m_playerTile)
         {
-            // --- Draw an "X" at the target tile for debugging ---
-            sf::Vector2f targetTileCenter(
-                (float)m_targetTile.x * tileSize + tileSize / 2.f + m_mapPos.x,
-                (float)m_targetTile.y * tileSize + tileSize / 2.f + m_mapPos.y
-            );
-
-            float span = 0.6f * (float)std::min(m_tileSize.x, m_tileSize.y); // 60% of tile size.
-            float thickness = 4.f; // 4 pixels thick.
-
-            sf::RectangleShape line1(sf::Vector2f(span, thickness));
-            line1.setOrigin(span / 2.f, thickness / 2.f);
-            line1.setPosition(targetTileCenter);
-            line1.setRotation(45.f);
-            line1.setFillColor(sf::Color(255, 165, 0, 200)); // semi-transparent orange
-
-            sf::RectangleShape line2(sf::RectangleShape(sf::Vector2f(span, thickness)));
-            line2.setOrigin(span / 2.f, thickness / 2.f);
-            line2.setPosition(targetTileCenter);
-            line2.setRotation(-45.f);
-            line2.setFillColor(sf::Color(255, 165, 0, 200));
-
-            window.draw(line1);
-            window.draw(line2);
+            renderTargetCross(frame, sf::Color(255, 165, 0, 200)); // semi-transparent orange
         }
 
         // --- Draw a ring around Pac-Man, but only if the target is not the scatter corner ---
@@ -91,24 +36,15 @@ void Clyde::render(sf::RenderWindow& window, sf::Vector2i pacPos)
             {
                 // Calculate Pac-Man's center in world coordinates:
                 sf::Vector2f pacCenter(
-                    (float)pacPos.x * tileSize + tileSize / 2.f + m_mapPos.x,
-                    (float)pacPos.y * tileSize + tileSize / 2.f + m_mapPos.y
+                    (float)m_playerTile.x * tileSize + tileSize / 2.f + m_mapPos.x,
+                    (float)m_playerTile.y * tileSize + tileSize / 2.f + m_mapPos.y
                 );
 
-                // Use Clyde's threshold, e.g. 8 tiles (adjust as needed).
-                const float threshold = 8.0f;
+                // Clyde's shyness radius from his targeting policy.
+                const float threshold = static_cast<float>(Personality::SHY_RADIUS);
                 float radius = threshold * tileSize; // Assuming square tiles.
 
-                sf::CircleShape ring(radius);
-                ring.setFillColor(sf::Color::Transparent);
-                ring.setOutlineThickness(3.f);
-                ring.setOutlineColor(sf::Color(255, 165, 0, 200));
-
-                // Center the ring on pacCenter.
-                ring.setOrigin(radius, radius);
-                ring.setPosition(pacCenter);
-
-                window.draw(ring);
+                frame.addRing(pacCenter, radius, 3.f, sf::Color(255, 165, 0, 200));
             }
         }
     }
@@ -146,8 +82,9 @@ void Clyde::initAnimation()
     m_animation.addFrame(m_framesRight[0]);
     m_animation.addFrame(m_framesRight[1]);
 
-    // Set a scale to get desired size.
-    m_animation.setScale(2.5f, 2.5f);
+    // One texel per arcade pixel, so nearest sampling never drops or doubles a column.
+    const float scale = static_cast<float>(FrameBuffer::LAYOUT_SCALE);
+    m_animation.setScale(scale, scale);
 
     // Setup the animation (which applies the frames)
     m_animation.setup();
@@ -14,32 +14,22 @@ public:
      * @param moveSpeed Speed of Clyde
      * @param mapPos Position of the map
      * @param level Current level of the game
-     * @details Initializes Clyde's position, speed, and animation. Calls the Ghost constructor to set m_pos, m_moveSpeed, etc.
+     * @details Initializes Clyde's position, speed, and animation. Calls the Ghost constructor to set the mover, speed, etc.
      */
     Clyde(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int level);
     ~Clyde() = default;
 
     /**
-     * @brief Calculates the target tile for Clyde based on the player's position.
-     * @param playerPos Position of the player
-     * @return Target tile for Clyde
-     * @details If in Scatter mode, sets target to (26, 0). Otherwise, sets target to player's position.
+     * @brief Chases Pac-Man until within eight tiles, then retreats; scatters to the bottom-left corner.
      */
-    sf::Vector2i calculateTarget(sf::Vector2i playerPos);
-
-    /**
-     * @brief Sets the target tile for Clyde.
-     * @param targetTile Target tile for Clyde
-     * @details Sets the target tile for Clyde.
-     */
-    void render(sf::RenderWindow& window, sf::Vector2i pacPos);
+    using Personality = Targeting::Pokey;
 
     /**
      * @brief Renders Clyde on the window.
-     * @param window Reference to the SFML window
-     * @details Draws Clyde's sprite on the window. If debug mode is enabled, draws additional debug information.
+     * @param frame Snapshot to record into
+     * @details Draws Clyde's sprite on the window. If debug mode is enabled, draws his target and shyness ring.
      */
-    void toggleDebug() { m_debug = !m_debug; }
+    void render(FrameSnapshot& frame);
 
 private:
     /**
@@ -47,8 +37,6 @@ private:
      * @details Loads the texture and sets up the animation frames for Clyde.
      */
     void initAnimation();
-    sf::Vector2i m_targetTile;
-    bool m_debug = false;
 };
 
 #endif // CLYDE_H
@@ -0,0 +1,52 @@
+#include "CountedTarget.h"
+
+void CountedTarget::draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+    this->count(count, type, states.texture);
+    m_target.draw(vertices, count, type, states);
+}
+
+void CountedTarget::draw(const sf::VertexBuffer& buffer, std::size_t first, std::size_t count, const sf::RenderStates& states)
+{
+    this->count(count, buffer.getPrimitiveType(), states.texture);
+    m_target.draw(buffer, first, count, states);
+}
+
+void CountedTarget::draw(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+    count(4, sf::TriangleStrip, sprite.getTexture());
+    m_target.draw(sprite, states);
+}
+
+void CountedTarget::count(std::size_t vertices, sf::PrimitiveType type, const sf::Texture* texture)
+{
+    std::size_t primitives = 0;
+    switch (type) {
+    case sf::Points:
+        primitives = vertices;
+        break;
+    case sf::Lines:
+        primitives = vertices / 2;
+        break;
+    case sf::LineStrip:
+        primitives = vertices > 0 ? vertices - 1 : 0;
+        break;
+    case sf::Triangles:
+        primitives = vertices / 3;
+        break;
+    case sf::TriangleStrip:
+    case sf::TriangleFan:
+        primitives = vertices > 2 ? vertices - 2 : 0;
+        break;
+    default:
+        primitives = vertices / 4 * 2;   // quads, drawn as two triangles each
+        break;
+    }
+
+    ++m_counts.drawCalls;
+    m_counts.primitives += static_cast<std::uint32_t>(primitives);
+    if (texture != m_texture) {
+        ++m_counts.textureSwitches;
+        m_texture = texture;
+    }
+}
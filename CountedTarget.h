@@ -0,0 +1,74 @@
+#ifndef COUNTEDTARGET_H
+#define COUNTEDTARGET_H
+
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief what one frame submitted to the GPU
+ */
+struct DrawCounts
+{
+    std::uint32_t drawCalls = 0;
+    std::uint32_t primitives = 0;        // triangles, lines or points
+    std::uint32_t textureSwitches = 0;   // draws whose texture differs from the draw before
+};
+
+/**
+ * @brief a render target that counts what is drawn through it
+ * @details Wraps the target the render thread draws a frame into and forwards
+ * each draw, adding it to the frame's DrawCounts. Only the kinds of draw the
+ * frame is made of are offered, so a new kind cannot slip past the count.
+ * Render thread only; make one per frame.
+ */
+class CountedTarget
+{
+public:
+    /**
+     * @brief wrap a target
+     *
+     * @param target target to draw into
+     */
+    explicit CountedTarget(sf::RenderTarget& target) : m_target(target) {}
+
+    /**
+     * @brief draw primitives from an array of vertices
+     */
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /**
+     * @brief draw part of a vertex buffer
+     */
+    void draw(const sf::VertexBuffer& buffer, std::size_t first, std::size_t count, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /**
+     * @brief draw a sprite, two triangles
+     */
+    void draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /**
+     * @brief change the view of the wrapped target
+     */
+    void setView(const sf::View& view) { m_target.setView(view); }
+
+    /**
+     * @brief everything drawn so far
+     */
+    const DrawCounts& counts() const { return m_counts; }
+
+private:
+    void count(std::size_t vertices, sf::PrimitiveType type, const sf::Texture* texture);
+
+    sf::RenderTarget& m_target;
+    DrawCounts m_counts;
+    const sf::Texture* m_texture = nullptr;   // bound by the last draw
+};
+
+#endif // COUNTEDTARGET_H
@@ -1,20 +1,32 @@
 #include "EndGameState.h"
 #include <algorithm>
-#include <array>
-#include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <cstddef>
 #include "MainMenuState.h"
+#include "FrameBuffer.h"
+#include "ResourceCache.h"
+#include "ScoreStore.h"
 
-// Reduce character size until the text fits the allowed width.
-// Keeps numbers readable when scores get very large.
-void fitTextWidth(sf::Text& txt, float maxWidth) {
-    unsigned size = txt.getCharacterSize();
-    while (txt.getLocalBounds().width > maxWidth && size > 10) {
-        size -= 2;
-        txt.setCharacterSize(size);
-    }
+namespace {
+
+const char* const TITLE_FONT = "assets/fonts/pacfont.ttf";
+const char* const MONO_FONT = "assets/fonts/JetBrainsMono.ttf";
+
+const unsigned int TITLE_SIZE = 72;
+const unsigned int SCORE_SIZE = 48;
+const unsigned int PROMPT_SIZE = 32;
+const unsigned int NAME_SIZE = 56;
+const unsigned int RANK_SIZE = 28;
+const unsigned int ROW_SIZE = 40;
+
+} // namespace
+
+void EndGameState::preload()
+{
+    ResourceCache::glyphs(TITLE_FONT, TITLE_SIZE);
+    for (unsigned int size : { SCORE_SIZE, PROMPT_SIZE, NAME_SIZE, RANK_SIZE, ROW_SIZE })
+        ResourceCache::glyphs(MONO_FONT, size);
 }
 
 EndGameState::EndGameState(StateManager& manager,
@@ -24,158 +36,139 @@ EndGameState::EndGameState(StateManager& manager,
     m_window(window),
     m_finalScore(finalScore) {
 
-    // load fonts once
-    m_titleFont.loadFromFile("assets/fonts/pacfont.ttf");
-    m_monoFont.loadFromFile("assets/fonts/JetBrainsMono.ttf");
-
-    float cx = static_cast<float>(m_window.getSize().x) / 2.f;
-    float maxWidth = static_cast<float>(m_window.getSize().x) - 40.f;         // 20‑pixel margin each side
+    float cx = static_cast<float>(FrameBuffer::layoutSize().x) / 2.f;
+    float maxWidth = static_cast<float>(FrameBuffer::layoutSize().x) - 40.f;         // 20‑pixel margin each side
 
     // banner
-    m_titleText.setFont(m_titleFont);
+    m_titleText.setGlyphs(ResourceCache::glyphs(TITLE_FONT, TITLE_SIZE));
     m_titleText.setString("GAME OVER");
-    m_titleText.setCharacterSize(72);
-    fitTextWidth(m_titleText, maxWidth);
-    centerOrigin(m_titleText);
-    m_titleText.setPosition(cx, 80.f);
+    m_titleText.fitWidth(maxWidth);
+    m_titleText.centerOn(sf::Vector2f(cx, 80.f));
 
     // final score
-    m_scoreText.setFont(m_monoFont);
+    m_scoreText.setGlyphs(ResourceCache::glyphs(MONO_FONT, SCORE_SIZE));
     m_scoreText.setString("Score: " + std::to_string(m_finalScore));
-    m_scoreText.setCharacterSize(48);
-    fitTextWidth(m_scoreText, maxWidth);
-    centerOrigin(m_scoreText);
-    m_scoreText.setPosition(cx, 180.f);
+    m_scoreText.fitWidth(maxWidth);
+    m_scoreText.centerOn(sf::Vector2f(cx, 180.f));
 
     // prompt
-    m_promptText.setFont(m_monoFont);
+    m_promptText.setGlyphs(ResourceCache::glyphs(MONO_FONT, PROMPT_SIZE));
     m_promptText.setString("Enter initials and press Enter:");
-    m_promptText.setCharacterSize(32);
-    fitTextWidth(m_promptText, maxWidth);
-    centerOrigin(m_promptText);
-    m_promptText.setPosition(cx, 260.f);
+    m_promptText.fitWidth(maxWidth);
+    m_promptText.centerOn(sf::Vector2f(cx, 260.f));
 
     // 3‑char name entry
-    m_nameText.setFont(m_monoFont);
-    m_nameText.setCharacterSize(56);
+    m_nameText.setGlyphs(ResourceCache::glyphs(MONO_FONT, NAME_SIZE));
     m_nameText.setString("___");
-    centerOrigin(m_nameText);
-    m_nameText.setPosition(cx, 330.f);
+    m_nameText.centerOn(sf::Vector2f(cx, 330.f));
+
+    // placement line, filled in once the score is submitted
+    m_rankText.setGlyphs(ResourceCache::glyphs(MONO_FONT, RANK_SIZE));
+    m_rankText.setColor(sf::Color::Yellow);
+    m_rankText.fitWidth(maxWidth);
+    m_rankText.centerOn(sf::Vector2f(cx, 700.f));
 
     // high‑score table rows
-    m_tableRows.resize(5);
-    for (auto& t : m_tableRows) {
-        t.setFont(m_monoFont);
-        t.setCharacterSize(40);
+    for (std::size_t i = 0; i < 5; ++i) {
+        m_tableRows[i].setGlyphs(ResourceCache::glyphs(MONO_FONT, ROW_SIZE));
+        m_tableRows[i].fitWidth(maxWidth);
+        m_tableRows[i].centerOn(sf::Vector2f(cx, 420.f + static_cast<float>(i) * 50.f));
     }
 
-    loadScores();     // pull scores.txt into vector
+    loadScores();     // pull the top of the score store into vector
     buildTable();     // render top 5 rows
 }
 
-void EndGameState::handleEvents(sf::RenderWindow&) {}
-
-// key‑latch polling → avoids draining the main event queue
-void EndGameState::update(sf::Time) {
-    static std::array<bool, sf::Keyboard::KeyCount> latch{};
-
-    auto pressedOnce = [&](sf::Keyboard::Key k) {
-        bool now = sf::Keyboard::isKeyPressed(k);
-        bool once = now && !latch[static_cast<std::size_t>(k)];
-        latch[static_cast<std::size_t>(k)] = now;
-        return once;
-        };
-
-    if (!m_scoreSubmitted) {
-        if (pressedOnce(sf::Keyboard::BackSpace) && !m_playerName.empty())
-            m_playerName.pop_back();
+// typed characters come from TextEntered, so keyboard layout and shift are honoured
+void EndGameState::handleEvents(sf::RenderWindow&, const Input& input) {
+    for (const InputEvent& e : input.events()) {
+        if (m_scoreSubmitted) {
+            // after submission: Space returns to main menu
+            if (e.type == InputEvent::Type::KeyPressed && e.key == sf::Keyboard::Space) {
+                m_manager.changeState(std::make_unique<MainMenuState>(m_manager, m_window));
+                return;
+            }
+            continue;
+        }
 
-        if (pressedOnce(sf::Keyboard::Enter) && m_playerName.size() == 3) {
-            addCurrentScore();   // commit to file
+        std::size_t typed = m_playerName.size();
+        if (e.type == InputEvent::Type::Text) {
+            sf::Uint32 c = e.unicode;
+            if (c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+
+            // build initials (A‑Z 0‑9)
+            if (c == '\b' && !m_playerName.empty())
+                m_playerName.pop_back();
+            else if (m_playerName.size() < 3 && ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')))
+                m_playerName += static_cast<char>(c);
+        }
+        else if (e.type == InputEvent::Type::KeyPressed && e.key == sf::Keyboard::Enter && m_playerName.size() == 3) {
+            addCurrentScore();   // hand off to the score store
             buildTable();        // refresh table with new entry
+            showPlacement();     // "#N of T (top X%)"
             m_scoreSubmitted = true;
             m_promptText.setString("Press Space to return");
-            centerOrigin(m_promptText);
-        }
-
-        // build initials (A‑Z 0‑9)
-        if (m_playerName.size() < 3) {
-            for (int k = sf::Keyboard::A; k <= sf::Keyboard::Z; ++k)
-                if (pressedOnce(static_cast<sf::Keyboard::Key>(k)))
-                    m_playerName += static_cast<char>('A' + k - sf::Keyboard::A);
-
-            for (int k = sf::Keyboard::Num0; k <= sf::Keyboard::Num9; ++k)
-                if (pressedOnce(static_cast<sf::Keyboard::Key>(k)))
-                    m_playerName += static_cast<char>('0' + k - sf::Keyboard::Num0);
         }
 
-        // live underscore placeholders
-        std::string display = m_playerName;
-        while (display.size() < 3) display += '_';
-        m_nameText.setString(display);
-        centerOrigin(m_nameText);
-    }
-    else { // after submission: Space returns to main menu
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
-            m_manager.changeState(std::make_unique<MainMenuState>(m_manager, m_window));
-            return;
-        }
+        if (m_playerName.size() != typed)
+            updateNameText();
     }
 }
 
-void EndGameState::render(sf::RenderWindow& window) {
-    window.draw(m_titleText);
-    window.draw(m_scoreText);
-    window.draw(m_promptText);
-    window.draw(m_nameText);
-    for (auto& t : m_tableRows) window.draw(t);
+void EndGameState::update(sf::Time) {}
+
+void EndGameState::render(FrameSnapshot& frame) {
+    m_titleText.render(frame);
+    m_scoreText.render(frame);
+    m_promptText.render(frame);
+    m_nameText.render(frame);
+    for (const TextLabel& row : m_tableRows)
+        row.render(frame);
+    m_rankText.render(frame);
 }
 
-// set origin to centre for easy positioning
-void EndGameState::centerOrigin(sf::Text& text) {
-    auto b = text.getLocalBounds();
-    text.setOrigin(b.left + b.width / 2.f, b.top + b.height / 2.f);
+// live underscore placeholders
+void EndGameState::updateNameText() {
+    std::string display = m_playerName;
+    while (display.size() < 3) display += '_';
+    m_nameText.setString(display);
 }
 
-// render 5 best scores (after sorting)
+// show the 5 best scores (after sorting), oversized rows scaled to fit
 void EndGameState::buildTable() {
-    float cx = static_cast<float>(m_window.getSize().x) / 2.f;
-    float maxWidth = static_cast<float>(m_window.getSize().x) - 40.f;
     for (std::size_t i = 0; i < 5; ++i) {
-        std::ostringstream ss;
-        if (i < m_scores.size())
-            ss << std::left << std::setw(3) << m_scores[i].first << "  " << m_scores[i].second;
-
-        m_tableRows[i].setString(ss.str());
-        fitTextWidth(m_tableRows[i], maxWidth);
-        centerOrigin(m_tableRows[i]);
-        m_tableRows[i].setPosition(cx, 420.f + static_cast<float>(i) * 50.f);
+        if (i >= m_scores.size()) {
+            m_tableRows[i].setString("");
+            continue;
+        }
+        // "ABC  12345", name padded to three columns
+        std::string row = m_scores[i].first.substr(0, 3);
+        row.resize(5, ' ');
+        row += std::to_string(m_scores[i].second);
+        m_tableRows[i].setString(row);
     }
 }
 
-// read whole file into m_scores
+// copy the best entries out of the score store
 void EndGameState::loadScores() {
-    std::ifstream in("scores.txt");
-    std::string line;
-    while (std::getline(in, line)) {
-        if (line.size() < 4) continue;
-        std::string name = line.substr(0, 3);
-        int value = std::stoi(line.substr(3));
-        m_scores.emplace_back(name, value);
-    }
+    m_scores.clear();
+    for (const ScoreEntry& e : ScoreStore::instance().top(5))
+        m_scores.emplace_back(e.name, e.score);
 }
 
-// overwrite scores.txt with current vector
-void EndGameState::saveScores() {
-    std::ofstream out("scores.txt", std::ios::trunc);
-    for (auto& e : m_scores) out << e.first << e.second << '\n';
+// rank among every game on record, e.g. "#12 of 4031 (top 0.3%)"
+void EndGameState::showPlacement() {
+    Placement p = ScoreStore::instance().placement(m_finalScore);
+    std::ostringstream ss;
+    ss << '#' << p.rank << " of " << p.total
+       << " (top " << std::fixed << std::setprecision(p.topPercent < 1.0 ? 2 : 1) << p.topPercent << "%)";
+
+    m_rankText.setString(ss.str());
 }
 
-// push current score, sort, cap at 10, persist
+// submit current score; the store persists it on its own I/O thread
 void EndGameState::addCurrentScore() {
-    m_scores.emplace_back(m_playerName, m_finalScore);
-    std::sort(m_scores.begin(), m_scores.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
-    if (m_scores.size() > 10) m_scores.resize(10);
-    saveScores();
+    ScoreStore::instance().submit(m_playerName, m_finalScore);
+    loadScores();
 }
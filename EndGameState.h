@@ -3,6 +3,8 @@
 
 #include "GameState.h"
 #include "StateManager.h"
+#include "GlyphAtlas.h"
+#include "TextLabel.h"
 #include <SFML/Graphics.hpp>
 #include <utility>
 #include <vector>
@@ -18,6 +20,13 @@ public:
      */
     EndGameState(StateManager& manager, const sf::RenderWindow& window, int finalScore);
 
+    /**
+     * @brief Load every texture and glyph atlas this state uses
+     * @details Called while the window's GL context is current, before the sim
+     * thread starts, so constructing the state later only looks them up.
+     */
+    static void preload();
+
     /**
      * @brief EndGameState destructor
      * @details Default destructor.
@@ -25,10 +34,11 @@ public:
     ~EndGameState() = default;
 
     /**
-     * @brief EndGameState destructor
-     * @details Default destructor.
+     * @brief Handles initials entry and the return to the menu
+     * @param window Reference to the SFML window
+     * @param input Keyboard events for this tick
      */
-    void handleEvents(sf::RenderWindow& window) override;
+    void handleEvents(sf::RenderWindow& window, const Input& input) override;
 
     /**
      * @brief Updates the state
@@ -37,18 +47,23 @@ public:
     void update(sf::Time dt) override;
 
     /**
-     * @brief Renders the state
-     * @param window Reference to the SFML window
+     * @brief Idle once the score is in and only Space is awaited
+     * @return true after submission
      */
-    void render(sf::RenderWindow& window) override;
+    bool isIdle() const override { return m_scoreSubmitted; }
+
+    /**
+     * @brief Name reported by the metrics endpoint
+     */
+    const char* name() const override { return "end_game"; }
 
-private:
     /**
-     * @brief Sets the origin of the text to its center
-     * @param text Reference to the SFML text
+     * @brief Records the state into a frame snapshot
+     * @param frame Snapshot to record into
      */
-    void centerOrigin(sf::Text& text);
+    void render(FrameSnapshot& frame) override;
 
+private:
     /**
      * @brief sets up the high score table
      * 
@@ -56,34 +71,37 @@ private:
     void buildTable();
 
     /**
-     * @brief loads previous scores from file
+     * @brief loads the best scores from the score store
      * 
      */
     void loadScores();
 
     /**
-     * @brief saves current scores to file
-     * 
+     * @brief Adds the current score to the high score table
+     */
+    void addCurrentScore();
+
+    /**
+     * @brief Shows where the submitted score ranks among every game played
      */
-    void saveScores();
+    void showPlacement();
 
     /**
-     * @brief Adds the current score to the high score table
+     * @brief Refreshes the initials display after a key press
      */
-    void addCurrentScore();
+    void updateNameText();
 
     StateManager& m_manager;
     const sf::RenderWindow& m_window;
     int m_finalScore;
     bool m_scoreSubmitted = false;
 
-    sf::Font m_titleFont;
-    sf::Font m_monoFont;
-    sf::Text m_titleText;
-    sf::Text m_scoreText;
-    sf::Text m_promptText;
-    sf::Text m_nameText;
-    std::vector<sf::Text> m_tableRows;
+    TextLabel m_titleText;
+    TextLabel m_scoreText;
+    TextLabel m_promptText;
+    TextLabel m_nameText;
+    TextLabel m_rankText;
+    TextLabel m_tableRows[5];   // high-score rows
 
     std::vector<std::pair<std::string, int>> m_scores;  // name, value
     std::string m_playerName;
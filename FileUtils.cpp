@@ -0,0 +1,147 @@
+#include "FileUtils.h"
+
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+FileLock::FileLock(const std::string& path)
+{
+#ifdef _WIN32
+    m_handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_handle != INVALID_HANDLE_VALUE) {
+        OVERLAPPED overlapped{};
+        LockFileEx(m_handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped);
+    }
+#else
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd >= 0) {
+        while (::flock(m_fd, LOCK_EX) != 0 && errno == EINTR) {
+        }
+    }
+#endif
+}
+
+FileLock::~FileLock()
+{
+#ifdef _WIN32
+    if (m_handle != INVALID_HANDLE_VALUE) {
+        OVERLAPPED overlapped{};
+        UnlockFileEx(m_handle, 0, MAXDWORD, MAXDWORD, &overlapped);
+        CloseHandle(m_handle);
+    }
+#else
+    if (m_fd >= 0) {
+        ::flock(m_fd, LOCK_UN);
+        ::close(m_fd);
+    }
+#endif
+}
+
+bool writeFileDurably(const std::string& path, const std::string& data, bool append)
+{
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC);
+    int fd = _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+    int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+    int fd = ::open(path.c_str(), flags, 0644);
+#endif
+    if (fd < 0)
+        return false;
+
+    bool ok = true;
+    std::size_t written = 0;
+    while (ok && written < data.size()) {
+#ifdef _WIN32
+        int n = _write(fd, data.data() + written, static_cast<unsigned int>(data.size() - written));
+#else
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR)
+            continue;
+#endif
+        if (n <= 0)
+            ok = false;
+        else
+            written += static_cast<std::size_t>(n);
+    }
+
+#ifdef _WIN32
+    ok = ok && _commit(fd) == 0;
+    _close(fd);
+#else
+    ok = ok && ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return ok;
+}
+
+bool syncFile(std::FILE* file)
+{
+    if (std::fflush(file) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return ::fsync(fileno(file)) == 0;
+#endif
+}
+
+bool replaceFileAtomically(const std::string& from, const std::string& to)
+{
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (std::rename(from.c_str(), to.c_str()) != 0)
+        return false;
+    // make the rename itself durable
+    std::string::size_type slash = to.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : to.substr(0, slash);
+    int dirFd = ::open(dir.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+#endif
+}
+
+bool readLines(const std::string& path, const char* what, const std::function<bool(std::istream& fields)>& parse)
+{
+    std::ifstream in(path);
+    if (!in.good()) {
+        std::cerr << "Failed to open " << what << " " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        std::string::size_type hash = line.find('#');
+        if (hash != std::string::npos)
+            line.erase(hash);
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;  // blank or comment
+
+        std::istringstream fields(line);
+        bool ok = parse(fields);
+        std::string extra;
+        fields.clear();
+        if (!ok || fields >> extra) {
+            std::cerr << path << ":" << number << ": cannot parse \"" << line << "\"" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef FILEUTILS_H
+#define FILEUTILS_H
+
+#include <cstdio>
+#include <functional>
+#include <istream>
+#include <string>
+
+/**
+ * @brief advisory whole-file lock, held until the object goes out of scope
+ * @details Used to serialise writers from several processes sharing one file set.
+ */
+class FileLock
+{
+public:
+    /**
+     * @brief block until the lock file at path is held exclusively
+     *
+     * @param path lock file, created if missing
+     */
+    explicit FileLock(const std::string& path);
+
+    /**
+     * @brief release the lock
+     */
+    ~FileLock();
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+private:
+#ifdef _WIN32
+    void* m_handle;
+#else
+    int m_fd = -1;
+#endif
+};
+
+/**
+ * @brief write data to a file and force it to disk before returning
+ *
+ * @param path file to write
+ * @param data bytes to write
+ * @param append append instead of truncating
+ * @return true if every byte was written and synced
+ */
+bool writeFileDurably(const std::string& path, const std::string& data, bool append);
+
+/**
+ * @brief force a stdio stream's buffered and cached data to disk
+ *
+ * @param file open stream
+ * @return true on success
+ */
+bool syncFile(std::FILE* file);
+
+/**
+ * @brief atomically replace one file with another (write-then-rename)
+ *
+ * @param from fully written temporary file
+ * @param to destination, replaced if it exists
+ * @return true on success
+ */
+bool replaceFileAtomically(const std::string& from, const std::string& to);
+
+/**
+ * @brief read a text file of one entry per line, as every settings file here is laid out
+ * @details '#' starts a comment and lines left blank are skipped. Each other line
+ * is handed to parse() as a stream of its fields; a line parse() rejects, or that
+ * has anything left over after it, is reported as path:line: cannot parse "..."
+ * and reading stops there.
+ *
+ * @param path file to read
+ * @param what what the file holds, for the message if it cannot be opened
+ * @param parse reads one line's fields, false if they are not valid
+ * @return true if the file opened and every line parsed
+ */
+bool readLines(const std::string& path, const char* what, const std::function<bool(std::istream& fields)>& parse);
+
+#endif // FILEUTILS_H
@@ -0,0 +1,51 @@
+#include "FrameArena.h"
+
+#include <new>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : m_block(new unsigned char[capacity])
+    , m_capacity(capacity)
+{
+}
+
+FrameArena& FrameArena::local()
+{
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_block.get());
+    std::size_t start = static_cast<std::size_t>(((base + m_top + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1)) - base);
+    if (start + bytes > m_capacity || bytes == 0) {
+        // a zero-byte request still needs a unique pointer; the heap gives one
+        if (bytes > 0)
+            ++m_overflows;
+        return ::operator new(bytes);
+    }
+    m_top = start + bytes;
+    if (m_top > m_peak)
+        m_peak = m_top;
+    return m_block.get() + start;
+}
+
+void FrameArena::deallocate(void* p, std::size_t bytes)
+{
+    if (!owns(p)) {
+        ::operator delete(p);
+        return;
+    }
+    // the last allocation can be taken back; anything else waits for reset()
+    unsigned char* c = static_cast<unsigned char*>(p);
+    if (c + bytes == m_block.get() + m_top)
+        m_top = static_cast<std::size_t>(c - m_block.get());
+}
+
+void FrameArena::reset()
+{
+    if (m_peak > m_highWater)
+        m_highWater = m_peak;
+    m_top = 0;
+    m_peak = 0;
+}
@@ -0,0 +1,146 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief bump-pointer scratch memory for buffers that live no longer than a frame
+ * @details Allocating moves a pointer through one block; freeing does nothing,
+ * except that freeing the most recent allocation hands its bytes back, so a
+ * buffer built and dropped inside one function costs nothing past its use.
+ * reset() empties the whole arena at once and is called once per frame by the
+ * thread that owns it: Game::run for the sim, Game::renderLoop for drawing.
+ * Memory from before a reset must not be touched after it. An allocation that
+ * does not fit goes to the global heap instead and is counted, so running out is
+ * a performance problem, not a crash. Each thread has its own arena, local();
+ * nothing is shared, so nothing is locked.
+ */
+class FrameArena
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    /**
+     * @brief an empty arena
+     *
+     * @param capacity bytes in its block, allocated up front
+     */
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief the calling thread's arena, created on first use
+     *
+     * @return FrameArena& this thread's arena
+     */
+    static FrameArena& local();
+
+    /**
+     * @brief take memory from the arena
+     *
+     * @param bytes size
+     * @param alignment a power of two
+     * @return void* the memory; from the heap if the arena is full
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /**
+     * @brief give memory back; only the most recent allocation is reused before reset()
+     *
+     * @param p memory from allocate()
+     * @param bytes its size
+     */
+    void deallocate(void* p, std::size_t bytes);
+
+    /**
+     * @brief forget every allocation, noting how far this frame got
+     */
+    void reset();
+
+    /**
+     * @brief the most bytes in use at once since the last reset()
+     */
+    std::size_t peak() const { return m_peak; }
+
+    /**
+     * @brief the most bytes in use at once since the arena was made
+     */
+    std::size_t highWater() const { return m_highWater > m_peak ? m_highWater : m_peak; }
+
+    /**
+     * @brief bytes in the block
+     */
+    std::size_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief allocations that did not fit and went to the heap
+     */
+    std::uint64_t overflows() const { return m_overflows; }
+
+private:
+    bool owns(const void* p) const
+    {
+        const unsigned char* c = static_cast<const unsigned char*>(p);
+        return c >= m_block.get() && c < m_block.get() + m_capacity;
+    }
+
+    std::unique_ptr<unsigned char[]> m_block;
+    std::size_t m_capacity;
+    std::size_t m_top = 0;         // first free byte
+    std::size_t m_peak = 0;        // highest m_top this frame
+    std::size_t m_highWater = 0;   // highest m_peak of earlier frames
+    std::uint64_t m_overflows = 0;
+};
+
+/**
+ * @brief an STL allocator that takes memory from a FrameArena
+ * @details Containers using it must be dropped, or at least not touched, before
+ * their arena is next reset. Two allocators are equal when they share an arena.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator() : m_arena(&FrameArena::local()) {}
+
+    explicit ArenaAllocator(FrameArena& arena) : m_arena(&arena) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.arena()) {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t count)
+    {
+        m_arena->deallocate(p, count * sizeof(T));
+    }
+
+    FrameArena* arena() const { return m_arena; }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const { return m_arena == other.arena(); }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return m_arena != other.arena(); }
+
+private:
+    FrameArena* m_arena;
+};
+
+/**
+ * @brief a vector in the calling thread's frame arena
+ */
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,47 @@
+#include "FrameBuffer.h"
+#include "Metrics.h"
+
+#include <algorithm>
+#include <iostream>
+
+sf::View FrameBuffer::layoutView()
+{
+    sf::Vector2u size = layoutSize();
+    return sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y)));
+}
+
+bool FrameBuffer::create()
+{
+    if (!m_texture.create(NATIVE_WIDTH, NATIVE_HEIGHT)) {
+        std::cerr << "Failed to create the " << NATIVE_WIDTH << "x" << NATIVE_HEIGHT << " frame buffer" << std::endl;
+        return false;
+    }
+    // hard pixel edges when scaled up
+    m_texture.setSmooth(false);
+    m_texture.setView(layoutView());
+    m_sprite.setTexture(m_texture.getTexture(), true);
+    return true;
+}
+
+sf::Image FrameBuffer::capture()
+{
+    m_texture.display();
+    return m_texture.getTexture().copyToImage();
+}
+
+void FrameBuffer::present(sf::RenderWindow& window)
+{
+    m_texture.display();
+
+    // largest whole-number scale that fits; letterbox whatever is left over
+    sf::Vector2u windowSize = window.getSize();
+    unsigned int factor = std::max(1u, std::min(windowSize.x / NATIVE_WIDTH, windowSize.y / NATIVE_HEIGHT));
+    int left = (static_cast<int>(windowSize.x) - static_cast<int>(NATIVE_WIDTH * factor)) / 2;
+    int top = (static_cast<int>(windowSize.y) - static_cast<int>(NATIVE_HEIGHT * factor)) / 2;
+
+    m_sprite.setScale(static_cast<float>(factor), static_cast<float>(factor));
+    m_sprite.setPosition(static_cast<float>(left), static_cast<float>(top));
+    window.setView(window.getDefaultView());
+    window.draw(m_sprite);
+    Metrics::instance().add(Metrics::Counter::DrawCalls);
+}
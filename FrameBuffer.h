@@ -0,0 +1,73 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief off-screen target at the arcade's native 224x288 resolution
+ * @details States keep drawing in layout coordinates (672x864, three per arcade
+ * pixel); the target's view maps them onto the native pixels, so every fill and
+ * texture fetch happens at 1/9th of the old cost. present() then scales the result
+ * to the window once, nearest-neighbour, by the largest whole factor that fits.
+ */
+class FrameBuffer
+{
+public:
+    static constexpr unsigned int NATIVE_WIDTH = 224;
+    static constexpr unsigned int NATIVE_HEIGHT = 288;
+    static constexpr unsigned int LAYOUT_SCALE = 3;   // layout units per arcade pixel
+
+    /**
+     * @brief size of the coordinate space states lay themselves out in
+     *
+     * @return sf::Vector2u 672x864, whatever the window size
+     */
+    static sf::Vector2u layoutSize() { return sf::Vector2u(NATIVE_WIDTH * LAYOUT_SCALE, NATIVE_HEIGHT * LAYOUT_SCALE); }
+
+    /**
+     * @brief view that maps layout coordinates onto a native-resolution target
+     *
+     * @return sf::View view covering the whole layout
+     */
+    static sf::View layoutView();
+
+    /**
+     * @brief allocate the native-resolution target
+     *
+     * @return true if the render texture could be created
+     */
+    bool create();
+
+    /**
+     * @brief the target states render into
+     *
+     * @return sf::RenderTarget& the off-screen target
+     */
+    sf::RenderTarget& target() { return m_texture; }
+
+    /**
+     * @brief clear the target to black before a frame
+     */
+    void clear() { m_texture.clear(sf::Color::Black); }
+
+    /**
+     * @brief upscale the finished frame to the window, centred
+     *
+     * @param window window to draw into; the caller displays it
+     */
+    void present(sf::RenderWindow& window);
+
+    /**
+     * @brief copy the finished frame back from the GPU
+     * @details Waits for the frame to finish drawing; for tests, not every frame.
+     *
+     * @return sf::Image the frame at native resolution
+     */
+    sf::Image capture();
+
+private:
+    sf::RenderTexture m_texture;
+    sf::Sprite m_sprite;
+};
+
+#endif // FRAMEBUFFER_H
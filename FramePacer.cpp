@@ -0,0 +1,94 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+// Sleep until this close to the deadline, then spin. The margin follows how late
+// sleeps actually wake up on this machine, within these bounds.
+constexpr std::chrono::microseconds MIN_SPIN_MARGIN(500);
+constexpr std::chrono::microseconds MAX_SPIN_MARGIN(3000);
+
+} // namespace
+
+void FramePacer::wait(double hz)
+{
+    Clock::time_point now = Clock::now();
+
+    if (hz > 0.0) {
+        auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+        m_deadline += period;
+
+        // more than a frame late (first frame, a stall, a rate change): start over
+        if (now > m_deadline + period || m_deadline > now + period)
+            m_deadline = now + period;
+
+        if (m_deadline - now > m_spinMargin) {
+            Clock::time_point wake = m_deadline - m_spinMargin;
+            std::this_thread::sleep_until(wake);
+
+            // widen the margin straight away after a late wake-up, shrink it slowly
+            Clock::duration late = Clock::now() - wake;
+            if (late > m_spinMargin)
+                m_spinMargin = std::min<Clock::duration>(late, MAX_SPIN_MARGIN);
+            else
+                m_spinMargin = std::max<Clock::duration>(m_spinMargin - m_spinMargin / 64, MIN_SPIN_MARGIN);
+        }
+        while (Clock::now() < m_deadline)
+            std::this_thread::yield();
+        now = Clock::now();
+    }
+
+    if (m_recording && m_lastFrame != Clock::time_point{})
+        m_intervals.push_back(std::chrono::duration<float, std::milli>(now - m_lastFrame).count());
+    m_lastFrame = now;
+}
+
+void FramePacer::setRecording(bool enabled)
+{
+    m_recording = enabled;
+    m_intervals.clear();
+    m_recordStart = Clock::now();
+    m_cpuStart = std::clock();
+}
+
+void FramePacer::report(std::ostream& out) const
+{
+    if (m_intervals.empty()) {
+        out << "Frame pacing: no frames recorded\n";
+        return;
+    }
+
+    double sum = 0.0;
+    for (float ms : m_intervals)
+        sum += static_cast<double>(ms);
+    double mean = sum / static_cast<double>(m_intervals.size());
+
+    double squares = 0.0;
+    std::vector<float> deviations;
+    deviations.reserve(m_intervals.size());
+    for (float ms : m_intervals) {
+        double d = static_cast<double>(ms) - mean;
+        squares += d * d;
+        deviations.push_back(static_cast<float>(std::fabs(d)));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    std::size_t p99 = std::min(deviations.size() - 1, deviations.size() * 99 / 100);
+
+    double wall = std::chrono::duration<double>(Clock::now() - m_recordStart).count();
+    double cpu = static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+
+    out << std::fixed << std::setprecision(3)
+        << "Frame pacing: " << m_intervals.size() << " frames, mean " << mean << " ms ("
+        << std::setprecision(1) << 1000.0 / mean << " fps)\n"
+        << std::setprecision(3)
+        << "  jitter: stddev " << std::sqrt(squares / static_cast<double>(m_intervals.size())) << " ms, p50 |dev| "
+        << deviations[deviations.size() / 2] << " ms, p99 |dev| "
+        << deviations[p99] << " ms, max |dev| " << deviations.back() << " ms\n"
+        << std::setprecision(1)
+        << "  CPU: " << (wall > 0.0 ? 100.0 * cpu / wall : 0.0) << "% of one core\n";
+}
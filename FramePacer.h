@@ -0,0 +1,54 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <chrono>
+#include <ctime>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief holds the main loop to a steady frame rate
+ * @details wait() sleeps most of the remaining frame time and spin-waits the last
+ * stretch, because OS sleeps wake up late by an unpredictable amount; the spin
+ * margin adapts to how late they have been waking. Deadlines
+ * advance by whole periods so small overshoots do not accumulate; after a long
+ * stall the schedule restarts from now instead of rushing to catch up.
+ */
+class FramePacer
+{
+public:
+    /**
+     * @brief block until the next frame is due
+     *
+     * @param hz target rate for this frame; 0 returns at once (unlimited or vsync)
+     */
+    void wait(double hz);
+
+    /**
+     * @brief record frame intervals and CPU time for report()
+     *
+     * @param enabled true to record
+     */
+    void setRecording(bool enabled);
+
+    /**
+     * @brief print frame-time jitter and CPU use since recording started
+     *
+     * @param out stream to write to
+     */
+    void report(std::ostream& out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point m_deadline{};
+    Clock::time_point m_lastFrame{};
+    Clock::duration m_spinMargin = std::chrono::microseconds(1500);
+
+    bool m_recording = false;
+    std::vector<float> m_intervals;   // ms between successive wait() returns
+    Clock::time_point m_recordStart{};
+    std::clock_t m_cpuStart = 0;
+};
+
+#endif // FRAMEPACER_H
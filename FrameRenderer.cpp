@@ -0,0 +1,26 @@
+#include "FrameRenderer.h"
+
+DrawCounts FrameRenderer::draw(FrameBuffer& buffer, const FrameSnapshot& frame)
+{
+    // States recorded at layout coordinates; the frame buffer draws them at
+    // native resolution and the window gets one upscaled copy.
+    buffer.clear();
+    CountedTarget target(buffer.target());
+    const FrameSnapshot::MazeLayer& maze = frame.maze();
+    if (maze.generation != 0) {
+        m_maze.update(maze);
+        m_maze.draw(target);
+    }
+    if (maze.generation != 0 && maze.layout) {
+        // a scrolling maze: its visible chunks and the actors on them go
+        // through the camera, clipped to the area below the HUD
+        target.setView(MazeView::cameraView(maze));
+        m_maze.drawChunks(target, maze);
+        frame.draw(target);
+        target.setView(FrameBuffer::layoutView());
+    }
+    else {
+        frame.draw(target);
+    }
+    return target.counts();
+}
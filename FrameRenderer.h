@@ -0,0 +1,32 @@
+#ifndef FRAMERENDERER_H
+#define FRAMERENDERER_H
+
+#include "CountedTarget.h"
+#include "FrameBuffer.h"
+#include "FrameSnapshot.h"
+#include "MazeView.h"
+
+/**
+ * @brief draws snapshots into a frame buffer
+ * @details The maze and HUD come from a MazeView kept up to date across frames,
+ * a scrolling maze's chunks and actors go through its camera, and everything else
+ * the state recorded is drawn on top. Shared by the render thread and the
+ * offscreen render test, so both draw exactly the same frames.
+ */
+class FrameRenderer
+{
+public:
+    /**
+     * @brief clear the frame buffer and draw one snapshot into it
+     *
+     * @param buffer target, created at native resolution
+     * @param frame snapshot to draw
+     * @return DrawCounts what the frame submitted
+     */
+    DrawCounts draw(FrameBuffer& buffer, const FrameSnapshot& frame);
+
+private:
+    MazeView m_maze;
+};
+
+#endif // FRAMERENDERER_H
@@ -0,0 +1,207 @@
+#include "FrameSnapshot.h"
+#include "FrameArena.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+float dot(sf::Vector2f a, sf::Vector2f b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+sf::Vector2f edgeNormal(sf::Vector2f from, sf::Vector2f to)
+{
+    sf::Vector2f normal(from.y - to.y, to.x - from.x);
+    float length = std::sqrt(dot(normal, normal));
+    return length > 0.f ? normal / length : normal;
+}
+
+// where sf::Shape puts the outer edge of its outline at one corner: pushed out
+// along the mitre of the two edges that meet there
+sf::Vector2f outlinePoint(const ArenaVector<sf::Vector2f>& points, std::size_t index, sf::Vector2f centre, float thickness)
+{
+    std::size_t count = points.size();
+    sf::Vector2f p0 = points[(index + count - 1) % count];
+    sf::Vector2f p1 = points[index];
+    sf::Vector2f p2 = points[(index + 1) % count];
+
+    sf::Vector2f n1 = edgeNormal(p0, p1);
+    sf::Vector2f n2 = edgeNormal(p1, p2);
+    if (dot(n1, centre - p1) > 0.f)
+        n1 = -n1;
+    if (dot(n2, centre - p1) > 0.f)
+        n2 = -n2;
+
+    float factor = 1.f + dot(n1, n2);
+    return p1 + (n1 + n2) / factor * thickness;
+}
+
+} // namespace
+
+FrameSnapshot::FrameSnapshot()
+{
+    m_runs.reserve(RESERVED_RUNS);
+}
+
+void FrameSnapshot::clear()
+{
+    m_vertices.clear();
+    m_runs.clear();
+    m_maze.generation = 0;
+    m_maze.layout.reset();
+    m_maze.pellets.reset();
+    m_idle = false;
+    m_state = "none";
+}
+
+void FrameSnapshot::useTexture(const sf::Texture* texture)
+{
+    if (m_runs.empty() || m_runs.back().texture != texture)
+        m_runs.push_back(Run{ texture, m_vertices.size() });
+}
+
+void FrameSnapshot::pushQuad(const sf::Vertex& topLeft, const sf::Vertex& topRight, const sf::Vertex& bottomLeft, const sf::Vertex& bottomRight)
+{
+    m_vertices.push_back(topLeft);
+    m_vertices.push_back(topRight);
+    m_vertices.push_back(bottomLeft);
+    m_vertices.push_back(bottomLeft);
+    m_vertices.push_back(topRight);
+    m_vertices.push_back(bottomRight);
+}
+
+void FrameSnapshot::addSprite(const sf::Sprite& sprite, const sf::Transform& parent)
+{
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture)
+        return;
+
+    sf::Transform transform = parent * sprite.getTransform();
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const sf::Color& color = sprite.getColor();
+
+    // same corners and texture coordinates as sf::Sprite, flipped rectangles included
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    float u1 = static_cast<float>(rect.left);
+    float v1 = static_cast<float>(rect.top);
+    float u2 = static_cast<float>(rect.left + rect.width);
+    float v2 = static_cast<float>(rect.top + rect.height);
+
+    useTexture(texture);
+    pushQuad(sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(u1, v1)),
+        sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(u2, v1)),
+        sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(u1, v2)),
+        sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(u2, v2)));
+}
+
+void FrameSnapshot::addQuad(const sf::Texture* texture, const sf::FloatRect& dest, const sf::FloatRect& source, const sf::Color& color)
+{
+    float right = dest.left + dest.width;
+    float bottom = dest.top + dest.height;
+    float u2 = source.left + source.width;
+    float v2 = source.top + source.height;
+
+    useTexture(texture);
+    pushQuad(sf::Vertex(sf::Vector2f(dest.left, dest.top), color, sf::Vector2f(source.left, source.top)),
+        sf::Vertex(sf::Vector2f(right, dest.top), color, sf::Vector2f(u2, source.top)),
+        sf::Vertex(sf::Vector2f(dest.left, bottom), color, sf::Vector2f(source.left, v2)),
+        sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2)));
+}
+
+void FrameSnapshot::addShape(const sf::Shape& shape)
+{
+    std::size_t count = shape.getPointCount();
+    if (count < 3)
+        return;
+
+    const sf::Transform& transform = shape.getTransform();
+    useTexture(nullptr);
+
+    // each corner fetched and transformed once, into the frame arena, rather than
+    // once for every triangle and quad that shares it
+    ArenaVector<sf::Vector2f> points;
+    points.reserve(count);
+    sf::Vector2f centre;
+    for (std::size_t i = 0; i < count; ++i) {
+        points.push_back(shape.getPoint(i));
+        centre += points.back();
+    }
+    centre /= static_cast<float>(count);
+    ArenaVector<sf::Vector2f> corners;
+    corners.reserve(count);
+    for (const sf::Vector2f& point : points)
+        corners.push_back(transform.transformPoint(point));
+
+    // fill: a fan around the centre, as sf::Shape draws it
+    const sf::Color& fill = shape.getFillColor();
+    if (fill.a > 0) {
+        sf::Vector2f c = transform.transformPoint(centre);
+        for (std::size_t i = 0; i < count; ++i) {
+            m_vertices.emplace_back(c, fill);
+            m_vertices.emplace_back(corners[i], fill);
+            m_vertices.emplace_back(corners[(i + 1) % count], fill);
+        }
+    }
+
+    // outline: a strip between each corner and its pushed-out copy
+    const sf::Color& outline = shape.getOutlineColor();
+    if (shape.getOutlineThickness() == 0.f || outline.a == 0)
+        return;
+    ArenaVector<sf::Vector2f> outer;
+    outer.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        outer.push_back(transform.transformPoint(outlinePoint(points, i, centre, shape.getOutlineThickness())));
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t next = (i + 1) % count;
+        pushQuad(sf::Vertex(corners[i], outline), sf::Vertex(outer[i], outline),
+            sf::Vertex(corners[next], outline), sf::Vertex(outer[next], outline));
+    }
+}
+
+void FrameSnapshot::addLine(sf::Vector2f from, sf::Vector2f to, float thickness, const sf::Color& color)
+{
+    sf::Vector2f side = edgeNormal(from, to) * (thickness / 2.f);
+    useTexture(nullptr);
+    pushQuad(sf::Vertex(from - side, color), sf::Vertex(to - side, color),
+        sf::Vertex(from + side, color), sf::Vertex(to + side, color));
+}
+
+void FrameSnapshot::addRing(sf::Vector2f centre, float radius, float thickness, const sf::Color& color, std::size_t segments)
+{
+    if (segments < 3)
+        return;
+
+    // the same corners as sf::CircleShape, starting at its top; each direction is
+    // worked out once, in the frame arena, and shared by the two quads beside it
+    const float PI = 3.141592654f;
+    ArenaVector<sf::Vector2f> directions;
+    directions.reserve(segments);
+    for (std::size_t i = 0; i < segments; ++i) {
+        float angle = static_cast<float>(i) * 2.f * PI / static_cast<float>(segments) - PI / 2.f;
+        directions.emplace_back(std::cos(angle), std::sin(angle));
+    }
+
+    float outer = radius + thickness;
+    useTexture(nullptr);
+    for (std::size_t i = 0; i < segments; ++i) {
+        const sf::Vector2f& a = directions[i];
+        const sf::Vector2f& b = directions[(i + 1) % segments];
+        pushQuad(sf::Vertex(centre + a * radius, color), sf::Vertex(centre + a * outer, color),
+            sf::Vertex(centre + b * radius, color), sf::Vertex(centre + b * outer, color));
+    }
+}
+
+void FrameSnapshot::draw(CountedTarget& target) const
+{
+    for (std::size_t i = 0; i < m_runs.size(); ++i) {
+        std::size_t end = i + 1 < m_runs.size() ? m_runs[i + 1].first : m_vertices.size();
+        if (end == m_runs[i].first)
+            continue;
+        sf::RenderStates states;
+        states.texture = m_runs[i].texture;
+        target.draw(&m_vertices[m_runs[i].first], end - m_runs[i].first, sf::Triangles, states);
+    }
+}
@@ -0,0 +1,200 @@
+#ifndef FRAMESNAPSHOT_H
+#define FRAMESNAPSHOT_H
+
+#include "CountedTarget.h"
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct MazeLayout;
+class PelletLog;
+
+/**
+ * @brief everything the render thread needs to draw one frame, recorded after a sim tick
+ * @details States record sprites, glyphs and shapes as triangles already transformed
+ * into layout coordinates, grouped into runs that share a texture, plus the maze
+ * layer (HUD values, how many pellets are gone) as plain numbers. Once published a
+ * snapshot is never written again, and drawing it touches no game object, so the
+ * sim can run the next tick while the previous one is on its way to the screen.
+ * Textures are referenced by pointer and must come from the ResourceCache; maze
+ * layouts and pellet logs are shared and never change under a published count.
+ * Storage is kept between clear() calls, so a steady scene records without
+ * allocating.
+ */
+class FrameSnapshot
+{
+public:
+    /**
+     * @brief the maze, eaten pellets and HUD, drawn first and cached by MazeView
+     */
+    struct MazeLayer
+    {
+        std::uint32_t generation = 0;          // 0 = no maze; a new value means the maze was laid out again
+        const sf::Texture* texture = nullptr;  // baked map image, for the arcade maze
+        std::shared_ptr<const MazeLayout> layout;   // or tiles to draw, for a maze that scrolls
+        sf::FloatRect camera;                  // with a layout: the part shown, in maze coordinates
+        sf::Vector2f position;                 // top-left of the maze on screen, layout coordinates
+        float scale = 1.f;                     // map pixels to layout units
+        sf::Vector2f tileSize;
+        std::size_t columns = 0;
+        std::shared_ptr<const PelletLog> pellets;   // pellets eaten in this generation, in order
+        std::size_t pelletsEaten = 0;          // how many of them this frame shows
+        int score = 0;
+        int highScore = 0;
+        int lives = 0;
+    };
+
+    // room for this many texture runs is made up front; turning on the ghosts' debug overlays
+    // interleaves untextured runs with the sprites' and needs more than a plain frame
+    static constexpr std::size_t RESERVED_RUNS = 64;
+
+    /**
+     * @brief an empty snapshot, with room for RESERVED_RUNS runs
+     */
+    FrameSnapshot();
+
+    /**
+     * @brief drop everything recorded, keeping the storage
+     */
+    void clear();
+
+    /**
+     * @brief record a sprite
+     *
+     * @param sprite sprite with its texture, rectangle, colour and transform
+     * @param parent transform applied on top of the sprite's own
+     */
+    void addSprite(const sf::Sprite& sprite, const sf::Transform& parent = sf::Transform::Identity);
+
+    /**
+     * @brief record one axis-aligned textured quad
+     *
+     * @param texture texture to sample, from the ResourceCache
+     * @param dest rectangle in layout coordinates
+     * @param source texture rectangle in pixels
+     * @param color vertex colour the texture is multiplied by
+     */
+    void addQuad(const sf::Texture* texture, const sf::FloatRect& dest, const sf::FloatRect& source, const sf::Color& color);
+
+    /**
+     * @brief record an untextured convex shape with its outline
+     *
+     * @param shape rectangle, circle or any other convex sf::Shape
+     */
+    void addShape(const sf::Shape& shape);
+
+    /**
+     * @brief record an untextured straight line
+     * @details Unlike an sf::RectangleShape this builds nothing on the heap, so
+     * per-frame overlays can use it.
+     *
+     * @param from one end, layout coordinates
+     * @param to the other end
+     * @param thickness width across the line
+     * @param color line colour
+     */
+    void addLine(sf::Vector2f from, sf::Vector2f to, float thickness, const sf::Color& color);
+
+    /**
+     * @brief record an untextured ring, drawn like an sf::CircleShape's outline
+     *
+     * @param centre centre, layout coordinates
+     * @param radius inner radius
+     * @param thickness width of the ring outside the radius
+     * @param color ring colour
+     * @param segments straight pieces around it, 30 as sf::CircleShape
+     */
+    void addRing(sf::Vector2f centre, float radius, float thickness, const sf::Color& color, std::size_t segments = 30);
+
+    /**
+     * @brief the maze layer, for the state that owns the maze to fill in
+     *
+     * @return MazeLayer& maze layer; generation 0 leaves it off
+     */
+    MazeLayer& maze() { return m_maze; }
+
+    /**
+     * @brief the maze layer as recorded
+     *
+     * @return const MazeLayer& maze layer
+     */
+    const MazeLayer& maze() const { return m_maze; }
+
+    /**
+     * @brief mark the frame as coming from a state that is only waiting for input
+     *
+     * @param idle true to let the render thread drop to a low frame rate
+     */
+    void setIdle(bool idle) { m_idle = idle; }
+
+    /**
+     * @brief whether the recording state was idle
+     *
+     * @return true if nothing on screen needs a full frame rate
+     */
+    bool idle() const { return m_idle; }
+
+    /**
+     * @brief name the state that recorded the frame, to pick its render budget
+     *
+     * @param state GameState::name() of the recording state
+     */
+    void setState(const char* state) { m_state = state; }
+
+    /**
+     * @brief name of the state that recorded the frame
+     *
+     * @return const char* GameState::name(), or "none"
+     */
+    const char* state() const { return m_state; }
+
+    /**
+     * @brief number the snapshot in publication order
+     *
+     * @param sequence snapshot number
+     */
+    void setSequence(std::uint64_t sequence) { m_sequence = sequence; }
+
+    /**
+     * @brief publication number, 0 before the first publish
+     *
+     * @return std::uint64_t snapshot number
+     */
+    std::uint64_t sequence() const { return m_sequence; }
+
+    /**
+     * @brief draw the recorded sprites, glyphs and shapes, one draw call per run
+     *
+     * @param target target in layout coordinates
+     */
+    void draw(CountedTarget& target) const;
+
+private:
+    struct Run
+    {
+        const sf::Texture* texture;
+        std::size_t first;   // index into m_vertices; the run ends where the next begins
+    };
+
+    /**
+     * @brief continue the last run if it samples this texture, else start a new one
+     */
+    void useTexture(const sf::Texture* texture);
+
+    /**
+     * @brief append the two triangles of a quad given its corners in drawing order
+     */
+    void pushQuad(const sf::Vertex& topLeft, const sf::Vertex& topRight, const sf::Vertex& bottomLeft, const sf::Vertex& bottomRight);
+
+    std::vector<sf::Vertex> m_vertices;   // triangles
+    std::vector<Run> m_runs;
+    MazeLayer m_maze;
+    bool m_idle = false;
+    const char* m_state = "none";
+    std::uint64_t m_sequence = 0;
+};
+
+#endif // FRAMESNAPSHOT_H
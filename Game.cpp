@@ -1,48 +1,246 @@
 #include "Game.h"
+#include "AllocCounter.h"
+#include "EndGameState.h"
+#include "FrameArena.h"
 #include "StateManager.h"
 #include "MainMenuState.h"
+#include "PlayingState.h"
+#include "LatencyProbe.h"
+#include "Metrics.h"
+#include "RenderBudget.h"
+#include "Telemetry.h"
 
+#include <cstdio>
 #include <iostream>
-#include <SFML/System/Clock.hpp>
 
-Game::Game() : m_window(sf::VideoMode(224 * 3, 288 * 3), "PacMan ~ maxkacere", sf::Style::Titlebar | sf::Style::Close)
+Game::Game(unsigned int scale) : m_window(sf::VideoMode(FrameBuffer::NATIVE_WIDTH * scale, FrameBuffer::NATIVE_HEIGHT * scale), "PacMan ~ maxkacere", sf::Style::Titlebar | sf::Style::Close)
 {
+    // one KeyPressed per physical press; held keys are tracked by Input
+    m_window.setKeyRepeatEnabled(false);
+
+    // every texture and glyph page the states use is made now, while this thread
+    // still holds the window's context; once run() hands it to the render thread,
+    // states built on the sim thread only look them up and never touch GL
+    MainMenuState::preload();
+    PlayingState::preload();
+    EndGameState::preload();
     m_stateManager.pushState(std::make_unique<MainMenuState>(m_stateManager, m_window));
 }
 
+bool Game::loadInputScript(const std::string& path)
+{
+    if (!m_script.load(path))
+        return false;
+    LatencyProbe::instance().setEnabled(true);
+    return true;
+}
+
 void Game::run()
 {
-    sf::Clock clock;
-    while (m_window.isOpen()) {
-        // Process window events.
+    // the simulation always advances in whole 60 Hz ticks; rendering runs on its
+    // own thread as often as the display allows
+    const sf::Time TICK = sf::seconds(1.f / 60.f);
+    const sf::Time MAX_CATCH_UP = sf::seconds(0.25f);
+
+    // the render thread owns the window's GL context from here on
+    m_window.setActive(false);
+    m_running = true;
+    m_renderThread = std::thread(&Game::renderLoop, this);
+
+    sf::Time simTime = Input::now();   // input clock time the sim has reached
+    m_script.start(simTime);
+    bool quit = false;
+
+    while (!quit) {
+        // Process window events; keyboard input is queued with its poll time.
         sf::Event event;
         while (m_window.pollEvent(event)) {
             if (event.type == sf::Event::Closed)
-                m_window.close();
+                quit = true;
+            else if (event.type == sf::Event::GainedFocus)
+                m_hasFocus = true;
+            else if (event.type == sf::Event::LostFocus)
+                m_hasFocus = false;
+
+            m_input.push(event, Input::now());
         }
 
-        // Calculate time since last frame.
-        sf::Time dt = clock.restart();
+        // scripted input joins the queue as if it had just been polled
+        if (m_script.active() && !m_script.feed(m_input, Input::now()))
+            quit = true;
+
+        // after a long stall (loading, a deliberate pause) skip ahead rather than
+        // replaying seconds of ticks at once
+        sf::Time now = Input::now();
+        if (now - simTime > MAX_CATCH_UP)
+            simTime = now - MAX_CATCH_UP;
+
+        // scratch from the last batch of ticks is done with
+        FrameArena::local().reset();
+
+        bool ticked = false;
+        std::uint64_t allocations = AllocCounter::thisThread();
+        while (simTime + TICK <= now) {
+            // input that arrived by the end of this tick applies on this tick
+            m_input.beginTick(simTime + TICK);
+            Telemetry::instance().tick();
+            sf::Clock tickClock;
+
+            // Handle events using the current state.
+            if (auto state = m_stateManager.getCurrentState()) {
+                state->handleEvents(m_window, m_input);
+            }
 
-        // Handle events using the current state.
-        if (auto state = m_stateManager.getCurrentState()) {
-            state->handleEvents(m_window);
+            // Re-fetch the state after handling events,
+            // so if a state change occurred, update the new state.
+            if (auto state = m_stateManager.getCurrentState()) {
+                state->update(TICK);
+            }
+
+            Metrics& metrics = Metrics::instance();
+            metrics.observe(Metrics::Histogram::UpdateMicros, static_cast<std::uint64_t>(tickClock.getElapsedTime().asMicroseconds()));
+            metrics.add(Metrics::Counter::SimTicks);
+            if (auto state = m_stateManager.getCurrentState())
+                metrics.setState(state->name());
+
+            simTime += TICK;
+            ticked = true;
         }
 
-        // Re-fetch the state after handling events,
-        // so if a state change occurred, update the new state.
-        if (auto state = m_stateManager.getCurrentState()) {
-            state->update(dt);
+        // rendering no longer holds up the sim: hand the result over and sleep to
+        // the next tick boundary while the render thread draws it
+        if (ticked) {
+            publishSnapshot();
+            GameState* state = m_stateManager.getCurrentState();
+            reportAllocations(Metrics::Counter::SimAllocations, m_snapshotSequence, state ? state->name() : "none",
+                AllocCounter::thisThread() - allocations, m_simAllocations);
         }
+        if (!m_stateManager.getCurrentState())
+            quit = true;
 
-        m_window.clear();
+        sf::Time untilNextTick = simTime + TICK - Input::now();
+        if (!quit && untilNextTick > sf::Time::Zero)
+            sf::sleep(untilNextTick);
+    }
 
-        // Re-check the current state again before rendering.
-        if (auto state = m_stateManager.getCurrentState()) {
-            state->render(m_window);
-        }
+    m_running = false;
+    m_renderThread.join();
+    m_window.close();
+
+    if (m_pacingStats) {
+        m_pacer.report(std::cout);
+        const FrameArena& sim = FrameArena::local();
+        std::cout << "Frame arena high water: sim " << sim.highWater() << " bytes, render " << m_renderArenaHighWater
+                  << " bytes, of " << sim.capacity() << " each; " << sim.overflows() + m_renderArenaOverflows
+                  << " allocations overflowed to the heap" << std::endl;
+    }
+
+    if (m_overBudgetFrames > 0)
+        std::cout << "Render budget: " << m_overBudgetFrames << " frames over" << std::endl;
+
+    if (AllocCounter::enabled()) {
+        std::cout << "Allocations: " << m_simAllocations << " of " << m_snapshotSequence << " snapshots and "
+                  << m_renderAllocations << " frames drawn allocated" << std::endl;
+    }
+
+    if (LatencyProbe::instance().enabled())
+        LatencyProbe::instance().report(std::cout);
+}
+
+void Game::publishSnapshot()
+{
+    FrameSnapshot& frame = m_snapshots.write();
+    frame.clear();
+    frame.setSequence(++m_snapshotSequence);
+    if (auto state = m_stateManager.getCurrentState()) {
+        state->render(frame);
+        frame.setIdle(state->isIdle());
+        frame.setState(state->name());
+    }
+    m_snapshots.publish();
+    LatencyProbe::instance().snapshotPublished(m_snapshotSequence);
+}
+
+void Game::renderLoop()
+{
+    // idle screens and a background window do not need a full frame rate
+    const double IDLE_FPS = 20.0;
+    const double UNFOCUSED_FPS = 10.0;
+
+    m_window.setActive(true);
+    m_window.setVerticalSyncEnabled(m_verticalSync);
+    m_frameBuffer.create();
+    m_pacer.setRecording(m_pacingStats);
+
+    while (m_running) {
+        // the newest finished snapshot; the last one again if the sim has not
+        // published since
+        FrameArena::local().reset();
+        m_snapshots.acquire();
+        const FrameSnapshot& frame = m_snapshots.read();
+        sf::Clock frameClock;
+        std::uint64_t allocations = AllocCounter::thisThread();
 
+        checkBudget(frame.state(), m_renderer.draw(m_frameBuffer, frame));
+
+        m_window.clear();
+        m_frameBuffer.present(m_window);
         m_window.display();
+        LatencyProbe::instance().framePresented(frame.sequence());
+        Metrics::instance().observe(Metrics::Histogram::RenderMicros, static_cast<std::uint64_t>(frameClock.getElapsedTime().asMicroseconds()));
+        Metrics::instance().add(Metrics::Counter::FramesRendered);
+        reportAllocations(Metrics::Counter::RenderAllocations, frame.sequence(), frame.state(),
+            AllocCounter::thisThread() - allocations, m_renderAllocations);
+
+        // vsync already blocked in display(); otherwise sleep out the frame
+        double rate = m_verticalSync ? 0.0 : static_cast<double>(m_frameRate);
+        if (!m_hasFocus)
+            rate = UNFOCUSED_FPS;
+        else if (frame.idle())
+            rate = IDLE_FPS;
+        m_pacer.wait(rate);
     }
+
+    // read by run() once this thread has been joined
+    m_renderArenaHighWater = FrameArena::local().highWater();
+    m_renderArenaOverflows = FrameArena::local().overflows();
+    m_window.setActive(false);
 }
 
+void Game::checkBudget(const char* state, const DrawCounts& counts)
+{
+    Metrics::instance().add(Metrics::Counter::DrawCalls, counts.drawCalls);
+    if (RenderBudget::within(state, counts)) {
+        m_overBudgetState = nullptr;
+        return;
+    }
+
+    ++m_overBudgetFrames;
+#ifndef NDEBUG
+    // once as a state goes over, not on every frame it stays there
+    if (state != m_overBudgetState) {
+        const DrawCounts* limit = RenderBudget::get(state);
+        std::cerr << "Render budget exceeded in " << state << ": "
+                  << counts.drawCalls << "/" << limit->drawCalls << " draw calls, "
+                  << counts.primitives << "/" << limit->primitives << " primitives, "
+                  << counts.textureSwitches << "/" << limit->textureSwitches << " texture switches" << std::endl;
+    }
+#endif
+    m_overBudgetState = state;
+}
+
+void Game::reportAllocations(Metrics::Counter counter, std::uint64_t sequence, const char* state, std::uint64_t allocations, std::uint64_t& frames)
+{
+    if (allocations == 0)
+        return;
+
+    Metrics::instance().add(counter, allocations);
+    ++frames;
+
+    // one write, so lines from the sim and render threads do not interleave
+    char line[128];
+    std::snprintf(line, sizeof(line), "Snapshot %llu (%s): %llu allocations %s\n",
+        static_cast<unsigned long long>(sequence), state, static_cast<unsigned long long>(allocations),
+        counter == Metrics::Counter::SimAllocations ? "recording it" : "drawing it");
+    std::cerr << line;
+}
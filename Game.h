@@ -2,7 +2,20 @@
 #define GAME_H
 
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "FrameBuffer.h"
+#include "FramePacer.h"
+#include "FrameRenderer.h"
+#include "FrameSnapshot.h"
+#include "Input.h"
+#include "InputScript.h"
+#include "Metrics.h"
 #include "StateManager.h"
+#include "TripleBuffer.h"
 
 class Game
 {
@@ -11,18 +24,120 @@ public:
     /**
      * @brief Construct a new Game object
      * 
+     * @param scale whole-number window scale over the 224x288 arcade screen
      */
-    Game();
+    explicit Game(unsigned int scale = 3);
+
+    /**
+     * @brief play synthetic input from a script alongside the keyboard
+     * @details Also turns on the latency probe; its report is printed when the
+     * game exits.
+     * 
+     * @param path script file, see InputScript
+     * @return true if the script loaded
+     */
+    bool loadInputScript(const std::string& path);
+
+    /**
+     * @brief set the frame rate the render thread is paced to
+     * @details The sim always ticks at 60 Hz, whatever the frame rate.
+     * 
+     * @param fps frames per second, 0 for unlimited
+     */
+    void setFrameRate(unsigned int fps) { m_frameRate = fps; }
+
+    /**
+     * @brief let the display's vertical sync pace rendering instead of the timer
+     * 
+     * @param enabled true to wait for vsync
+     */
+    void setVerticalSync(bool enabled) { m_verticalSync = enabled; }
+
+    /**
+     * @brief print frame-time jitter, CPU use and frame arena use when the game exits
+     * 
+     * @param enabled true to record
+     */
+    void setPacingStats(bool enabled) { m_pacingStats = enabled; }
+
+    /**
+     * @brief whether every frame drawn kept to its state's render budget
+     * @details Read once run() has returned.
+     * 
+     * @return true if no frame went over, see RenderBudget
+     */
+    bool withinBudget() const { return m_overBudgetFrames == 0; }
 
     /**
      * @brief the main game loop
+     * @details This thread polls the window and runs the 60 Hz sim, publishing a
+     * frame snapshot after each batch of ticks; a render thread draws the newest
+     * snapshot at its own pace. Returns once the window is closed or the last
+     * state is gone.
      * 
      */
     void run();
 
 private:
+    /**
+     * @brief body of the render thread: draw the newest snapshot, present, pace
+     * 
+     */
+    void renderLoop();
+
+    /**
+     * @brief record the current state into the next snapshot and hand it over
+     * 
+     */
+    void publishSnapshot();
+
+    /**
+     * @brief count a drawn frame against its state's render budget
+     * @details Debug builds warn on stderr when a state first goes over.
+     * 
+     */
+    void checkBudget(const char* state, const DrawCounts& counts);
+
+    /**
+     * @brief report the heap allocations one snapshot's ticks or drawing made
+     * @details Only with AllocCounter enabled; a steady scene should make none,
+     * so each one that does is printed on stderr and added to the metrics.
+     * 
+     * @param counter SimAllocations for the ticks and recording, RenderAllocations for drawing
+     * @param sequence the snapshot's number
+     * @param state name of the state it came from
+     * @param allocations operator new calls made
+     * @param frames count of allocating snapshots to add to
+     */
+    void reportAllocations(Metrics::Counter counter, std::uint64_t sequence, const char* state, std::uint64_t allocations, std::uint64_t& frames);
+
     sf::RenderWindow m_window;
+    Input m_input;
+    InputScript m_script;
+    unsigned int m_frameRate = 60;
+    bool m_verticalSync = false;
+    bool m_pacingStats = false;
     StateManager m_stateManager;
+
+    // shared between the sim and render threads
+    TripleBuffer<FrameSnapshot> m_snapshots;
+    std::uint64_t m_snapshotSequence = 0;
+    std::atomic<bool> m_hasFocus{ true };
+    std::atomic<bool> m_running{ false };
+    std::thread m_renderThread;
+
+    // sim thread only
+    std::uint64_t m_simAllocations = 0;      // snapshots whose ticks allocated
+
+    // render thread only
+    FrameBuffer m_frameBuffer;
+    FrameRenderer m_renderer;
+    FramePacer m_pacer;
+    std::uint64_t m_overBudgetFrames = 0;
+    const char* m_overBudgetState = nullptr;   // state of the last frame, if it was over budget
+    std::uint64_t m_renderAllocations = 0;     // frames whose drawing allocated
+    std::size_t m_renderArenaHighWater = 0;    // the render thread's FrameArena, as it exits
+    std::uint64_t m_renderArenaOverflows = 0;
 };
 
 #endif // GAME_H
@@ -2,6 +2,8 @@
 #define GAMESTATE_H
 
 #include <SFML/Graphics.hpp>
+#include "FrameSnapshot.h"
+#include "Input.h"
 
 class GameState {
 public:
@@ -13,25 +15,46 @@ public:
     virtual ~GameState() = default;
 
     /**
-     * @brief Handle events for the game state
+     * @brief Handle input for the game state
+     * @details Called once per sim tick, before update(), with the keyboard
+     * events that arrived during that tick.
      * 
      * @param window Reference to the SFML window
+     * @param input Keyboard events and key state for this tick
      */
-    virtual void handleEvents(sf::RenderWindow& window) = 0;
+    virtual void handleEvents(sf::RenderWindow& window, const Input& input) = 0;
 
     /**
      * @brief Update the game state
      * 
-     * @param dt Time since last update
+     * @param dt Length of one sim tick
      */
     virtual void update(sf::Time dt) = 0;
 
     /**
-     * @brief Render the game state
+     * @brief Whether the state is only waiting for input
+     * @details Idle states are rendered at a low frame rate to save CPU.
      * 
-     * @param window Reference to the SFML window
+     * @return true if nothing on screen needs a full frame rate
+     */
+    virtual bool isIdle() const { return false; }
+
+    /**
+     * @brief Short name of the state, as reported by the metrics endpoint
+     * 
+     * @return const char* a string literal
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Record what the game state looks like after the latest tick
+     * @details Runs on the sim thread and records in layout coordinates (672x864);
+     * the render thread draws the snapshot into the native-resolution frame buffer
+     * while the next tick runs.
+     * 
+     * @param frame Empty snapshot to record into
      */
-    virtual void render(sf::RenderWindow& window) = 0;
+    virtual void render(FrameSnapshot& frame) = 0;
 };
 
 #endif // GAMESTATE_H
@@ -1,31 +1,29 @@
 #include "Ghost.h"
+#include "AudioEngine.h"
+#include "GhostDecisions.h"
 
 #include <SFML/System/Vector2.hpp>
 #include <algorithm>
+#include <array>
 #include <random>
 #include <cstddef>
+#include <cstdint>
 
 // static RNG definition
 std::mt19937 Ghost::m_randEngine{ std::random_device{}() };
+int Ghost::s_frightenedCount = 0;
 
 Ghost::Ghost(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int level)
     : m_level(level),
-    m_pos(startPos),
+    m_params(LevelTable::get(level)),
+    m_mover(startPos),
     m_mapPos(mapPos),
-    m_nextPos(startPos),
     m_currentDirection(0, 0),
-    m_isMoving(false),
-    m_moveProgress(0.f),
     m_baseSpeed(moveSpeed),
     m_isBlinking(false),  // initialize blinking flag
     m_homeTile(startPos)
 {
-    m_moveSpeed = m_baseSpeed;
-
-    // initialize frightened timer & blink thresholds
-    m_frightenedTotal = sf::seconds(8.f);
-    m_blinkThreshold = sf::seconds(6.f);
-    m_frightenedElapsed = sf::Time::Zero;
+    m_mover.setSpeed(TileMover::speedPerTick(m_baseSpeed));
 
     // define universal frightened/white frames
     int y = 13 + 14 * 4;
@@ -37,16 +35,17 @@ Ghost::Ghost(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int le
         sf::IntRect(28, y, 14, 14),
         sf::IntRect(42, y, 14, 14),
     };
+    // near the end of frightened mode the blue frames alternate with the white
+    m_framesFrightenedBlink = m_framesFrightened;
+    m_framesFrightenedBlink.insert(m_framesFrightenedBlink.end(), m_framesBlink.begin(), m_framesBlink.end());
 
     // eyes frames to be set elsewhere
+}
 
-    // center animation at spawn tile
-    sf::Vector2f offset(
-        static_cast<float>(m_tileSize.x) / 2.f + m_mapPos.x,
-        static_cast<float>(m_tileSize.y) / 2.f + m_mapPos.y);
-    m_animation.setPosition(
-        static_cast<float>(m_pos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-        static_cast<float>(m_pos.y) * static_cast<float>(m_tileSize.y) + offset.y);
+Ghost::~Ghost() {
+    if (m_mode == Mode::Frightened) {
+        --s_frightenedCount;
+    }
 }
 
 void Ghost::setMode(Mode mode, bool forceImmediate) {
@@ -58,18 +57,29 @@ void Ghost::setMode(Mode mode, bool forceImmediate) {
         return;
     }
 
+    // the blue loop starts with the first frightened ghost and ends with the last
+    if (mode == Mode::Frightened && m_mode != Mode::Frightened) {
+        ++s_frightenedCount;
+        AudioEngine::instance().loop(Sound::Frightened);
+    }
+    else if (mode != Mode::Frightened && m_mode == Mode::Frightened && --s_frightenedCount == 0) {
+        AudioEngine::instance().loop(Sound::Siren);
+    }
+
     m_mode = mode;
     float multiplier = 1.0f;
     switch (mode) {
     case Mode::Scatter:
     case Mode::Chase:
-        m_animation.stop();
-        initAnimation();
-        m_animation.setup();
-        m_animation.play();
+        // back to the normal body frames for the way it is heading; the sprite,
+        // texture and frame sets built by initAnimation() stay as they are
+        m_animation.setScale(
+            std::abs(m_animation.getScale().x),
+            m_animation.getScale().y
+        );
+        updateRotation();
         break;
     case Mode::Frightened:
-        m_frightenedElapsed = sf::Time::Zero;
         m_isBlinking = false;
         m_animation.setScale(
             std::abs(m_animation.getScale().x),
@@ -94,114 +104,81 @@ void Ghost::setMode(Mode mode, bool forceImmediate) {
         break;
     }
 
-    sf::Vector2f offset(
-        static_cast<float>(m_tileSize.x) / 2.f + m_mapPos.x,
-        static_cast<float>(m_tileSize.y) / 2.f + m_mapPos.y);
-    m_animation.setPosition(
-        static_cast<float>(m_pos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-        static_cast<float>(m_pos.y) * static_cast<float>(m_tileSize.y) + offset.y);
-
     switch (mode) {
     case Mode::Chase:
     case Mode::Scatter:
-        if (m_level == 1) {
-            multiplier = 0.75f;
-        }
-        else if (m_level <= 4) {
-            multiplier = 0.85f;
-        }
-        else {
-            multiplier = 0.95f;
-        }
+        multiplier = m_params.ghostSpeed;
         break;
     case Mode::Frightened:
-        if (m_level == 1) {
-            multiplier = 0.5f;
-        }
-        else if (m_level <= 4) {
-            multiplier = 0.55f;
-        }
-        else {
-            multiplier = 0.6f;
-        }
+        multiplier = m_params.ghostFrightenedSpeed;
         break;
     case Mode::Eaten:
-        multiplier = 2.0f;
+        multiplier = m_params.ghostEatenSpeed;
         break;
     }
-    m_moveSpeed = m_baseSpeed * multiplier;
+    m_mover.setSpeed(TileMover::speedPerTick(m_baseSpeed * multiplier));
 }
 
-void Ghost::update(sf::Time dt, const sf::Vector2i& targetTile) {
-    m_animation.update(dt);
-
-    // mode transitions
-    if (m_mode == Mode::Frightened) {
-        m_frightenedElapsed += dt;
-        if (m_frightenedElapsed >= m_frightenedTotal) {
-            setMode(m_queuedMode, true);
-        }
-        else if (!m_isBlinking && m_frightenedElapsed >= m_blinkThreshold) {
-            m_isBlinking = true;
-
-            // combine blue and blink frames
-            std::vector<sf::IntRect> blinkAnim;
-            blinkAnim.reserve(
-                m_framesFrightened.size() + m_framesBlink.size());
-            blinkAnim.insert(
-                blinkAnim.end(),
-                m_framesFrightened.begin(), m_framesFrightened.end());
-            blinkAnim.insert(
-                blinkAnim.end(),
-                m_framesBlink.begin(), m_framesBlink.end());
+void Ghost::startBlinking() {
+    if (m_mode != Mode::Frightened || m_isBlinking) {
+        return;
+    }
+    m_isBlinking = true;
 
-            m_animation.stop();
-            m_animation.setFrames(blinkAnim);
-            m_animation.setup();
-            m_animation.play();
+    m_animation.stop();
+    m_animation.setFrames(m_framesFrightenedBlink);
+    m_animation.setup();
+    m_animation.play();
+}
 
-            sf::Vector2f blinkOffset(
-                static_cast<float>(m_tileSize.x) / 2.f + m_mapPos.x,
-                static_cast<float>(m_tileSize.y) / 2.f + m_mapPos.y);
-            m_animation.setPosition(
-                static_cast<float>(m_pos.x) * static_cast<float>(m_tileSize.x) + blinkOffset.x,
-                static_cast<float>(m_pos.y) * static_cast<float>(m_tileSize.y) + blinkOffset.y);
-        }
+void Ghost::endFrightened() {
+    if (m_mode == Mode::Frightened) {
+        setMode(m_queuedMode, true);
     }
+}
+
+void Ghost::update(sf::Time dt, const sf::Vector2i& targetTile) {
+    m_animation.update(dt);
 
-    if (m_mode == Mode::Eaten && !m_isMoving && m_pos == m_homeTile) {
+    sf::Vector2i pos = m_mover.tile();
+    if (m_mode == Mode::Eaten && !m_mover.moving() && pos == m_homeTile) {
         setMode(m_queuedMode, true);
     }
 
-    // decide mapping for tunnel warp
-    sf::Vector2i localTarget = targetTile;
-    if (!m_mapVector.empty()
-        && m_pos.y >= 0
-        && m_pos.y < static_cast<int>(m_mapVector.size())
-        && m_pos.x >= 0
-        && m_pos.x < static_cast<int>(m_mapVector[static_cast<std::size_t>(m_pos.y)].size())
-        && m_mapVector[static_cast<std::size_t>(m_pos.y)][static_cast<std::size_t>(m_pos.x)] == 4)
-    {
-        localTarget = { 14, 0 };
-    }
-    if (m_mode == Mode::Eaten) {
-        localTarget = m_homeTile;
-    }
+    // movement decision; between tiles there is nothing to decide, only the step
+    if (!m_mover.moving()) {
+        // decide mapping for tunnel warp
+        sf::Vector2i localTarget = targetTile;
+        if (!m_mapVector.empty()
+            && pos.y >= 0
+            && pos.y < static_cast<int>(m_mapVector.size())
+            && pos.x >= 0
+            && pos.x < static_cast<int>(m_mapVector[static_cast<std::size_t>(pos.y)].size())
+            && m_mapVector[static_cast<std::size_t>(pos.y)][static_cast<std::size_t>(pos.x)] == 4)
+        {
+            localTarget = m_homeExit;
+        }
+        if (m_mode == Mode::Eaten) {
+            localTarget = m_homeTile;
+        }
 
-    // movement decision
-    if (!m_isMoving) {
-        std::vector<sf::Vector2i> dirs = { {0, -1}, {-1, 0}, {0, 1}, {1, 0} };
-        if (m_currentDirection != sf::Vector2i{ 0, 0 }) {
-            dirs.erase(
-                std::remove(dirs.begin(), dirs.end(), -m_currentDirection),
-                dirs.end());
+        // every direction but back the way it came, in a fixed array so a
+        // decision does not allocate
+        const sf::Vector2i reverse = -m_currentDirection;
+        std::array<sf::Vector2i, 4> dirs;
+        std::size_t dirCount = 0;
+        for (const sf::Vector2i& d : { sf::Vector2i{ 0, -1 }, sf::Vector2i{ -1, 0 }, sf::Vector2i{ 0, 1 }, sf::Vector2i{ 1, 0 } }) {
+            if (d != reverse) {
+                dirs[dirCount++] = d;
+            }
         }
 
         sf::Vector2i bestDir{ 0, 0 };
         if (m_mode == Mode::Frightened) {
-            std::shuffle(dirs.begin(), dirs.end(), m_randEngine);
-            for (auto& d : dirs) {
-                sf::Vector2i cand = m_pos + d;
+            std::shuffle(dirs.begin(), dirs.begin() + dirCount, m_randEngine);
+            for (std::size_t i = 0; i < dirCount; ++i) {
+                const sf::Vector2i& d = dirs[i];
+                sf::Vector2i cand = pos + d;
                 if (isValidMove(cand)) {
                     bestDir = d;
                     break;
@@ -209,58 +186,65 @@ void Ghost::update(sf::Time dt, const sf::Vector2i& targetTile) {
             }
         }
         else {
-            int bestDist = std::numeric_limits<int>::max();
-            for (auto& d : dirs) {
-                if (d == sf::Vector2i{ 0, -1 } && m_pos.y == 23 && m_pos.x >= 10 && m_pos.x <= 16) {
-                    continue;
+            // open exits as a mask, then the same closest-to-target rule crowds batch
+            unsigned exits = 0;
+            for (int i = 0; i < 4; ++i) {
+                sf::Vector2i d = GhostDecisions::direction(i);
+                if (d == reverse) {
+                    continue;   // no reversing
                 }
-                sf::Vector2i cand = m_pos + d;
-                if (!isValidMove(cand)) {
+                if (m_arcadeZones && i == GhostDecisions::UP && pos.y == 23 && pos.x >= 10 && pos.x <= 16) {
                     continue;
                 }
-                int dx = cand.x - localTarget.x;
-                int dy = cand.y - localTarget.y;
-                int dist2 = dx * dx + dy * dy;
-                if (dist2 < bestDist) {
-                    bestDist = dist2;
-                    bestDir = d;
+                sf::Vector2i cand = pos + d;
+                if (isValidMove(cand)) {
+                    exits |= 1u << i;
                 }
             }
+            std::uint8_t exit = GhostDecisions::choose(pos, localTarget, exits);
+            if (exit != GhostDecisions::NONE) {
+                bestDir = GhostDecisions::direction(exit);
+            }
         }
         if (bestDir != sf::Vector2i{ 0, 0 }) {
             m_currentDirection = bestDir;
-            m_nextPos = m_pos + bestDir;
-            m_isMoving = true;
-            m_moveProgress = 0.f;
+            m_mover.start(bestDir);
             updateRotation();
         }
-    }
-
-    // movement interpolation + snapping
-    sf::Vector2f offset(
-        static_cast<float>(m_tileSize.x) / 2.f + m_mapPos.x,
-        static_cast<float>(m_tileSize.y) / 2.f + m_mapPos.y);
-    if (m_isMoving) {
-        m_moveProgress += m_moveSpeed * dt.asSeconds();
-        if (m_moveProgress >= 1.f) {
-            m_pos = m_nextPos;
-            m_moveProgress = 0.f;
-            m_isMoving = false;
+        else {
+            m_mover.halt();
         }
-        sf::Vector2f start(
-            static_cast<float>(m_pos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-            static_cast<float>(m_pos.y) * static_cast<float>(m_tileSize.y) + offset.y);
-        sf::Vector2f end(
-            static_cast<float>(m_nextPos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-            static_cast<float>(m_nextPos.y) * static_cast<float>(m_tileSize.y) + offset.y);
-        sf::Vector2f interp = start + (end - start) * m_moveProgress;
-        m_animation.setPosition(interp);
-    }
-    else {
-        m_animation.setPosition(sf::Vector2f(
-            static_cast<float>(m_pos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-            static_cast<float>(m_pos.y) * static_cast<float>(m_tileSize.y) + offset.y));
     }
+
+    m_mover.step();
+}
+
+sf::Vector2f Ghost::pixelPosition() const {
+    // sprites are centred in their tile
+    sf::Vector2f tileSize(m_tileSize);
+    return m_mover.pixel(m_mapPos + tileSize / 2.f, tileSize);
+}
+
+void Ghost::renderTargetCross(FrameSnapshot& frame, const sf::Color& color) const {
+    sf::Vector2f tileSize(m_tileSize);
+    sf::Vector2f tileCenter(
+        static_cast<float>(m_targetTile.x) * tileSize.x + tileSize.x / 2.f + m_mapPos.x,
+        static_cast<float>(m_targetTile.y) * tileSize.y + tileSize.y / 2.f + m_mapPos.y
+    );
+
+    // two 4-pixel strokes at 45 degrees, 60% of a tile long
+    const float halfSpan = 0.3f * std::min(tileSize.x, tileSize.y);
+    const float thickness = 4.f;
+    const float arm = halfSpan * 0.70710678f;
+    frame.addLine(tileCenter - sf::Vector2f(arm, arm), tileCenter + sf::Vector2f(arm, arm), thickness, color);
+    frame.addLine(tileCenter - sf::Vector2f(arm, -arm), tileCenter + sf::Vector2f(arm, -arm), thickness, color);
+}
+
+sf::FloatRect Ghost::getHitBox() const {
+    // the sprite's origin is its centre, so the bounds sit around the mover's pixel
+    sf::FloatRect bounds = m_animation.getGlobalBounds();
+    sf::Vector2f centre = pixelPosition();
+    return sf::FloatRect(centre.x - bounds.width / 2.f, centre.y - bounds.height / 2.f, bounds.width, bounds.height);
 }
 
 bool Ghost::isValidMove(sf::Vector2i& candidate) const {
@@ -273,7 +257,12 @@ bool Ghost::isValidMove(sf::Vector2i& candidate) const {
         return false;
     }
     int mapWidth = static_cast<int>(m_mapVector[0].size());
-    if (candidate.y == 14
+    // ghosts do not wrap, so they keep out of tunnel mouths on the maze's edges
+    if (candidate.x == 0 || candidate.x == mapWidth - 1) {
+        return false;
+    }
+    if (m_arcadeZones
+        && candidate.y == 14
         && (candidate.x == 5 || candidate.x == mapWidth - 6)) {
         return false;
     }
@@ -286,7 +275,7 @@ bool Ghost::isValidMove(sf::Vector2i& candidate) const {
             // allow leaving home
         }
         else if (
-            m_mapVector[static_cast<std::size_t>(m_pos.y)][static_cast<std::size_t>(m_pos.x)] != 4) {
+            m_mapVector[static_cast<std::size_t>(m_mover.tile().y)][static_cast<std::size_t>(m_mover.tile().x)] != 4) {
             return false;
         }
     }
@@ -317,6 +306,9 @@ void Ghost::updateRotation() {
         frames = &m_framesRight;
         m_animation.setScale(-curX, curY);
     }
+    else {
+        frames = &m_framesRight;   // not moving yet
+    }
 
     if (frames && !frames->empty()) {
         m_animation.stop();
@@ -3,6 +3,11 @@
 
 #include "SFML/Graphics.hpp"
 #include "AnimatedSprite.h"
+#include "GhostTargeting.h"
+#include "LevelParams.h"
+#include "MazeLayout.h"
+#include "TileMover.h"
+#include <cstdint>
 #include <random>
 
 class Ghost
@@ -12,7 +17,7 @@ public:
      * @brief Construct a new Ghost object
      * 
      * @param startPos startposition of the ghost
-     * @param moveSpeed speed of the ghost
+     * @param moveSpeed Pac-Man's normal speed in tiles per second; mode speeds scale it
      * @param mapPos position of the ghost on the map
      * @param level current level of the game
      */
@@ -23,7 +28,7 @@ public:
      * @brief Destroy the Ghost object
      * 
      */
-    virtual ~Ghost() = default;
+    virtual ~Ghost();
 
     /**
      * @brief enum class for the different modes of the ghost
@@ -46,13 +51,56 @@ public:
     void setMode(Mode m, bool forceImmediate = false);
 
     /**
-     * @brief update the ghosts position based on the target tile
+     * @brief move the ghost one simulation tick towards the target tile
      * 
-     * @param dt delta time
+     * @param dt length of the tick, for animation
      * @param targetTile tile ghost targets
      */
     void update(sf::Time dt, const sf::Vector2i& targetTile);
 
+    /**
+     * @brief flash white as frightened mode runs out; nothing unless frightened
+     * @details Called by the state's blink timer, which the energizer started.
+     */
+    void startBlinking();
+
+    /**
+     * @brief go back to the scatter or chase mode queued behind frightened mode
+     * @details Called by the state's frightened timer; nothing unless frightened.
+     */
+    void endFrightened();
+
+    /**
+     * @brief choose this tick's target tile with a targeting policy
+     * @details Scatter mode heads for the policy's corner, every other mode uses its
+     * chase target; frightened and eaten ghosts override it in update().
+     * 
+     * @tparam Policy one of the Targeting policies
+     * @param ctx shared targeting context for this tick
+     * @return sf::Vector2i the target tile, also kept for debug drawing
+     */
+    template <class Policy>
+    sf::Vector2i aim(const TargetContext& ctx)
+    {
+        m_targetTile = m_mode == Mode::Scatter ? Policy::scatter(ctx) : Policy::chase(ctx, m_mover.tile());
+        m_playerTile = ctx.playerTile;
+        return m_targetTile;
+    }
+
+    /**
+     * @brief Toggles debug mode.
+     * @details If debug mode is enabled, the ghost's target is drawn with it.
+     */
+    void toggleDebug() { m_debug = !m_debug; }
+
+    /**
+     * @brief Seed the random frightened movement of every ghost
+     * @details Seeded from the system otherwise; a fixed seed makes runs repeatable.
+     * 
+     * @param value seed
+     */
+    static void seed(std::uint32_t value) { m_randEngine.seed(value); }
+
     /**
      * @brief Set the Map object
      * 
@@ -60,12 +108,20 @@ public:
      */
     void setMap(const std::vector<std::vector<int>>& map) { m_mapVector = map; }
 
+    /**
+     * @brief fit the house exit and the arcade map's special tiles to another maze
+     * 
+     * @param homeExit tile a ghost in the house aims for to get out
+     * @param arcadeZones whether the arcade map's no-up tiles and tunnel limits apply
+     */
+    void setMazeRules(sf::Vector2i homeExit, bool arcadeZones) { m_homeExit = homeExit; m_arcadeZones = arcadeZones; }
+
     /**
      * @brief Get the Pos of ghost
      * 
      * @return sf::Vector2i position of the ghost
      */
-    sf::Vector2i getPos() const { return m_pos; }
+    sf::Vector2i getPos() const { return m_mover.tile(); }
 
     /**
      * @brief Get the Mode object
@@ -79,7 +135,7 @@ public:
      * 
      * @return sf::FloatRect 
      */
-    sf::FloatRect getHitBox() const { return m_animation.getGlobalBounds(); }
+    sf::FloatRect getHitBox() const;
 
 protected:
 
@@ -104,25 +160,39 @@ protected:
      */
     void updateRotation();
 
+    /**
+     * @brief where the sprite's centre is drawn, from the mover's tile and progress
+     * 
+     * @return sf::Vector2f pixel position in layout coordinates
+     */
+    sf::Vector2f pixelPosition() const;
+
+    /**
+     * @brief record the debug "X" on the target tile
+     * 
+     * @param frame snapshot to record into
+     * @param color the ghost's colour, semi-transparent
+     */
+    void renderTargetCross(FrameSnapshot& frame, const sf::Color& color) const;
+
     AnimatedSprite m_animation;
-    const sf::Vector2i m_tileSize{ 24, 24 };
+    const sf::Vector2i m_tileSize{ MazeLayout::TILE_SIZE, MazeLayout::TILE_SIZE };
     std::vector<std::vector<int>> m_mapVector;
 
     int m_level;
+    const LevelParams& m_params;   // speeds and frightened timing for this level
 
-    sf::Vector2i m_pos;
+    TileMover m_mover;             // current tile and progress towards the next
     sf::Vector2f m_mapPos;
-    sf::Vector2i m_nextPos;
     sf::Vector2i m_currentDirection;
 
-    bool m_isMoving;
-    float m_moveProgress;
-    float m_moveSpeed;
     float m_baseSpeed;
 
     Mode m_mode = Mode::Scatter;
     Mode m_queuedMode = Mode::Scatter;
-    sf::Vector2i m_scatterTarget = { 0,0 };
+    sf::Vector2i m_targetTile = { 0,0 };   // last tile aim() chose
+    sf::Vector2i m_playerTile = { 0,0 };   // Pac-Man's tile at that moment
+    bool m_debug = false;
 
     std::vector<sf::IntRect> m_framesUp;
     std::vector<sf::IntRect> m_framesRight;
@@ -131,19 +201,21 @@ protected:
 
     std::vector<sf::IntRect> m_framesFrightened;   // blue animation frames
     std::vector<sf::IntRect> m_framesBlink;
+    std::vector<sf::IntRect> m_framesFrightenedBlink;   // blue then white, for the end of frightened mode
     std::vector<sf::IntRect> m_framesEyes;         // (unused for now)
 
-    // timing for Frightened mode
-    sf::Time m_frightenedTotal;    // total blue duration
-    sf::Time m_frightenedElapsed;  // elapsed time in frightened
-    sf::Time m_blinkThreshold;     // when to switch to blink
-    bool m_isBlinking;
+    bool m_isBlinking;   // showing the blue and white frames of a fright running out
 
     // home tile for Eaten mode
     sf::Vector2i m_homeTile{ 14,14 };
+    sf::Vector2i m_homeExit{ 14,0 };   // aimed for while in the house
+    bool m_arcadeZones = true;          // the arcade map's no-up tiles and tunnel limits
 
     // RNG for random frightened movement
     static std::mt19937 m_randEngine;
+
+    // ghosts currently frightened; the blue loop plays while any are
+    static int s_frightenedCount;
 };
 
 #endif // GHOST_H
@@ -0,0 +1,164 @@
+#include "GhostDecisions.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GHOSTDECISIONS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace GhostDecisions {
+
+namespace {
+
+// the exits' steps as separate x and y rows, for the vector paths
+constexpr std::int32_t STEP_X[4] = { 0, -1, 0, 1 };
+constexpr std::int32_t STEP_Y[4] = { -1, 0, 1, 0 };
+
+void chooseScalar(Batch& b, std::size_t from)
+{
+    for (std::size_t i = from; i < b.size(); ++i) {
+        b.choice[i] = choose(sf::Vector2i(b.tileX[i], b.tileY[i]),
+            sf::Vector2i(b.targetX[i], b.targetY[i]), b.exits[i]);
+    }
+}
+
+#ifdef GHOSTDECISIONS_X86
+
+// Each lane is one ghost. Candidates are tried in exit order and only a strictly
+// smaller distance replaces the best so far, which is the scalar tie-break.
+
+__attribute__((target("avx2")))
+inline void decide8(Batch& b, std::size_t i)
+{
+    __m256i dx = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.tileX[i])),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.targetX[i])));
+    __m256i dy = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.tileY[i])),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.targetY[i])));
+    __m256i exits = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&b.exits[i])));
+
+    __m256i best = _mm256_set1_epi32(INT_MAX);
+    __m256i pick = _mm256_set1_epi32(NONE);
+    for (int c = 0; c < 4; ++c) {
+        __m256i cx = _mm256_add_epi32(dx, _mm256_set1_epi32(STEP_X[c]));
+        __m256i cy = _mm256_add_epi32(dy, _mm256_set1_epi32(STEP_Y[c]));
+        __m256i dist = _mm256_add_epi32(_mm256_mullo_epi32(cx, cx), _mm256_mullo_epi32(cy, cy));
+        __m256i bit = _mm256_set1_epi32(1 << c);
+        __m256i open = _mm256_cmpeq_epi32(_mm256_and_si256(exits, bit), bit);
+        __m256i better = _mm256_and_si256(open, _mm256_cmpgt_epi32(best, dist));
+        best = _mm256_blendv_epi8(best, dist, better);
+        pick = _mm256_blendv_epi8(pick, _mm256_set1_epi32(c), better);
+    }
+
+    alignas(32) std::int32_t out[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(out), pick);
+    for (int lane = 0; lane < 8; ++lane)
+        b.choice[i + static_cast<std::size_t>(lane)] = static_cast<std::uint8_t>(out[lane]);
+}
+
+__attribute__((target("avx2")))
+std::size_t chooseAvx2(Batch& b)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= b.size(); i += 16) {
+        decide8(b, i);
+        decide8(b, i + 8);
+    }
+    return i;
+}
+
+__attribute__((target("sse4.1")))
+inline void decide4(Batch& b, std::size_t i)
+{
+    __m128i dx = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.tileX[i])),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.targetX[i])));
+    __m128i dy = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.tileY[i])),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.targetY[i])));
+    std::int32_t packed;
+    std::memcpy(&packed, &b.exits[i], sizeof(packed));
+    __m128i exits = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+
+    __m128i best = _mm_set1_epi32(INT_MAX);
+    __m128i pick = _mm_set1_epi32(NONE);
+    for (int c = 0; c < 4; ++c) {
+        __m128i cx = _mm_add_epi32(dx, _mm_set1_epi32(STEP_X[c]));
+        __m128i cy = _mm_add_epi32(dy, _mm_set1_epi32(STEP_Y[c]));
+        __m128i dist = _mm_add_epi32(_mm_mullo_epi32(cx, cx), _mm_mullo_epi32(cy, cy));
+        __m128i bit = _mm_set1_epi32(1 << c);
+        __m128i open = _mm_cmpeq_epi32(_mm_and_si128(exits, bit), bit);
+        __m128i better = _mm_and_si128(open, _mm_cmpgt_epi32(best, dist));
+        best = _mm_blendv_epi8(best, dist, better);
+        pick = _mm_blendv_epi8(pick, _mm_set1_epi32(c), better);
+    }
+
+    alignas(16) std::int32_t out[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(out), pick);
+    for (int lane = 0; lane < 4; ++lane)
+        b.choice[i + static_cast<std::size_t>(lane)] = static_cast<std::uint8_t>(out[lane]);
+}
+
+__attribute__((target("sse4.1")))
+std::size_t chooseSse41(Batch& b)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= b.size(); i += 8) {
+        decide4(b, i);
+        decide4(b, i + 4);
+    }
+    return i;
+}
+
+#endif // GHOSTDECISIONS_X86
+
+} // namespace
+
+void Batch::resize(std::size_t count)
+{
+    tileX.resize(count);
+    tileY.resize(count);
+    targetX.resize(count);
+    targetY.resize(count);
+    exits.resize(count);
+    choice.resize(count);
+}
+
+Isa bestIsa()
+{
+#ifdef GHOSTDECISIONS_X86
+    static const Isa detected = __builtin_cpu_supports("avx2") ? Isa::Avx2
+        : __builtin_cpu_supports("sse4.1") ? Isa::Sse41
+        : Isa::Scalar;
+    return detected;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+const char* isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Avx2: return "AVX2";
+    case Isa::Sse41: return "SSE4.1";
+    case Isa::Scalar: break;
+    }
+    return "scalar";
+}
+
+void chooseAll(Batch& batch, Isa isa)
+{
+    // never run an instruction set the CPU lacks
+    if (static_cast<int>(isa) > static_cast<int>(bestIsa()))
+        isa = bestIsa();
+
+    std::size_t done = 0;
+#ifdef GHOSTDECISIONS_X86
+    if (isa == Isa::Avx2)
+        done = chooseAvx2(batch);
+    else if (isa == Isa::Sse41)
+        done = chooseSse41(batch);
+#endif
+    // the tail, or everything without a vector unit
+    chooseScalar(batch, done);
+}
+
+} // namespace GhostDecisions
@@ -0,0 +1,99 @@
+#ifndef GHOSTDECISIONS_H
+#define GHOSTDECISIONS_H
+
+#include <SFML/System/Vector2.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief the ghosts' choice of exit at a tile centre, one at a time or in batches
+ * @details A ghost that is not frightened takes the open exit whose next tile is
+ * closest to its target, by squared distance; on a tie the first exit in the order
+ * up, left, down, right wins. choose() is that rule for one ghost and is what
+ * Ghost::update uses. chooseAll() applies it to a whole batch with AVX2 (16 ghosts
+ * per iteration) or SSE4.1 (8) when the CPU has them, and plain C++ otherwise; every
+ * path gives the same answers as choose(). Tiles and targets must be within 32000
+ * tiles of each other so a squared distance fits in an int.
+ */
+namespace GhostDecisions {
+
+// exit order, which is also the tie-break order
+constexpr int UP = 0, LEFT = 1, DOWN = 2, RIGHT = 3;
+constexpr std::uint8_t NONE = 4;   // no open exit
+
+/**
+ * @brief the step each exit index stands for
+ */
+inline sf::Vector2i direction(int exit)
+{
+    static const sf::Vector2i DIRECTIONS[4] = { { 0, -1 }, { -1, 0 }, { 0, 1 }, { 1, 0 } };
+    return DIRECTIONS[exit];
+}
+
+/**
+ * @brief pick one ghost's exit
+ *
+ * @param tile ghost's current tile
+ * @param target tile it is heading for
+ * @param exits bit i set if exit i is open
+ * @return std::uint8_t exit index, or NONE
+ */
+inline std::uint8_t choose(sf::Vector2i tile, sf::Vector2i target, unsigned exits)
+{
+    std::uint8_t best = NONE;
+    int bestDist = INT_MAX;
+    for (int i = 0; i < 4; ++i) {
+        if (!(exits & (1u << i)))
+            continue;
+        sf::Vector2i d = tile + direction(i) - target;
+        int dist2 = d.x * d.x + d.y * d.y;
+        if (dist2 < bestDist) {
+            bestDist = dist2;
+            best = static_cast<std::uint8_t>(i);
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief many ghosts' decision inputs and results, one array per field
+ */
+struct Batch
+{
+    std::vector<std::int32_t> tileX, tileY;
+    std::vector<std::int32_t> targetX, targetY;
+    std::vector<std::uint8_t> exits;    // open-exit bit masks
+    std::vector<std::uint8_t> choice;   // filled by chooseAll()
+
+    void resize(std::size_t count);
+    std::size_t size() const { return exits.size(); }
+};
+
+/**
+ * @brief instruction sets chooseAll() can run on
+ */
+enum class Isa { Scalar, Sse41, Avx2 };
+
+/**
+ * @brief the widest instruction set this CPU supports, checked once
+ */
+Isa bestIsa();
+
+/**
+ * @brief readable name of an instruction set, for reports
+ */
+const char* isaName(Isa isa);
+
+/**
+ * @brief fill batch.choice for every ghost in the batch
+ *
+ * @param batch inputs; choice is written
+ * @param isa path to use; falls back to a narrower one if the CPU lacks it
+ */
+void chooseAll(Batch& batch, Isa isa = bestIsa());
+
+} // namespace GhostDecisions
+
+#endif // GHOSTDECISIONS_H
@@ -0,0 +1,117 @@
+#ifndef GHOSTSQUAD_H
+#define GHOSTSQUAD_H
+
+#include "GhostTargeting.h"
+
+#include <SFML/System/Time.hpp>
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief every ghost in play, stored by concrete type
+ * @details One container per ghost type, so walking the squad calls each ghost's
+ * own functions directly: no virtual calls, and update() inlines each type's
+ * targeting policy. Ghost types only have to be listed in the squad's type; the
+ * code that drives it does not change when one is added. A deque keeps references
+ * valid as ghosts are spawned.
+ *
+ * @tparam Ghosts Ghost subclasses, each naming its targeting policy as Personality
+ */
+template <class... Ghosts>
+class GhostSquad
+{
+public:
+    /**
+     * @brief add a ghost of type G
+     *
+     * @param args constructor arguments
+     * @return G& the new ghost, valid for the life of the squad
+     */
+    template <class G, class... Args>
+    G& spawn(Args&&... args)
+    {
+        std::deque<G>& list = std::get<std::deque<G>>(m_ghosts);
+        list.emplace_back(std::forward<Args>(args)...);
+        return list.back();
+    }
+
+    /**
+     * @brief the first ghost of type G, or nullptr if there is none
+     */
+    template <class G>
+    const G* first() const
+    {
+        const std::deque<G>& list = std::get<std::deque<G>>(m_ghosts);
+        return list.empty() ? nullptr : &list.front();
+    }
+
+    /**
+     * @brief place of type G in the squad's type list, to tell ghosts apart in logs
+     */
+    template <class G>
+    static constexpr std::uint8_t indexOf()
+    {
+        constexpr bool matches[] = { std::is_same_v<G, Ghosts>... };
+        for (std::uint8_t i = 0; i < sizeof...(Ghosts); ++i) {
+            if (matches[i])
+                return i;
+        }
+        return 0xFF;
+    }
+
+    /**
+     * @brief call fn(ghost) on every ghost, type by type in the squad's order
+     */
+    template <class Fn>
+    void forEach(Fn&& fn)
+    {
+        std::apply([&fn](auto&... lists) {
+            auto each = [&fn](auto& list) {
+                for (auto& ghost : list)
+                    fn(ghost);
+            };
+            (each(lists), ...);
+        }, m_ghosts);
+    }
+
+    /**
+     * @brief call fn(ghost) on ghosts until one returns true
+     * @return true if some ghost's call returned true
+     */
+    template <class Fn>
+    bool any(Fn&& fn)
+    {
+        return std::apply([&fn](auto&... lists) {
+            auto some = [&fn](auto& list) {
+                for (auto& ghost : list) {
+                    if (fn(ghost))
+                        return true;
+                }
+                return false;
+            };
+            return (some(lists) || ...);
+        }, m_ghosts);
+    }
+
+    /**
+     * @brief aim and move every ghost one tick
+     *
+     * @param dt tick length
+     * @param ctx shared targeting context for this tick
+     */
+    void update(sf::Time dt, const TargetContext& ctx)
+    {
+        forEach([dt, &ctx](auto& ghost) {
+            using Policy = typename std::decay_t<decltype(ghost)>::Personality;
+            ghost.update(dt, ghost.template aim<Policy>(ctx));
+        });
+    }
+
+private:
+    std::tuple<std::deque<Ghosts>...> m_ghosts;
+};
+
+#endif // GHOSTSQUAD_H
@@ -0,0 +1,77 @@
+#ifndef GHOSTTARGETING_H
+#define GHOSTTARGETING_H
+
+#include <SFML/System/Vector2.hpp>
+
+/**
+ * @brief everything a ghost personality may look at when choosing its target tile
+ * @details Filled once per tick by the playing state and shared by every ghost.
+ */
+struct TargetContext
+{
+    sf::Vector2i playerTile;
+    sf::Vector2i playerDirection;
+    sf::Vector2i blinkyTile;        // Inky aims relative to Blinky
+    sf::Vector2i mazeSize;          // columns, rows
+};
+
+/**
+ * @brief compile-time targeting policies, one per ghost personality
+ * @details A policy is a type with two static functions: scatter(ctx) names its home
+ * corner, chase(ctx, self) its target while hunting given the ghost's own tile.
+ * Ghost::aim<Policy>() picks between them, so the personality inlines into the
+ * squad's update loop. A new personality is a new policy here plus a Ghost subclass
+ * that names it as its Personality.
+ */
+namespace Targeting {
+
+// Blinky: straight at Pac-Man, from the top-right corner
+struct Shadow
+{
+    static sf::Vector2i scatter(const TargetContext& ctx) { return { ctx.mazeSize.x - 2, 0 }; }
+    static sf::Vector2i chase(const TargetContext& ctx, sf::Vector2i) { return ctx.playerTile; }
+};
+
+// Pinky: four tiles ahead of Pac-Man, with the arcade's up-and-left overflow
+struct Speedy
+{
+    static sf::Vector2i scatter(const TargetContext&) { return { 1, 0 }; }
+    static sf::Vector2i chase(const TargetContext& ctx, sf::Vector2i)
+    {
+        if (ctx.playerDirection.y == -1)
+            return ctx.playerTile + sf::Vector2i(-4, -4);
+        return ctx.playerTile + ctx.playerDirection * 4;
+    }
+};
+
+// Inky: Blinky's vector to two tiles ahead of Pac-Man, doubled
+struct Bashful
+{
+    static sf::Vector2i scatter(const TargetContext& ctx) { return { ctx.mazeSize.x - 2, ctx.mazeSize.y - 1 }; }
+    static sf::Vector2i chase(const TargetContext& ctx, sf::Vector2i)
+    {
+        sf::Vector2i pivot = ctx.playerDirection == sf::Vector2i(0, -1)
+            ? ctx.playerTile + sf::Vector2i(-2, -2)
+            : ctx.playerTile + ctx.playerDirection * 2;
+        return pivot * 2 - ctx.blinkyTile;
+    }
+};
+
+// Clyde: chases from afar, retreats to his corner within eight tiles
+struct Pokey
+{
+    static constexpr int SHY_RADIUS = 8;
+
+    static sf::Vector2i scatter(const TargetContext& ctx) { return { 1, ctx.mazeSize.y - 1 }; }
+    static sf::Vector2i chase(const TargetContext& ctx, sf::Vector2i self)
+    {
+        sf::Vector2i d = ctx.playerTile - self;
+        if (d.x * d.x + d.y * d.y > SHY_RADIUS * SHY_RADIUS)
+            return ctx.playerTile;
+        return scatter(ctx);
+    }
+};
+
+} // namespace Targeting
+
+#endif // GHOSTTARGETING_H
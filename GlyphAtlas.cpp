@@ -0,0 +1,153 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// sf::Text pads each glyph quad by one pixel so smoothing never clips the edge
+constexpr float GLYPH_PADDING = 1.f;
+
+} // namespace
+
+void GlyphAtlas::prewarm(const sf::Font& font, unsigned int characterSize)
+{
+    for (char c = FIRST; c <= LAST; ++c)
+        font.getGlyph(static_cast<sf::Uint32>(c), characterSize, false);
+}
+
+void GlyphAtlas::build(const sf::Font& font, unsigned int characterSize, float unitsPerPixel)
+{
+    prewarm(font, characterSize);
+    const float unit = unitsPerPixel;
+
+    for (char c = FIRST; c <= LAST; ++c) {
+        const sf::Glyph& glyph = font.getGlyph(static_cast<sf::Uint32>(c), characterSize, false);
+        std::size_t index = static_cast<std::size_t>(c - FIRST);
+
+        Entry& e = m_entries[index];
+        e.advance = glyph.advance * unit;
+        e.bounds = sf::FloatRect(glyph.bounds.left * unit, glyph.bounds.top * unit,
+            glyph.bounds.width * unit, glyph.bounds.height * unit);
+        e.source = sf::FloatRect(static_cast<float>(glyph.textureRect.left) - GLYPH_PADDING,
+            static_cast<float>(glyph.textureRect.top) - GLYPH_PADDING,
+            static_cast<float>(glyph.textureRect.width) + 2.f * GLYPH_PADDING,
+            static_cast<float>(glyph.textureRect.height) + 2.f * GLYPH_PADDING);
+    }
+
+    // every glyph is on the page now, so the texture reference stays valid
+    m_texture = &font.getTexture(characterSize);
+    m_characterSize = static_cast<float>(characterSize) * unit;
+    m_lineSpacing = font.getLineSpacing(characterSize) * unit;
+    m_unitsPerPixel = unit;
+}
+
+const GlyphAtlas::Entry* GlyphAtlas::entry(char c) const
+{
+    if (c < FIRST || c > LAST)
+        return nullptr;
+    return &m_entries[static_cast<std::size_t>(c - FIRST)];
+}
+
+sf::FloatRect GlyphAtlas::bounds(const char* text, std::size_t length) const
+{
+    float minX = m_characterSize, minY = m_characterSize;
+    float maxX = 0.f, maxY = 0.f;
+    float x = 0.f, y = m_characterSize;
+    bool any = false;
+
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (c == '\n') {
+            x = 0.f;
+            y += m_lineSpacing;
+            continue;
+        }
+        const Entry* e = entry(c);
+        if (!e)
+            continue;
+
+        // whitespace only moves the pen, like in sf::Text
+        if (c != ' ') {
+            const sf::FloatRect& ink = e->bounds;
+            minX = std::min(minX, x + ink.left);
+            maxX = std::max(maxX, x + ink.left + ink.width);
+            minY = std::min(minY, y + ink.top);
+            maxY = std::max(maxY, y + ink.top + ink.height);
+            any = true;
+        }
+        x += e->advance;
+    }
+
+    if (!any)
+        return sf::FloatRect();
+    return sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+template <typename Emit>
+void GlyphAtlas::layout(const char* text, std::size_t length, sf::Vector2f position, float scale, Emit emit) const
+{
+    float x = 0.f, y = m_characterSize;
+    const float padding = GLYPH_PADDING * m_unitsPerPixel;
+
+    // glyph bounds are whole texture pixels from the pen, so a pen on the pixel grid
+    // puts every texel on one target pixel
+    position.x = std::round(position.x / m_unitsPerPixel) * m_unitsPerPixel;
+    position.y = std::round(position.y / m_unitsPerPixel) * m_unitsPerPixel;
+
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (c == '\n') {
+            x = 0.f;
+            y += m_lineSpacing;
+            continue;
+        }
+        const Entry* e = entry(c);
+        if (!e)
+            continue;
+
+        if (c != ' ') {
+            sf::FloatRect dest(position.x + (x + e->bounds.left - padding) * scale,
+                position.y + (y + e->bounds.top - padding) * scale,
+                (e->bounds.width + 2.f * padding) * scale,
+                (e->bounds.height + 2.f * padding) * scale);
+            emit(dest, e->source);
+        }
+        x += e->advance;
+    }
+}
+
+void GlyphAtlas::append(SpriteBatch& batch, const char* text, std::size_t length,
+    sf::Vector2f position, float scale, const sf::Color& color) const
+{
+    layout(text, length, position, scale, [&](const sf::FloatRect& dest, const sf::FloatRect& source) {
+        batch.addQuad(dest, source, color);
+    });
+}
+
+void GlyphAtlas::append(FrameSnapshot& frame, const char* text, std::size_t length,
+    sf::Vector2f position, float scale, const sf::Color& color) const
+{
+    layout(text, length, position, scale, [&](const sf::FloatRect& dest, const sf::FloatRect& source) {
+        frame.addQuad(m_texture, dest, source, color);
+    });
+}
+
+std::size_t GlyphAtlas::formatInt(int value, char* out)
+{
+    // digits come out backwards; work in unsigned so INT_MIN is safe
+    char digits[10];
+    std::size_t count = 0;
+    unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    std::size_t written = 0;
+    if (value < 0)
+        out[written++] = '-';
+    while (count > 0)
+        out[written++] = digits[--count];
+    return written;
+}
@@ -0,0 +1,118 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include "FrameSnapshot.h"
+#include "SpriteBatch.h"
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief printable ASCII of one font at one size, rasterized up front
+ * @details build() asks the font for every glyph once, so they all land on the
+ * font's page texture at load time instead of mid-game. Text is then emitted as
+ * quads into a SpriteBatch or a FrameSnapshot from plain character buffers, with
+ * the same layout sf::Text would give (first baseline one character size below the
+ * position, font line spacing between lines, no kerning). The glyphs can be
+ * rasterized smaller than the units text is laid out in: metrics are reported in
+ * layout units, and each texture pixel is drawn over unitsPerPixel of them, with
+ * the pen snapped to that grid so texels land on whole target pixels.
+ */
+class GlyphAtlas
+{
+public:
+    /**
+     * @brief rasterize printable ASCII so later sf::Text use at this size never stalls
+     *
+     * @param font font to warm up
+     * @param characterSize size in pixels
+     */
+    static void prewarm(const sf::Font& font, unsigned int characterSize);
+
+    /**
+     * @brief cache the glyph metrics of a font at one size
+     * @details The font must outlive the atlas.
+     *
+     * @param font loaded font
+     * @param characterSize size in texture pixels
+     * @param unitsPerPixel layout units one texture pixel covers when drawn
+     */
+    void build(const sf::Font& font, unsigned int characterSize, float unitsPerPixel = 1.f);
+
+    /**
+     * @brief the page texture the glyph quads sample
+     *
+     * @return const sf::Texture* texture, nullptr before build()
+     */
+    const sf::Texture* texture() const { return m_texture; }
+
+    /**
+     * @brief local bounds of a block of text, as sf::Text::getLocalBounds() reports them
+     *
+     * @param text characters, '\n' starts a new line
+     * @param length number of characters
+     * @return sf::FloatRect bounds relative to the text position
+     */
+    sf::FloatRect bounds(const char* text, std::size_t length) const;
+
+    /**
+     * @brief emit a block of text into a batch
+     *
+     * @param batch batch to append to
+     * @param text characters, '\n' starts a new line
+     * @param length number of characters
+     * @param position where sf::Text would be placed
+     * @param scale uniform scale applied around the position
+     * @param color fill colour
+     */
+    void append(SpriteBatch& batch, const char* text, std::size_t length,
+        sf::Vector2f position, float scale, const sf::Color& color) const;
+
+    /**
+     * @brief record a block of text into a frame snapshot
+     *
+     * @param frame snapshot to record into
+     * @param text characters, '\n' starts a new line
+     * @param length number of characters
+     * @param position where sf::Text would be placed
+     * @param scale uniform scale applied around the position
+     * @param color fill colour
+     */
+    void append(FrameSnapshot& frame, const char* text, std::size_t length,
+        sf::Vector2f position, float scale, const sf::Color& color) const;
+
+    /**
+     * @brief write an integer into a caller buffer without allocating
+     *
+     * @param value number to format
+     * @param out buffer, large enough for any int
+     * @return std::size_t characters written
+     */
+    static std::size_t formatInt(int value, char* out);
+
+private:
+    struct Entry
+    {
+        sf::FloatRect bounds;   // ink box relative to the pen on the baseline
+        sf::FloatRect source;   // texture pixels, padding included
+        float advance = 0.f;
+    };
+
+    static constexpr char FIRST = ' ';
+    static constexpr char LAST = '~';
+
+    const Entry* entry(char c) const;
+
+    // calls emit(dest, source) for every visible glyph quad
+    template <typename Emit>
+    void layout(const char* text, std::size_t length, sf::Vector2f position, float scale, Emit emit) const;
+
+    std::array<Entry, LAST - FIRST + 1> m_entries{};
+    const sf::Texture* m_texture = nullptr;
+    float m_characterSize = 0.f;   // this and the metrics above in layout units
+    float m_lineSpacing = 0.f;
+    float m_unitsPerPixel = 1.f;
+};
+
+#endif // GLYPHATLAS_H
@@ -14,7 +14,7 @@ public:
      * @param moveSpeed Speed of Inky
      * @param mapPos Position of the map
      * @param level Current level of the game
-     * @details Initializes Inky's position, speed, and animation. Calls the Ghost constructor to set m_pos, m_moveSpeed, etc.
+     * @details Initializes Inky's position, speed, and animation. Calls the Ghost constructor to set the mover, speed, etc.
      */
     Inky(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int level);
     
@@ -25,27 +25,16 @@ public:
     ~Inky() = default;
 
     /**
-     * @brief Calculates the target tile for Inky based on the player's position and Blinky's position.
-     * @param playerPos Position of the player
-     * @param playerDirection Direction of the player
-     * @param blinkyPos Position of Blinky
-     * @return Target tile for Inky
-     * @details If in Scatter mode, sets target to (26, 0). Otherwise, sets target to a calculated position based on the player's position and Blinky's position.
+     * @brief Targets through Blinky and two tiles ahead of Pac-Man; scatters to the bottom-right corner.
      */
-    sf::Vector2i calculateTarget(sf::Vector2i playerPos, sf::Vector2i playerDirection, sf::Vector2i blinkyPos);
+    using Personality = Targeting::Bashful;
 
     /**
      * @brief renders the animation to the window
      * 
-     * @param window 
+     * @param frame snapshot to record into
      */
-    void render(sf::RenderWindow& window);
-
-    /**
-     * @brief Toggles debug mode.
-     * @details If debug mode is enabled, additional debug information is drawn on the window.
-     */
-    void toggleDebug() { m_debug = !m_debug; }
+    void render(FrameSnapshot& frame);
 
 private:
     /**
@@ -53,10 +42,6 @@ private:
      * @details Loads the texture and sets up the animation frames for Inky.
      */
     void initAnimation();
-    
-    sf::Vector2i m_targetTile;
-    bool m_debug = false;
-
 };
 
 #endif // INKY_H
@@ -0,0 +1,58 @@
+#include "Input.h"
+
+Input::Input()
+{
+    // a vector drained from the front, not a deque: it keeps its storage, so
+    // queueing input never allocates once the game is running
+    m_pending.reserve(RESERVED_EVENTS);
+    m_tickEvents.reserve(RESERVED_EVENTS);
+}
+
+sf::Time Input::now()
+{
+    static sf::Clock clock;
+    return clock.getElapsedTime();
+}
+
+void Input::push(const sf::Event& event, sf::Time time)
+{
+    InputEvent e;
+    e.time = time;
+
+    switch (event.type) {
+    case sf::Event::KeyPressed:
+        e.type = InputEvent::Type::KeyPressed;
+        e.key = event.key.code;
+        break;
+    case sf::Event::KeyReleased:
+        e.type = InputEvent::Type::KeyReleased;
+        e.key = event.key.code;
+        break;
+    case sf::Event::TextEntered:
+        e.type = InputEvent::Type::Text;
+        e.unicode = event.text.unicode;
+        break;
+    default:
+        return;
+    }
+    m_pending.push_back(e);
+}
+
+void Input::beginTick(sf::Time tickEnd)
+{
+    m_tickEvents.clear();
+    auto e = m_pending.begin();
+    for (; e != m_pending.end() && e->time <= tickEnd; ++e)
+        m_tickEvents.push_back(*e);
+    // usually the whole queue; what is left moves up in place
+    m_pending.erase(m_pending.begin(), e);
+}
+
+bool Input::pressed(sf::Keyboard::Key key) const
+{
+    for (const InputEvent& e : m_tickEvents) {
+        if (e.type == InputEvent::Type::KeyPressed && e.key == key)
+            return true;
+    }
+    return false;
+}
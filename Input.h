@@ -0,0 +1,88 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief one keyboard event with the time it was read from the window
+ */
+struct InputEvent
+{
+    enum class Type
+    {
+        KeyPressed,
+        KeyReleased,
+        Text          // a character from TextEntered
+    };
+
+    Type type = Type::KeyPressed;
+    sf::Keyboard::Key key = sf::Keyboard::Unknown;
+    sf::Uint32 unicode = 0;
+    sf::Time time;                // Input::now() when the event was polled
+};
+
+/**
+ * @brief keyboard input, queued from the window's events and handed out per sim tick
+ * @details Game::run feeds every keyboard event from pollEvent() in with a timestamp.
+ * Before each fixed sim tick it calls beginTick() with the tick's end time, which
+ * releases exactly the events that happened up to then; states read them through
+ * the const queries. A state sees a key only as the events released for its tick,
+ * so nothing ever asks the OS for the keyboard.
+ */
+class Input
+{
+public:
+    // events held before either queue has to grow; a tick rarely sees more than a few
+    static constexpr std::size_t RESERVED_EVENTS = 64;
+
+    /**
+     * @brief an empty queue, with room for RESERVED_EVENTS
+     */
+    Input();
+
+    /**
+     * @brief the game clock every input timestamp is taken from
+     *
+     * @return sf::Time time since the first call
+     */
+    static sf::Time now();
+
+    /**
+     * @brief queue a window event; anything that is not keyboard input is ignored
+     *
+     * @param event event from sf::Window::pollEvent
+     * @param time when it was polled
+     */
+    void push(const sf::Event& event, sf::Time time);
+
+    /**
+     * @brief release the events up to the end of the coming tick
+     * @details Events from the previous tick are dropped first.
+     *
+     * @param tickEnd game clock time at the end of the tick
+     */
+    void beginTick(sf::Time tickEnd);
+
+    /**
+     * @brief the events of the current tick, oldest first
+     *
+     * @return const std::vector<InputEvent>& this tick's events
+     */
+    const std::vector<InputEvent>& events() const { return m_tickEvents; }
+
+    /**
+     * @brief whether a key went down during the current tick
+     *
+     * @param key key to check
+     * @return true if a press event for it arrived this tick
+     */
+    bool pressed(sf::Keyboard::Key key) const;
+
+private:
+    std::vector<InputEvent> m_pending;      // polled, waiting for their tick; oldest first
+    std::vector<InputEvent> m_tickEvents;   // released for the current tick
+};
+
+#endif // INPUT_H
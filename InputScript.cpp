@@ -0,0 +1,108 @@
+#include "InputScript.h"
+#include "FileUtils.h"
+
+#include <algorithm>
+
+namespace {
+
+bool parseKey(const std::string& name, sf::Keyboard::Key& key)
+{
+    if (name.size() == 1 && name[0] >= 'A' && name[0] <= 'Z') {
+        key = static_cast<sf::Keyboard::Key>(sf::Keyboard::A + (name[0] - 'A'));
+        return true;
+    }
+    if (name.size() == 4 && name.compare(0, 3, "Num") == 0 && name[3] >= '0' && name[3] <= '9') {
+        key = static_cast<sf::Keyboard::Key>(sf::Keyboard::Num0 + (name[3] - '0'));
+        return true;
+    }
+
+    static const struct { const char* name; sf::Keyboard::Key key; } NAMED[] = {
+        { "Up", sf::Keyboard::Up }, { "Down", sf::Keyboard::Down },
+        { "Left", sf::Keyboard::Left }, { "Right", sf::Keyboard::Right },
+        { "Enter", sf::Keyboard::Enter }, { "Space", sf::Keyboard::Space },
+        { "Escape", sf::Keyboard::Escape }, { "Period", sf::Keyboard::Period },
+        { "BackSpace", sf::Keyboard::BackSpace },
+    };
+    for (const auto& named : NAMED) {
+        if (name == named.name) {
+            key = named.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+// the character a real keyboard would type for a key, or 0
+sf::Uint32 typedChar(sf::Keyboard::Key key)
+{
+    if (key >= sf::Keyboard::A && key <= sf::Keyboard::Z)
+        return static_cast<sf::Uint32>('a' + (key - sf::Keyboard::A));
+    if (key >= sf::Keyboard::Num0 && key <= sf::Keyboard::Num9)
+        return static_cast<sf::Uint32>('0' + (key - sf::Keyboard::Num0));
+    if (key == sf::Keyboard::BackSpace)
+        return '\b';
+    return 0;
+}
+
+} // namespace
+
+bool InputScript::load(const std::string& path)
+{
+    m_steps.clear();
+    m_next = 0;
+    bool read = readLines(path, "input script", [this](std::istream& fields) {
+        long ms = 0;
+        std::string action, keyName;
+        if (!(fields >> ms >> action))
+            return false;
+
+        Step step;
+        step.at = sf::milliseconds(static_cast<sf::Int32>(ms));
+        if (action == "quit") {
+            step.action = Step::Action::Quit;
+        }
+        else if ((action == "press" || action == "release") && fields >> keyName && parseKey(keyName, step.key)) {
+            step.action = action == "press" ? Step::Action::Press : Step::Action::Release;
+        }
+        else {
+            return false;
+        }
+        m_steps.push_back(step);
+        return true;
+    });
+    if (!read) {
+        m_steps.clear();
+        return false;
+    }
+
+    // steps may be written out of order; equal times keep file order
+    std::stable_sort(m_steps.begin(), m_steps.end(),
+        [](const Step& a, const Step& b) { return a.at < b.at; });
+    return true;
+}
+
+bool InputScript::feed(Input& input, sf::Time now)
+{
+    while (m_next < m_steps.size() && m_start + m_steps[m_next].at <= now) {
+        const Step& step = m_steps[m_next++];
+        if (step.action == Step::Action::Quit)
+            return false;
+
+        // stamped like a polled event, at the moment it is injected
+        sf::Event event;
+        event.type = step.action == Step::Action::Press ? sf::Event::KeyPressed : sf::Event::KeyReleased;
+        event.key.code = step.key;
+        event.key.alt = event.key.control = event.key.shift = event.key.system = false;
+        input.push(event, now);
+
+        if (step.action == Step::Action::Press) {
+            if (sf::Uint32 c = typedChar(step.key)) {
+                sf::Event text;
+                text.type = sf::Event::TextEntered;
+                text.text.unicode = c;
+                input.push(text, now);
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef INPUTSCRIPT_H
+#define INPUTSCRIPT_H
+
+#include "Input.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief synthetic keyboard input played back from a text file
+ * @details One step per line, "<ms> press|release <Key>" or "<ms> quit", with the
+ * time measured from the start of Game::run; '#' starts a comment. Keys are named
+ * as in sf::Keyboard (A-Z, Num0-Num9, Up, Down, Left, Right, Enter, Space, Escape,
+ * Period, BackSpace). Pressing a letter or digit also types it, like a real
+ * keyboard does. Used for automated runs such as latency measurements.
+ */
+class InputScript
+{
+public:
+    /**
+     * @brief read a script
+     *
+     * @param path script file
+     * @return true if the file was read and every line parsed
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief whether a script is loaded and not finished
+     *
+     * @return true while steps remain
+     */
+    bool active() const { return m_next < m_steps.size(); }
+
+    /**
+     * @brief set the time step offsets are measured from
+     *
+     * @param now Input::now() at the start of the run
+     */
+    void start(sf::Time now) { m_start = now; }
+
+    /**
+     * @brief queue every step that is due
+     *
+     * @param input queue to feed
+     * @param now current Input::now()
+     * @return false once a quit step is reached
+     */
+    bool feed(Input& input, sf::Time now);
+
+private:
+    struct Step
+    {
+        enum class Action { Press, Release, Quit };
+
+        sf::Time at;
+        Action action = Action::Press;
+        sf::Keyboard::Key key = sf::Keyboard::Unknown;
+    };
+
+    std::vector<Step> m_steps;
+    std::size_t m_next = 0;
+    sf::Time m_start;
+};
+
+#endif // INPUTSCRIPT_H
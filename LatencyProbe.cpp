@@ -0,0 +1,106 @@
+#include "LatencyProbe.h"
+#include "Input.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+
+namespace {
+
+float msSince(sf::Time pressTime)
+{
+    return (Input::now() - pressTime).asSeconds() * 1000.f;
+}
+
+// nearest-rank percentile of an already sorted sample
+float percentile(const std::vector<float>& sorted, float p)
+{
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.f * static_cast<float>(sorted.size())));
+    return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+}
+
+void printStage(std::ostream& out, const char* label, std::vector<float> samples)
+{
+    out << std::left << std::setw(16) << label << std::right << std::setw(6) << samples.size() << " samples";
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        out << std::fixed << std::setprecision(1)
+            << "   p50 " << std::setw(6) << percentile(samples, 50.f) << " ms"
+            << "   p95 " << std::setw(6) << percentile(samples, 95.f) << " ms"
+            << "   p99 " << std::setw(6) << percentile(samples, 99.f) << " ms";
+    }
+    out << '\n';
+}
+
+} // namespace
+
+LatencyProbe& LatencyProbe::instance()
+{
+    static LatencyProbe probe;
+    return probe;
+}
+
+void LatencyProbe::setEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (enabled) {
+        m_toTick.reserve(RESERVED_SAMPLES);
+        m_toSim.reserve(RESERVED_SAMPLES);
+        m_toPresent.reserve(RESERVED_SAMPLES);
+        m_awaitingPublish.reserve(64);
+        m_awaitingPresent.reserve(64);
+    }
+    m_enabled = enabled;
+}
+
+void LatencyProbe::pressDelivered(sf::Time pressTime)
+{
+    if (!m_enabled)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_toTick.push_back(msSince(pressTime));
+}
+
+void LatencyProbe::turnApplied(sf::Time pressTime)
+{
+    if (!m_enabled)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_toSim.push_back(msSince(pressTime));
+    m_awaitingPublish.push_back(pressTime);
+}
+
+void LatencyProbe::snapshotPublished(std::uint64_t sequence)
+{
+    if (!m_enabled)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (sf::Time pressTime : m_awaitingPublish)
+        m_awaitingPresent.emplace_back(sequence, pressTime);
+    m_awaitingPublish.clear();
+}
+
+void LatencyProbe::framePresented(std::uint64_t sequence)
+{
+    if (!m_enabled)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // snapshots are published in order, so the shown turns are a prefix
+    std::size_t shown = 0;
+    while (shown < m_awaitingPresent.size() && m_awaitingPresent[shown].first <= sequence) {
+        m_toPresent.push_back(msSince(m_awaitingPresent[shown].second));
+        ++shown;
+    }
+    m_awaitingPresent.erase(m_awaitingPresent.begin(), m_awaitingPresent.begin() + static_cast<std::ptrdiff_t>(shown));
+}
+
+void LatencyProbe::report(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out << "Input latency (direction key -> turn)\n";
+    printStage(out, "key-to-tick", m_toTick);
+    printStage(out, "key-to-sim", m_toSim);
+    printStage(out, "key-to-present", m_toPresent);
+}
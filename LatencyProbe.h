@@ -0,0 +1,97 @@
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief measures how long a direction key takes to show up as a turn on screen
+ * @details Each sample is keyed by the press's Input timestamp and followed through
+ * three stages: the sim tick that first sees the event, the tick in which
+ * Player::update actually turns, and the first displayed frame drawn from a
+ * snapshot taken after that tick. Times are on the Input clock, so the
+ * OS-to-pollEvent delay is not included. The sim and render threads both report
+ * in, so samples are taken under a lock. Off unless enabled; every hook returns
+ * straight away then.
+ */
+class LatencyProbe
+{
+public:
+    /**
+     * @brief get the process-wide probe
+     *
+     * @return LatencyProbe& the probe
+     */
+    static LatencyProbe& instance();
+
+    // room for this many samples per stage is made up front, so recording stays off the heap
+    // for a run of any reasonable length
+    static constexpr std::size_t RESERVED_SAMPLES = 4096;
+
+    /**
+     * @brief turn recording on or off
+     *
+     * @param enabled true to record samples
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief whether samples are being recorded
+     *
+     * @return true if enabled
+     */
+    bool enabled() const { return m_enabled; }
+
+    /**
+     * @brief a direction press was handed to the sim
+     *
+     * @param pressTime the event's timestamp
+     */
+    void pressDelivered(sf::Time pressTime);
+
+    /**
+     * @brief the player turned because of a press
+     *
+     * @param pressTime the event's timestamp
+     */
+    void turnApplied(sf::Time pressTime);
+
+    /**
+     * @brief a frame snapshot was published; it shows every turn applied so far
+     *
+     * @param sequence the snapshot's number
+     */
+    void snapshotPublished(std::uint64_t sequence);
+
+    /**
+     * @brief a frame was just displayed; closes every turn its snapshot shows
+     *
+     * @param sequence number of the snapshot the frame was drawn from
+     */
+    void framePresented(std::uint64_t sequence);
+
+    /**
+     * @brief print sample counts and p50/p95/p99 per stage
+     *
+     * @param out stream to write to
+     */
+    void report(std::ostream& out) const;
+
+private:
+    LatencyProbe() = default;
+
+    bool m_enabled = false;
+    mutable std::mutex m_mutex;
+    std::vector<float> m_toTick;      // ms from press to the tick that saw it
+    std::vector<float> m_toSim;       // ms from press to the tick that turned
+    std::vector<float> m_toPresent;   // ms from press to the frame showing the turn
+    std::vector<sf::Time> m_awaitingPublish;
+    std::vector<std::pair<std::uint64_t, sf::Time>> m_awaitingPresent;   // snapshot, press
+};
+
+#endif // LATENCYPROBE_H
@@ -0,0 +1,269 @@
+#include "Leaderboard.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+bool higherScore(const ScoreEntry& a, const ScoreEntry& b)
+{
+    return a.score > b.score;
+}
+
+// three initials packed into one map key
+std::uint32_t packInitials(const std::string& initials)
+{
+    std::uint32_t key = 0;
+    for (std::size_t i = 0; i < 3; ++i) {
+        unsigned char c = i < initials.size() ? static_cast<unsigned char>(initials[i]) : 0;
+        key = (key << 8) | c;
+    }
+    return key;
+}
+
+} // namespace
+
+// --- ScoreRankTree ---------------------------------------------------------
+
+void ScoreRankTree::insert(int score)
+{
+    m_root = insert(m_root, score);
+}
+
+std::uint32_t ScoreRankTree::insert(std::uint32_t node, int score)
+{
+    if (node == NIL)
+        return newNode(score);
+
+    if (score == m_nodes[node].score) {
+        ++m_nodes[node].count;
+        ++m_nodes[node].total;
+        return node;
+    }
+
+    // higher scores sit to the left so an in-order walk runs best to worst
+    if (score > m_nodes[node].score) {
+        std::uint32_t child = insert(m_nodes[node].left, score);
+        m_nodes[node].left = child;
+        ++m_nodes[node].total;
+        if (m_nodes[child].priority > m_nodes[node].priority)
+            node = rotateRight(node);
+    }
+    else {
+        std::uint32_t child = insert(m_nodes[node].right, score);
+        m_nodes[node].right = child;
+        ++m_nodes[node].total;
+        if (m_nodes[child].priority > m_nodes[node].priority)
+            node = rotateLeft(node);
+    }
+    return node;
+}
+
+std::uint32_t ScoreRankTree::rotateRight(std::uint32_t node)
+{
+    std::uint32_t pivot = m_nodes[node].left;
+    m_nodes[node].left = m_nodes[pivot].right;
+    m_nodes[pivot].right = node;
+    refresh(node);
+    refresh(pivot);
+    return pivot;
+}
+
+std::uint32_t ScoreRankTree::rotateLeft(std::uint32_t node)
+{
+    std::uint32_t pivot = m_nodes[node].right;
+    m_nodes[node].right = m_nodes[pivot].left;
+    m_nodes[pivot].left = node;
+    refresh(node);
+    refresh(pivot);
+    return pivot;
+}
+
+std::uint32_t ScoreRankTree::newNode(int score)
+{
+    m_nodes.push_back(Node{ score, 1, 1, nextPriority(), NIL, NIL });
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
+
+void ScoreRankTree::refresh(std::uint32_t node)
+{
+    Node& n = m_nodes[node];
+    n.total = n.count + totalOf(n.left) + totalOf(n.right);
+}
+
+std::uint32_t ScoreRankTree::nextPriority()
+{
+    // xorshift32: cheap, and the tree shape only needs to look random
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return m_seed;
+}
+
+std::size_t ScoreRankTree::countAbove(int score) const
+{
+    std::size_t above = 0;
+    std::uint32_t node = m_root;
+    while (node != NIL) {
+        const Node& n = m_nodes[node];
+        if (score < n.score) {
+            above += totalOf(n.left) + n.count;
+            node = n.right;
+        }
+        else if (score > n.score) {
+            node = n.left;
+        }
+        else {
+            above += totalOf(n.left);
+            break;
+        }
+    }
+    return above;
+}
+
+void ScoreRankTree::appendDescending(int score)
+{
+    // bulk loading only makes sense on an empty tree
+    if (m_root != NIL) {
+        insert(score);
+        return;
+    }
+
+    if (!m_nodes.empty() && m_nodes.back().score == score) {
+        ++m_nodes.back().count;
+        ++m_nodes.back().total;
+    }
+    else {
+        newNode(score);
+    }
+}
+
+void ScoreRankTree::finishBulkLoad()
+{
+    if (m_root != NIL || m_nodes.empty())
+        return;
+
+    // The appended nodes are already in in-order, so the treap is the Cartesian
+    // tree of their priorities, built left to right with a stack in O(n).
+    std::vector<std::uint32_t> spine;
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(m_nodes.size()); ++i) {
+        std::uint32_t last = NIL;
+        while (!spine.empty() && m_nodes[spine.back()].priority < m_nodes[i].priority) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        m_nodes[i].left = last;
+        if (!spine.empty())
+            m_nodes[spine.back()].right = i;
+        spine.push_back(i);
+    }
+    m_root = spine.front();
+
+    // subtree totals, children before parents
+    std::vector<std::pair<std::uint32_t, bool>> stack;
+    stack.emplace_back(m_root, false);
+    while (!stack.empty()) {
+        auto [node, childrenDone] = stack.back();
+        stack.pop_back();
+        if (childrenDone) {
+            refresh(node);
+            continue;
+        }
+        stack.emplace_back(node, true);
+        if (m_nodes[node].left != NIL)
+            stack.emplace_back(m_nodes[node].left, false);
+        if (m_nodes[node].right != NIL)
+            stack.emplace_back(m_nodes[node].right, false);
+    }
+}
+
+// --- TopList ---------------------------------------------------------------
+
+void TopList::offer(const ScoreEntry& entry)
+{
+    if (m_capacity == 0)
+        return;
+    if (m_entries.size() == m_capacity && entry.score <= m_entries.back().score)
+        return;
+
+    auto pos = std::upper_bound(m_entries.begin(), m_entries.end(), entry, higherScore);
+    m_entries.insert(pos, entry);
+    if (m_entries.size() > m_capacity)
+        m_entries.pop_back();
+}
+
+// --- Leaderboard -----------------------------------------------------------
+
+void Leaderboard::insert(const ScoreEntry& entry)
+{
+    m_ranks.insert(entry.score);
+    m_top.offer(entry);
+}
+
+void Leaderboard::appendDescending(const ScoreEntry& entry)
+{
+    m_ranks.appendDescending(entry.score);
+    m_top.offer(entry);
+}
+
+Placement Leaderboard::placement(int score) const
+{
+    Placement p;
+    p.rank = m_ranks.countAbove(score) + 1;
+    p.total = m_ranks.size();
+    if (p.total > 0)
+        p.topPercent = 100.0 * static_cast<double>(p.rank) / static_cast<double>(p.total);
+    return p;
+}
+
+// --- Leaderboards ----------------------------------------------------------
+
+Leaderboards::Leaderboards(std::size_t topCapacity)
+    : m_topCapacity(topCapacity)
+    , m_allTime(topCapacity)
+{
+}
+
+Leaderboard& Leaderboards::boardFor(std::unordered_map<std::uint32_t, Leaderboard>& boards, std::uint32_t key)
+{
+    auto it = boards.find(key);
+    if (it == boards.end())
+        it = boards.emplace(key, Leaderboard(m_topCapacity)).first;
+    return it->second;
+}
+
+void Leaderboards::insert(const ScoreEntry& entry)
+{
+    m_allTime.insert(entry);
+    boardFor(m_daily, entry.day).insert(entry);
+    boardFor(m_players, packInitials(entry.name)).insert(entry);
+}
+
+void Leaderboards::appendDescending(const ScoreEntry& entry)
+{
+    // every sub-board sees its own entries in the same descending order
+    m_allTime.appendDescending(entry);
+    boardFor(m_daily, entry.day).appendDescending(entry);
+    boardFor(m_players, packInitials(entry.name)).appendDescending(entry);
+}
+
+void Leaderboards::finishBulkLoad()
+{
+    m_allTime.finishBulkLoad();
+    for (auto& board : m_daily)
+        board.second.finishBulkLoad();
+    for (auto& board : m_players)
+        board.second.finishBulkLoad();
+}
+
+const Leaderboard* Leaderboards::daily(std::uint32_t day) const
+{
+    auto it = m_daily.find(day);
+    return it == m_daily.end() ? nullptr : &it->second;
+}
+
+const Leaderboard* Leaderboards::player(const std::string& initials) const
+{
+    auto it = m_players.find(packInitials(initials));
+    return it == m_players.end() ? nullptr : &it->second;
+}
@@ -0,0 +1,255 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief a single high-score record: three initials, a score and the day it was set
+ */
+struct ScoreEntry
+{
+    std::string name;
+    int score = 0;
+    std::uint32_t day = 0;  // days since 1970-01-01 (UTC)
+};
+
+/**
+ * @brief where a score lands on a board
+ */
+struct Placement
+{
+    std::size_t rank = 0;      // 1 = best; ties share the better rank
+    std::size_t total = 0;     // entries on the board, including this one
+    double topPercent = 0.0;   // rank as a percentage of total
+};
+
+/**
+ * @brief order-statistics tree over scores (a treap keyed on distinct scores)
+ * @details Each node stores one score with its multiplicity and the number of
+ * entries in its subtree, so inserting and ranking are O(log n). Nodes live in one
+ * vector and link by index, which keeps millions of entries compact.
+ */
+class ScoreRankTree
+{
+public:
+    /**
+     * @brief add one entry with the given score
+     *
+     * @param score score to insert
+     */
+    void insert(int score);
+
+    /**
+     * @brief number of entries strictly above a score
+     *
+     * @param score score to rank
+     * @return std::size_t entries that beat it
+     */
+    std::size_t countAbove(int score) const;
+
+    /**
+     * @brief total number of entries
+     *
+     * @return std::size_t entry count
+     */
+    std::size_t size() const { return m_root == NIL ? 0 : m_nodes[m_root].total; }
+
+    /**
+     * @brief add an entry during a bulk load; scores must arrive highest first
+     *
+     * @param score score to append
+     */
+    void appendDescending(int score);
+
+    /**
+     * @brief link the appended entries into a tree in O(n)
+     */
+    void finishBulkLoad();
+
+private:
+    static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node
+    {
+        int score;
+        std::uint32_t count;      // entries with exactly this score
+        std::uint32_t total;      // entries in this subtree
+        std::uint32_t priority;
+        std::uint32_t left;       // higher scores
+        std::uint32_t right;      // lower scores
+    };
+
+    std::uint32_t insert(std::uint32_t node, int score);
+    std::uint32_t rotateLeft(std::uint32_t node);
+    std::uint32_t rotateRight(std::uint32_t node);
+    std::uint32_t newNode(int score);
+    std::uint32_t totalOf(std::uint32_t node) const { return node == NIL ? 0 : m_nodes[node].total; }
+    void refresh(std::uint32_t node);
+    std::uint32_t nextPriority();
+
+    std::vector<Node> m_nodes;
+    std::uint32_t m_root = NIL;
+    std::uint32_t m_seed = 0x9E3779B9u;
+};
+
+/**
+ * @brief the best K entries of a board, highest first
+ * @details Equal scores keep the order they were submitted in.
+ */
+class TopList
+{
+public:
+    /**
+     * @brief Construct a new Top List object
+     *
+     * @param capacity number of entries kept
+     */
+    explicit TopList(std::size_t capacity = 10) : m_capacity(capacity) { m_entries.reserve(capacity + 1); }
+
+    /**
+     * @brief offer an entry; it is kept only if it makes the top K
+     *
+     * @param entry entry to offer
+     */
+    void offer(const ScoreEntry& entry);
+
+    /**
+     * @brief the kept entries, highest first
+     *
+     * @return const std::vector<ScoreEntry>& up to K entries
+     */
+    const std::vector<ScoreEntry>& entries() const { return m_entries; }
+
+private:
+    std::size_t m_capacity;
+    std::vector<ScoreEntry> m_entries;
+};
+
+/**
+ * @brief one board: rank queries over every entry plus a bounded top-K for display
+ */
+class Leaderboard
+{
+public:
+    /**
+     * @brief Construct a new Leaderboard object
+     *
+     * @param topCapacity number of entries kept for display
+     */
+    explicit Leaderboard(std::size_t topCapacity = 10) : m_top(topCapacity) {}
+
+    /**
+     * @brief add an entry
+     *
+     * @param entry entry to add
+     */
+    void insert(const ScoreEntry& entry);
+
+    /**
+     * @brief add an entry during a bulk load; entries must arrive highest first
+     *
+     * @param entry entry to append
+     */
+    void appendDescending(const ScoreEntry& entry);
+
+    /**
+     * @brief finish a bulk load started with appendDescending()
+     */
+    void finishBulkLoad() { m_ranks.finishBulkLoad(); }
+
+    /**
+     * @brief rank of an entry already on the board with the given score
+     *
+     * @param score score to place
+     * @return Placement rank, board size and percentile
+     */
+    Placement placement(int score) const;
+
+    /**
+     * @brief the best entries, highest first
+     *
+     * @return const std::vector<ScoreEntry>& up to the display capacity
+     */
+    const std::vector<ScoreEntry>& top() const { return m_top.entries(); }
+
+    /**
+     * @brief number of entries on the board
+     *
+     * @return std::size_t entry count
+     */
+    std::size_t size() const { return m_ranks.size(); }
+
+private:
+    ScoreRankTree m_ranks;
+    TopList m_top;
+};
+
+/**
+ * @brief the all-time, daily and per-initials boards kept side by side
+ */
+class Leaderboards
+{
+public:
+    /**
+     * @brief Construct a new Leaderboards object
+     *
+     * @param topCapacity number of entries kept for display on each board
+     */
+    explicit Leaderboards(std::size_t topCapacity = 10);
+
+    /**
+     * @brief add an entry to every board it belongs to
+     *
+     * @param entry entry to add
+     */
+    void insert(const ScoreEntry& entry);
+
+    /**
+     * @brief add an entry during a bulk load; entries must arrive highest first
+     *
+     * @param entry entry to append
+     */
+    void appendDescending(const ScoreEntry& entry);
+
+    /**
+     * @brief finish a bulk load started with appendDescending()
+     */
+    void finishBulkLoad();
+
+    /**
+     * @brief the all-time board
+     *
+     * @return const Leaderboard& board with every entry
+     */
+    const Leaderboard& allTime() const { return m_allTime; }
+
+    /**
+     * @brief the board for one day
+     *
+     * @param day days since 1970-01-01 (UTC)
+     * @return const Leaderboard* the board, or nullptr when nobody played that day
+     */
+    const Leaderboard* daily(std::uint32_t day) const;
+
+    /**
+     * @brief the board for one set of initials
+     *
+     * @param initials three-character initials
+     * @return const Leaderboard* the board, or nullptr when the initials never played
+     */
+    const Leaderboard* player(const std::string& initials) const;
+
+private:
+    Leaderboard& boardFor(std::unordered_map<std::uint32_t, Leaderboard>& boards, std::uint32_t key);
+
+    std::size_t m_topCapacity;
+    Leaderboard m_allTime;
+    std::unordered_map<std::uint32_t, Leaderboard> m_daily;
+    std::unordered_map<std::uint32_t, Leaderboard> m_players;  // keyed by packed initials
+};
+
+#endif // LEADERBOARD_H
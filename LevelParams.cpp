@@ -0,0 +1,104 @@
+#include "LevelParams.h"
+#include "FileUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// written only by loadOverrides(), before the game starts
+std::array<LevelParams, LevelTable::LEVEL_COUNT> s_table = LevelTable::DEFAULTS;
+
+// "3", "2-4" or "5+" -> inclusive 1-based range, clamped to the table
+bool parseLevels(const std::string& text, int& first, int& last)
+{
+    char* end = nullptr;
+    long from = std::strtol(text.c_str(), &end, 10);
+    long to = from;
+    if (end == text.c_str() || from < 1)
+        return false;
+    if (*end == '+') {
+        to = LevelTable::LEVEL_COUNT;
+        ++end;
+    }
+    else if (*end == '-') {
+        const char* start = end + 1;
+        to = std::strtol(start, &end, 10);
+        if (end == start || to < from)
+            return false;
+    }
+    if (*end != '\0')
+        return false;
+
+    first = static_cast<int>(std::min<long>(from, LevelTable::LEVEL_COUNT));
+    last = static_cast<int>(std::min<long>(to, LevelTable::LEVEL_COUNT));
+    return true;
+}
+
+// where a named parameter lives in a row, and how many floats it takes
+bool findParam(const std::string& name, LevelParams& row, float*& values, std::size_t& count)
+{
+    static const struct { const char* name; float LevelParams::* scalar; float (LevelParams::* array)[4]; } PARAMS[] = {
+        { "pac_speed", &LevelParams::pacSpeed, nullptr },
+        { "pac_eating_speed", &LevelParams::pacEatingSpeed, nullptr },
+        { "ghost_speed", &LevelParams::ghostSpeed, nullptr },
+        { "ghost_frightened_speed", &LevelParams::ghostFrightenedSpeed, nullptr },
+        { "ghost_eaten_speed", &LevelParams::ghostEatenSpeed, nullptr },
+        { "frightened", &LevelParams::frightenedSeconds, nullptr },
+        { "blink", &LevelParams::blinkSeconds, nullptr },
+        { "scatter", nullptr, &LevelParams::scatterSeconds },
+        { "chase", nullptr, &LevelParams::chaseSeconds },
+    };
+    for (const auto& param : PARAMS) {
+        if (name != param.name)
+            continue;
+        if (param.scalar) {
+            values = &(row.*param.scalar);
+            count = 1;
+        }
+        else {
+            values = row.*param.array;
+            count = 4;
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+const LevelParams& LevelTable::get(int level)
+{
+    int row = std::min(std::max(level, 1), LEVEL_COUNT) - 1;
+    return s_table[static_cast<std::size_t>(row)];
+}
+
+bool LevelTable::loadOverrides(const std::string& path)
+{
+    // edit a copy, so a bad line leaves the table as it was
+    std::array<LevelParams, LEVEL_COUNT> table = s_table;
+    bool read = readLines(path, "level overrides", [&table](std::istream& fields) {
+        std::string levels, name;
+        int first = 0, last = 0;
+        float parsed[4];
+        float* values = nullptr;
+        std::size_t count = 0;
+        bool ok = (fields >> levels) && parseLevels(levels, first, last) && (fields >> name)
+            && findParam(name, table[0], values, count);
+        for (std::size_t i = 0; ok && i < count; ++i)
+            ok = static_cast<bool>(fields >> parsed[i]) && parsed[i] >= 0.f;
+        if (!ok)
+            return false;
+
+        for (int level = first; level <= last; ++level) {
+            findParam(name, table[static_cast<std::size_t>(level - 1)], values, count);
+            std::copy(parsed, parsed + count, values);
+        }
+        return true;
+    });
+    if (!read)
+        return false;
+
+    s_table = table;
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef LEVELPARAMS_H
+#define LEVELPARAMS_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief every tuning value that changes from level to level
+ * @details Speeds are fractions: Pac-Man's of BASE_TILES_PER_SECOND, the ghosts'
+ * of Pac-Man's normal speed on the same level. Times are in seconds; a chase phase
+ * of 0 lasts for the rest of the level.
+ */
+struct LevelParams
+{
+    static constexpr float BASE_TILES_PER_SECOND = 7.5f;
+
+    float pacSpeed;
+    float pacEatingSpeed;           // while the next tile holds a pellet
+    float ghostSpeed;               // scatter and chase
+    float ghostFrightenedSpeed;
+    float ghostEatenSpeed;
+    float scatterSeconds[4];
+    float chaseSeconds[4];
+    float frightenedSeconds;        // how long a power pellet lasts
+    float blinkSeconds;             // when frightened ghosts start to flash
+};
+
+namespace LevelTable {
+
+// levels past the last row reuse it
+constexpr int LEVEL_COUNT = 21;
+
+namespace detail {
+
+// one row per range of levels that share their tuning, from firstLevel on
+struct Band
+{
+    int firstLevel;
+    LevelParams params;
+};
+
+constexpr float ONE_FRAME = 1.f / 60.f;
+
+constexpr Band BANDS[] = {
+    { 1,  { 0.8f, 0.71f, 0.75f, 0.50f, 2.0f, { 7.f, 7.f, 5.f, 5.f },       { 20.f, 20.f, 20.f, 0.f },   8.f, 6.f } },
+    { 2,  { 0.9f, 0.79f, 0.85f, 0.55f, 2.0f, { 7.f, 7.f, 5.f, ONE_FRAME }, { 20.f, 20.f, 1033.f, 0.f }, 8.f, 6.f } },
+    { 5,  { 1.0f, 0.90f, 0.95f, 0.60f, 2.0f, { 5.f, 5.f, 5.f, ONE_FRAME }, { 20.f, 20.f, 1037.f, 0.f }, 8.f, 6.f } },
+    { 21, { 1.1f, 0.90f, 0.95f, 0.60f, 2.0f, { 5.f, 5.f, 5.f, ONE_FRAME }, { 20.f, 20.f, 1037.f, 0.f }, 8.f, 6.f } },
+};
+
+// expand the bands into one row per level so a lookup is a single index
+constexpr std::array<LevelParams, LEVEL_COUNT> expand()
+{
+    std::array<LevelParams, LEVEL_COUNT> table{};
+    std::size_t band = 0;
+    for (int level = 1; level <= LEVEL_COUNT; ++level) {
+        while (band + 1 < sizeof(BANDS) / sizeof(BANDS[0]) && BANDS[band + 1].firstLevel <= level)
+            ++band;
+        table[static_cast<std::size_t>(level - 1)] = BANDS[band].params;
+    }
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * @brief the built-in tuning, fixed at compile time
+ */
+constexpr std::array<LevelParams, LEVEL_COUNT> DEFAULTS = detail::expand();
+
+/**
+ * @brief the tuning for one level: the built-in row unless an override changed it
+ *
+ * @param level level number, 1-based; out-of-range levels are clamped
+ * @return const LevelParams& the level's parameters
+ */
+const LevelParams& get(int level);
+
+/**
+ * @brief replace parts of the table from a text file, for tuning runs
+ * @details One setting per line: a level or range ("3", "2-4", "5+"), a
+ * parameter name and its value(s); '#' starts a comment. Names are pac_speed,
+ * pac_eating_speed, ghost_speed, ghost_frightened_speed, ghost_eaten_speed,
+ * scatter (4 values), chase (4 values), frightened and blink. A file with any bad
+ * line changes nothing.
+ *
+ * @param path override file
+ * @return true if the whole file was applied
+ */
+bool loadOverrides(const std::string& path);
+
+} // namespace LevelTable
+
+#endif // LEVELPARAMS_H
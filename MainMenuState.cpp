@@ -1,68 +1,66 @@
 #include "MainMenuState.h"
+#include "FrameBuffer.h"
 #include "PlayingState.h"
+#include "ResourceCache.h"
 #include <iostream>
 
+namespace {
+
+const char* const MENU_FONT = "assets/fonts/pacfont.ttf";
+const unsigned int TITLE_SIZE = 75;
+const unsigned int LINE_SIZE = 40;
+const char* const SPRITE_SHEET = "assets/sprites/pacmanspritesheet.png";
+
+} // namespace
+
+void MainMenuState::preload()
+{
+    ResourceCache::glyphs(MENU_FONT, TITLE_SIZE);
+    ResourceCache::glyphs(MENU_FONT, LINE_SIZE);
+    ResourceCache::texture(SPRITE_SHEET);
+}
+
 MainMenuState::MainMenuState(StateManager& stateManager, const sf::RenderWindow& window)
     : m_stateManager(stateManager),
     m_velocity(200.f, 0.f),
     m_window(window)
 {
-    // Load the font
-    if (!m_font.loadFromFile("assets/fonts/pacfont.ttf")) {
-        std::cerr << "Failed to load font!" << std::endl;
-    }
-
     // Get window width for centering
-    unsigned int windowWidth = m_window.getSize().x;
+    float cx = static_cast<float>(FrameBuffer::layoutSize().x) / 2.f;
 
     // Configure Title Text
-    m_titleText.setFont(m_font);
+    m_titleText.setGlyphs(ResourceCache::glyphs(MENU_FONT, TITLE_SIZE));
     m_titleText.setString("PacMan 1009:");
-    m_titleText.setCharacterSize(75);
-    {
-        sf::FloatRect titleBounds = m_titleText.getLocalBounds();
-        m_titleText.setOrigin(titleBounds.left + titleBounds.width / 2.f,
-            titleBounds.top + titleBounds.height / 2.f);
-        m_titleText.setPosition((float)windowWidth / 2.f, 100.f);
-    }
+    m_titleText.centerOn(sf::Vector2f(cx, 100.f));
 
     // Configure "Play" Text
-    m_playText.setFont(m_font);
+    m_playText.setGlyphs(ResourceCache::glyphs(MENU_FONT, LINE_SIZE));
     m_playText.setString("Press Enter to Play");
-    m_playText.setCharacterSize(40);
-    {
-        sf::FloatRect playBounds = m_playText.getLocalBounds();
-        m_playText.setOrigin(playBounds.left + playBounds.width / 2.f,
-            playBounds.top + playBounds.height / 2.f);
-        m_playText.setPosition((float)windowWidth / 2.f, 200.f);
-    }
+    m_playText.centerOn(sf::Vector2f(cx, 200.f));
 
     // Configure "Exit" Text
-    m_exitText.setFont(m_font);
+    m_exitText.setGlyphs(ResourceCache::glyphs(MENU_FONT, LINE_SIZE));
     m_exitText.setString("Press Esc to Exit");
-    m_exitText.setCharacterSize(40);
-    {
-        sf::FloatRect exitBounds = m_exitText.getLocalBounds();
-        m_exitText.setOrigin(exitBounds.left + exitBounds.width / 2.f,
-            exitBounds.top + exitBounds.height / 2.f);
-        m_exitText.setPosition((float)windowWidth / 2.f, 300.f);
-    }
+    m_exitText.centerOn(sf::Vector2f(cx, 300.f));
 
     initAnimations();
 }
 
-void MainMenuState::handleEvents(sf::RenderWindow& window) {
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Enter)) {
-        m_stateManager.changeState(std::make_unique<PlayingState>(m_stateManager, m_window));
+void MainMenuState::handleEvents(sf::RenderWindow&, const Input& input) {
+    // leaving the last state ends the game; the window is closed once the render
+    // thread has stopped drawing into it
+    if (input.pressed(sf::Keyboard::Escape)) {
+        m_stateManager.popState();
+        return;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape)) {
-        window.close();
+    if (input.pressed(sf::Keyboard::Enter)) {
+        m_stateManager.changeState(std::make_unique<PlayingState>(m_stateManager, m_window));
     }
 }
 
 void MainMenuState::update(sf::Time dt)
 {
-    unsigned int windowWidth = m_window.getSize().x;
+    unsigned int windowWidth = FrameBuffer::layoutSize().x;
     sf::FloatRect pacBounds = m_pacMan.getGlobalBounds();
 
     // When Pac-Man is moving left (chased by the regular ghost)
@@ -120,24 +118,24 @@ void MainMenuState::update(sf::Time dt)
     }
 }
 
-void MainMenuState::render(sf::RenderWindow& window) {
-    window.draw(m_titleText);
-    window.draw(m_playText);
-    window.draw(m_exitText);
-    window.draw(m_pacMan);
-    window.draw(m_ghost);
-    window.draw(m_BlueGhost);
+void MainMenuState::render(FrameSnapshot& frame) {
+    m_titleText.render(frame);
+    m_playText.render(frame);
+    m_exitText.render(frame);
+    m_pacMan.render(frame);
+    m_ghost.render(frame);
+    m_BlueGhost.render(frame);
 }
 
 void MainMenuState::initAnimations()
 {
-    unsigned int windowWidth = m_window.getSize().x;
+    unsigned int windowWidth = FrameBuffer::layoutSize().x;
     int heightOfAnimation = 600;
     const int sizeScale = 5;
 
 
     m_pacMan = AnimatedSprite(sf::seconds(0.1f), true);
-    if (!m_pacMan.loadTexture("assets/sprites/pacmanspritesheet.png")) {
+    if (!m_pacMan.loadTexture(SPRITE_SHEET)) {
         std::cerr << "Failed to load PacMan texture!" << std::endl;
     }
     const int frameSizePac = 13;
@@ -156,7 +154,7 @@ void MainMenuState::initAnimations()
     m_pacMan.play();
 
     m_ghost = AnimatedSprite(sf::seconds(0.15f), true);
-    if (!m_ghost.loadTexture("assets/sprites/pacmanspritesheet.png")) {
+    if (!m_ghost.loadTexture(SPRITE_SHEET)) {
         std::cerr << "Failed to load Ghost texture!" << std::endl;
     }
     const int frameSizeGhost = 14;
@@ -173,7 +171,7 @@ void MainMenuState::initAnimations()
     m_ghost.play();
 
     m_BlueGhost = AnimatedSprite(sf::seconds(0.15f), true);
-    if (!m_BlueGhost.loadTexture("assets/sprites/pacmanspritesheet.png")) {
+    if (!m_BlueGhost.loadTexture(SPRITE_SHEET)) {
         std::cerr << "Failed to load BlueGhost texture!" << std::endl;
     }
     for (int i = 0; i < 2; i++) {
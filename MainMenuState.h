@@ -4,6 +4,7 @@
 #include "GameState.h"
 #include "StateManager.h"
 #include "AnimatedSprite.h"
+#include "TextLabel.h"
 
 #include <SFML/Graphics.hpp>
 #include <vector>
@@ -16,7 +17,15 @@ public:
      * @param window Reference to the SFML window
      */
     MainMenuState(StateManager& stateManager, const sf::RenderWindow& window);
-    
+
+    /**
+     * @brief Load every texture and glyph atlas this state uses
+     * @details Called while the window's GL context is current, before the sim
+     * thread starts, so constructing the state later only looks them up.
+     */
+    static void preload();
+
+
     /**
      * @brief MainMenuState destructor
      * @details Default destructor.
@@ -26,8 +35,9 @@ public:
     /**
      * @brief Handle events for the main menu state
      * @param window Reference to the SFML window
+     * @param input Keyboard events for this tick
      */
-    void handleEvents(sf::RenderWindow& window) override;
+    void handleEvents(sf::RenderWindow& window, const Input& input) override;
     
     /**
      * @brief Update the main menu state
@@ -36,10 +46,21 @@ public:
     void update(sf::Time dt) override;
 
     /**
-     * @brief Render the main menu state
-     * @param window Reference to the SFML window
+     * @brief The menu only waits for Enter or Esc
+     * @return true always
      */
-    void render(sf::RenderWindow& window) override;
+    bool isIdle() const override { return true; }
+
+    /**
+     * @brief Name reported by the metrics endpoint
+     */
+    const char* name() const override { return "menu"; }
+
+    /**
+     * @brief Record the main menu into a frame snapshot
+     * @param frame Snapshot to record into
+     */
+    void render(FrameSnapshot& frame) override;
 
 private:
 
@@ -50,12 +71,9 @@ private:
     void initAnimations();
 
     StateManager& m_stateManager;
-    sf::Font m_font;
-    sf::Text m_menuText;
-
-    sf::Text m_titleText;
-    sf::Text m_playText;
-    sf::Text m_exitText;
+    TextLabel m_titleText;
+    TextLabel m_playText;
+    TextLabel m_exitText;
 
     AnimatedSprite m_pacMan;
     AnimatedSprite m_ghost;
@@ -0,0 +1,196 @@
+#include "MazeChunks.h"
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+const sf::Color WALL_FILL(0, 0, 96);
+const sf::Color WALL_EDGE(33, 33, 222);
+const sf::Color GATE(255, 184, 255);
+const sf::Color PELLET(255, 184, 151);
+
+const float TILE = static_cast<float>(MazeLayout::TILE_SIZE);
+const float EDGE = 3.f;       // one native pixel
+const float DOT = 6.f;
+const float ENERGIZER = 18.f;
+
+void pushRect(ArenaVector<sf::Vertex>& out, float left, float top, float width, float height, sf::Color color)
+{
+    sf::Vertex topLeft(sf::Vector2f(left, top), color);
+    sf::Vertex topRight(sf::Vector2f(left + width, top), color);
+    sf::Vertex bottomLeft(sf::Vector2f(left, top + height), color);
+    sf::Vertex bottomRight(sf::Vector2f(left + width, top + height), color);
+    out.push_back(topLeft);
+    out.push_back(topRight);
+    out.push_back(bottomLeft);
+    out.push_back(bottomLeft);
+    out.push_back(topRight);
+    out.push_back(bottomRight);
+}
+
+// a square centred in a tile
+void pushCentred(ArenaVector<sf::Vertex>& out, float left, float top, float width, float height, sf::Color color)
+{
+    pushRect(out, left + (TILE - width) / 2.f, top + (TILE - height) / 2.f, width, height, color);
+}
+
+} // namespace
+
+void MazeChunks::reset(std::shared_ptr<const MazeLayout> layout)
+{
+    m_layout = std::move(layout);
+    m_chunks.clear();
+    m_eaten.assign(m_layout ? m_layout->tiles.size() : 0, 0);
+    m_chunkColumns = m_layout ? (m_layout->columns + CHUNK_TILES - 1) / CHUNK_TILES : 0;
+    m_chunkRows = m_layout ? (m_layout->rows + CHUNK_TILES - 1) / CHUNK_TILES : 0;
+
+    // a full cache's worth of slots up front; the camera only ever reuses them
+    if (m_layout)
+        m_chunks.resize(CACHE_LIMIT);
+}
+
+void MazeChunks::eat(std::size_t index)
+{
+    if (!m_layout || index >= m_eaten.size())
+        return;
+    m_eaten[index] = 1;
+
+    int column = static_cast<int>(index % static_cast<std::size_t>(m_layout->columns));
+    int row = static_cast<int>(index / static_cast<std::size_t>(m_layout->columns));
+    if (Chunk* chunk = find(key(column / CHUNK_TILES, row / CHUNK_TILES)))
+        chunk->stale = true;
+}
+
+void MazeChunks::draw(CountedTarget& target, const sf::FloatRect& visible)
+{
+    if (!m_layout)
+        return;
+    ++m_frame;
+
+    // chunks overlapping the visible area, clamped to the maze
+    const float span = TILE * static_cast<float>(CHUNK_TILES);
+    int firstX = std::max(0, static_cast<int>(std::floor(visible.left / span)));
+    int firstY = std::max(0, static_cast<int>(std::floor(visible.top / span)));
+    int lastX = std::min(m_chunkColumns - 1, static_cast<int>(std::floor((visible.left + visible.width) / span)));
+    int lastY = std::min(m_chunkRows - 1, static_cast<int>(std::floor((visible.top + visible.height) / span)));
+
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            Chunk* found = find(key(x, y));
+            Chunk& chunk = found ? *found : claim(key(x, y));
+            if (chunk.stale)
+                build(chunk, x, y);
+            chunk.lastDrawn = m_frame;
+            if (chunk.count == 0)
+                continue;
+            if (sf::VertexBuffer::isAvailable())
+                target.draw(chunk.buffer, 0, chunk.count);
+            else
+                target.draw(chunk.vertices.data(), chunk.count, sf::Triangles);
+        }
+    }
+}
+
+void MazeChunks::build(Chunk& chunk, int chunkX, int chunkY)
+{
+    const MazeLayout& maze = *m_layout;
+    auto isWall = [&maze](int column, int row) {
+        // outside the maze counts as wall, so the border gets no edge
+        return column < 0 || row < 0 || column >= maze.columns || row >= maze.rows || maze.at(column, row) == MazeLayout::Wall;
+    };
+
+    // the chunk's geometry, in the render thread's frame arena: room for the worst
+    // case (a wall on every tile, edged on all four sides) is taken once and handed
+    // back as soon as it is uploaded
+    ArenaVector<sf::Vertex> vertices;
+    vertices.reserve(static_cast<std::size_t>(CHUNK_TILES * CHUNK_TILES) * 5 * 6);
+    int endColumn = std::min(maze.columns, (chunkX + 1) * CHUNK_TILES);
+    int endRow = std::min(maze.rows, (chunkY + 1) * CHUNK_TILES);
+    for (int row = chunkY * CHUNK_TILES; row < endRow; ++row) {
+        for (int column = chunkX * CHUNK_TILES; column < endColumn; ++column) {
+            float left = static_cast<float>(column) * TILE;
+            float top = static_cast<float>(row) * TILE;
+            std::size_t index = static_cast<std::size_t>(row) * static_cast<std::size_t>(maze.columns) + static_cast<std::size_t>(column);
+
+            switch (maze.tiles[index]) {
+            case MazeLayout::Wall:
+                // a dark block, edged in blue wherever it faces open maze
+                pushRect(vertices, left, top, TILE, TILE, WALL_FILL);
+                if (!isWall(column, row - 1))
+                    pushRect(vertices, left, top, TILE, EDGE, WALL_EDGE);
+                if (!isWall(column, row + 1))
+                    pushRect(vertices, left, top + TILE - EDGE, TILE, EDGE, WALL_EDGE);
+                if (!isWall(column - 1, row))
+                    pushRect(vertices, left, top, EDGE, TILE, WALL_EDGE);
+                if (!isWall(column + 1, row))
+                    pushRect(vertices, left + TILE - EDGE, top, EDGE, TILE, WALL_EDGE);
+                break;
+            case MazeLayout::Gate:
+                pushCentred(vertices, left, top, TILE, DOT, GATE);
+                break;
+            case MazeLayout::Dot:
+                if (!m_eaten[index])
+                    pushCentred(vertices, left, top, DOT, DOT, PELLET);
+                break;
+            case MazeLayout::Energizer:
+                // two crossed bars read as a round pellet at native resolution
+                if (!m_eaten[index]) {
+                    pushCentred(vertices, left, top, ENERGIZER, ENERGIZER - DOT, PELLET);
+                    pushCentred(vertices, left, top, ENERGIZER - DOT, ENERGIZER, PELLET);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    chunk.count = vertices.size();
+    chunk.stale = false;
+    if (sf::VertexBuffer::isAvailable()) {
+        // a chunk only loses pellets, so the first upload is as large as it gets
+        if (chunk.buffer.getVertexCount() < chunk.count)
+            chunk.buffer.create(chunk.count);
+        if (chunk.count > 0)
+            chunk.buffer.update(vertices.data(), chunk.count, 0);
+    }
+    else {
+        chunk.vertices.assign(vertices.begin(), vertices.end());
+    }
+}
+
+MazeChunks::Chunk* MazeChunks::find(std::uint32_t key)
+{
+    for (Chunk& chunk : m_chunks) {
+        if (chunk.key == key)
+            return &chunk;
+    }
+    return nullptr;
+}
+
+MazeChunks::Chunk& MazeChunks::claim(std::uint32_t key)
+{
+    // a free slot, or the one drawn longest ago that is not on screen now
+    Chunk* oldest = nullptr;
+    for (Chunk& chunk : m_chunks) {
+        if (chunk.key == NO_CHUNK) {
+            oldest = &chunk;
+            break;
+        }
+        if (chunk.lastDrawn != m_frame && (!oldest || chunk.lastDrawn < oldest->lastDrawn))
+            oldest = &chunk;
+    }
+    // everything is on screen: a maze view bigger than the cache
+    if (!oldest) {
+        m_chunks.emplace_back();
+        oldest = &m_chunks.back();
+    }
+
+    // the buffer and vertex storage stay, to be overwritten by build()
+    oldest->key = key;
+    oldest->stale = true;
+    return *oldest;
+}
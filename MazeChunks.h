@@ -0,0 +1,94 @@
+#ifndef MAZECHUNKS_H
+#define MAZECHUNKS_H
+
+#include "CountedTarget.h"
+#include "MazeLayout.h"
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief a scrolling maze drawn as square chunks of prebuilt geometry
+ * @details The maze is cut into CHUNK_TILES x CHUNK_TILES squares. A chunk is built
+ * the first time the camera reaches it: its walls, gates and remaining pellets
+ * become one static vertex buffer, drawn with a single call for as long as it stays
+ * on screen and rebuilt only when one of its pellets is eaten. Chunks the camera
+ * has left are kept up to CACHE_LIMIT; past that the least recently drawn one's
+ * slot, buffer included, is reused for the next chunk to come into view, so both
+ * memory and the cost of a frame follow the visible area rather than the size of
+ * the maze, and scrolling does not allocate. Render thread only.
+ */
+class MazeChunks
+{
+public:
+    static constexpr int CHUNK_TILES = 16;
+    static constexpr std::size_t CACHE_LIMIT = 64;
+
+    /**
+     * @brief forget every chunk and start on a new maze with no pellets eaten
+     *
+     * @param layout maze to draw
+     */
+    void reset(std::shared_ptr<const MazeLayout> layout);
+
+    /**
+     * @brief take an eaten pellet out of its chunk
+     *
+     * @param index row-major tile index
+     */
+    void eat(std::size_t index);
+
+    /**
+     * @brief draw every chunk that meets an area, building any that are missing
+     *
+     * @param target target whose view shows that area
+     * @param visible area in maze coordinates
+     */
+    void draw(CountedTarget& target, const sf::FloatRect& visible);
+
+private:
+    static constexpr std::uint32_t NO_CHUNK = 0xFFFFFFFFu;
+
+    struct Chunk
+    {
+        std::uint32_t key = NO_CHUNK;       // which chunk the slot holds
+        sf::VertexBuffer buffer{ sf::Triangles, sf::VertexBuffer::Static };
+        std::vector<sf::Vertex> vertices;   // used instead where vertex buffers are unavailable
+        std::size_t count = 0;              // vertices in use
+        std::uint64_t lastDrawn = 0;
+        bool stale = true;                  // needs building before it is drawn
+    };
+
+    /**
+     * @brief lay out one chunk's geometry and upload it
+     */
+    void build(Chunk& chunk, int chunkX, int chunkY);
+
+    /**
+     * @brief the slot holding a chunk, or nullptr
+     */
+    Chunk* find(std::uint32_t key);
+
+    /**
+     * @brief a slot for a chunk coming into view: a free one, else the least
+     * recently drawn one off screen, else a new one
+     */
+    Chunk& claim(std::uint32_t key);
+
+    std::uint32_t key(int chunkX, int chunkY) const { return static_cast<std::uint32_t>(chunkY * m_chunkColumns + chunkX); }
+
+    std::shared_ptr<const MazeLayout> m_layout;
+    std::vector<std::uint8_t> m_eaten;   // per tile, 1 where a pellet is gone
+    int m_chunkColumns = 0;
+    int m_chunkRows = 0;
+
+    std::deque<Chunk> m_chunks;          // slots, searched in order; few enough to scan. A deque so a
+                                         // slot added past the cache never moves the others' buffers
+    std::uint64_t m_frame = 0;
+};
+
+#endif // MAZECHUNKS_H
@@ -0,0 +1,341 @@
+#include "MazeGenerator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+// the classic house: a 9x5 box with a 7x3 inside, in a ring of open corridor
+const int HOUSE_HALF_WIDTH = 4;
+const int HOUSE_HEIGHT = 5;
+const int ENERGIZER_SPACING = 16;   // cells between energizers in big mazes
+
+// mt19937's output is fixed by the standard; the std:: distributions are not
+class Random
+{
+public:
+    explicit Random(std::uint32_t seed) : m_engine(seed) {}
+
+    // uniform in [0, n)
+    std::uint32_t below(std::uint32_t n)
+    {
+        return static_cast<std::uint32_t>((static_cast<std::uint64_t>(m_engine()) * n) >> 32);
+    }
+
+private:
+    std::mt19937 m_engine;
+};
+
+// a tile grid where every write lands on both a tile and its left-right mirror
+class MirroredGrid
+{
+public:
+    MirroredGrid(int columns, int rows)
+        : m_columns(columns), m_rows(rows), m_tiles(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows), MazeLayout::Wall)
+    {
+    }
+
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+
+    std::uint8_t get(int x, int y) const { return m_tiles[index(x, y)]; }
+
+    void set(int x, int y, std::uint8_t tile)
+    {
+        m_tiles[index(x, y)] = tile;
+        m_tiles[index(m_columns - 1 - x, y)] = tile;
+    }
+
+    bool open(int x, int y) const { return get(x, y) == MazeLayout::Empty; }
+
+    // open neighbours, where the left and right edges meet through a tunnel
+    int exits(int x, int y) const
+    {
+        int count = 0;
+        count += y > 0 && open(x, y - 1);
+        count += y + 1 < m_rows && open(x, y + 1);
+        count += open(x > 0 ? x - 1 : m_columns - 1, y);
+        count += open(x + 1 < m_columns ? x + 1 : 0, y);
+        return count;
+    }
+
+    std::size_t index(int x, int y) const { return static_cast<std::size_t>(y) * static_cast<std::size_t>(m_columns) + static_cast<std::size_t>(x); }
+
+private:
+    int m_columns;
+    int m_rows;
+    std::vector<std::uint8_t> m_tiles;
+};
+
+// disjoint sets over cells, for the spanning tree
+class CellSets
+{
+public:
+    explicit CellSets(std::size_t count) : m_parent(count) { std::iota(m_parent.begin(), m_parent.end(), 0u); }
+
+    // join the sets of a and b; false if they were already one
+    bool unite(std::uint32_t a, std::uint32_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        m_parent[b] = a;
+        return true;
+    }
+
+private:
+    std::uint32_t find(std::uint32_t cell)
+    {
+        while (m_parent[cell] != cell) {
+            m_parent[cell] = m_parent[m_parent[cell]];
+            cell = m_parent[cell];
+        }
+        return cell;
+    }
+
+    std::vector<std::uint32_t> m_parent;
+};
+
+// a random spanning tree over the left half's cells, by Kruskal's algorithm;
+// cells sit at odd coordinates and the walls between them at one odd, one even
+void carveTree(MirroredGrid& grid, int half, int cellRows, Random& random)
+{
+    for (int j = 0; j < cellRows; ++j) {
+        for (int i = 0; i < half; ++i)
+            grid.set(2 * i + 1, 2 * j + 1, MazeLayout::Empty);
+    }
+
+    // bit 0 of an edge: 0 joins a cell to its right, 1 to the one below
+    std::vector<std::uint32_t> edges;
+    edges.reserve(static_cast<std::size_t>(half) * static_cast<std::size_t>(cellRows) * 2);
+    for (int j = 0; j < cellRows; ++j) {
+        for (int i = 0; i < half; ++i) {
+            std::uint32_t cell = static_cast<std::uint32_t>(j * half + i);
+            if (i + 1 < half)
+                edges.push_back(cell << 1);
+            if (j + 1 < cellRows)
+                edges.push_back((cell << 1) | 1u);
+        }
+    }
+    for (std::size_t k = edges.size(); k > 1; --k)
+        std::swap(edges[k - 1], edges[random.below(static_cast<std::uint32_t>(k))]);
+
+    CellSets sets(static_cast<std::size_t>(half) * static_cast<std::size_t>(cellRows));
+    for (std::uint32_t edge : edges) {
+        std::uint32_t cell = edge >> 1;
+        bool down = edge & 1u;
+        std::uint32_t other = down ? cell + static_cast<std::uint32_t>(half) : cell + 1;
+        if (!sets.unite(cell, other))
+            continue;
+        int i = static_cast<int>(cell) % half;
+        int j = static_cast<int>(cell) / half;
+        if (down)
+            grid.set(2 * i + 1, 2 * j + 2, MazeLayout::Empty);
+        else
+            grid.set(2 * i + 2, 2 * j + 1, MazeLayout::Empty);
+    }
+}
+
+// give every cell with a single way out a second one, through a random wall
+void braid(MirroredGrid& grid, int half, int cellRows, Random& random)
+{
+    static const int STEPS[4][2] = { { 0, -1 }, { -1, 0 }, { 0, 1 }, { 1, 0 } };
+    for (int j = 0; j < cellRows; ++j) {
+        for (int i = 0; i < half; ++i) {
+            int x = 2 * i + 1;
+            int y = 2 * j + 1;
+            if (grid.exits(x, y) > 1)
+                continue;
+
+            // closed walls with a cell behind them
+            int candidates[4];
+            int count = 0;
+            for (int d = 0; d < 4; ++d) {
+                int wallX = x + STEPS[d][0];
+                int wallY = y + STEPS[d][1];
+                int cellX = x + 2 * STEPS[d][0];
+                int cellY = y + 2 * STEPS[d][1];
+                if (cellX > 0 && cellX < grid.columns() - 1 && cellY > 0 && cellY < grid.rows() - 1 && !grid.open(wallX, wallY))
+                    candidates[count++] = d;
+            }
+            if (count == 0)
+                continue;
+            int d = candidates[random.below(static_cast<std::uint32_t>(count))];
+            grid.set(x + STEPS[d][0], y + STEPS[d][1], MazeLayout::Empty);
+        }
+    }
+}
+
+// wall up dead ends until none are left; what remains is still connected
+void fillDeadEnds(MirroredGrid& grid)
+{
+    std::vector<std::uint32_t> pending;
+    for (int y = 0; y < grid.rows(); ++y) {
+        for (int x = 0; x < grid.columns(); ++x) {
+            if (grid.open(x, y) && grid.exits(x, y) < 2)
+                pending.push_back(static_cast<std::uint32_t>(grid.index(x, y)));
+        }
+    }
+
+    while (!pending.empty()) {
+        std::uint32_t tile = pending.back();
+        pending.pop_back();
+        int x = static_cast<int>(tile % static_cast<std::uint32_t>(grid.columns()));
+        int y = static_cast<int>(tile / static_cast<std::uint32_t>(grid.columns()));
+        if (!grid.open(x, y) || grid.exits(x, y) >= 2)
+            continue;
+        grid.set(x, y, MazeLayout::Wall);
+
+        // the tile and its mirror are gone, so their neighbours may be dead ends now
+        for (int side = 0; side < 2; ++side) {
+            int cx = side == 0 ? x : grid.columns() - 1 - x;
+            const int around[4][2] = { { cx, y - 1 }, { cx, y + 1 }, { cx > 0 ? cx - 1 : grid.columns() - 1, y }, { cx + 1 < grid.columns() ? cx + 1 : 0, y } };
+            for (const auto& n : around) {
+                if (n[1] >= 0 && n[1] < grid.rows() && grid.open(n[0], n[1]))
+                    pending.push_back(static_cast<std::uint32_t>(grid.index(n[0], n[1])));
+            }
+        }
+    }
+}
+
+} // namespace
+
+namespace MazeGenerator {
+
+bool parseSide(const std::string& text, int& side)
+{
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0])))
+        return false;
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(text.c_str(), &end, 10);
+    if (*end != '\0' || value == 0)
+        return false;
+    // an out-of-range number is as much too big as MAX_SIDE + 1
+    if (errno == ERANGE)
+        value = static_cast<long>(MAX_SIDE) + 1;
+
+    side = static_cast<int>(std::clamp(value, static_cast<long>(MIN_SIDE), static_cast<long>(MAX_SIDE)));
+    if (side != value)
+        std::cerr << "Maze side " << text << " clamped to " << side << std::endl;
+    return true;
+}
+
+bool parseSize(const std::string& text, int& columns, int& rows)
+{
+    std::string::size_type x = text.find('x');
+    if (x == std::string::npos) {
+        if (!parseSide(text, columns))
+            return false;
+        rows = columns;
+        return true;
+    }
+    return parseSide(text.substr(0, x), columns) && parseSide(text.substr(x + 1), rows);
+}
+
+std::shared_ptr<const MazeLayout> generate(int columns, int rows, std::uint32_t seed)
+{
+    columns = std::clamp(columns, MIN_SIDE, MAX_SIDE);
+    rows = std::clamp(rows, MIN_SIDE, MAX_SIDE);
+
+    // carve at odd sizes, where cells and walls alternate; an even size is made
+    // by doubling the centre column or the top corridor afterwards
+    const int width = columns % 2 ? columns : columns - 1;
+    const int height = rows % 2 ? rows : rows - 1;
+    const int cellColumns = (width - 1) / 2;
+    const int cellRows = (height - 1) / 2;
+    const int half = (cellColumns + 1) / 2;   // the rest are mirrored
+    const int centre = width / 2;
+
+    Random random(seed);
+    MirroredGrid grid(width, height);
+    carveTree(grid, half, cellRows, random);
+
+    // with an even number of cell columns the halves meet across a wall column
+    if (cellColumns % 2 == 0) {
+        int doors = std::max(1, cellRows / 8);
+        for (int k = 0; k < doors; ++k)
+            grid.set(centre, 2 * static_cast<int>(random.below(static_cast<std::uint32_t>(cellRows))) + 1, MazeLayout::Empty);
+    }
+    braid(grid, half, cellRows, random);
+
+    // tunnels through the side walls; the cell inside is opened up and down so a
+    // ghost, which does not wrap, never has to turn back at the mouth
+    int tunnels = std::max(1, cellRows / 12);
+    for (int k = 0; k < tunnels; ++k) {
+        int y = 2 * (1 + static_cast<int>(random.below(static_cast<std::uint32_t>(cellRows - 2)))) + 1;
+        grid.set(0, y, MazeLayout::Empty);
+        grid.set(1, y - 1, MazeLayout::Empty);
+        grid.set(1, y + 1, MazeLayout::Empty);
+    }
+
+    // the ghost house, with its gate on top, in a ring of corridor that every path
+    // it cut through reconnects to
+    const int houseTop = (height - HOUSE_HEIGHT) / 2;
+    for (int y = houseTop - 1; y <= houseTop + HOUSE_HEIGHT; ++y) {
+        for (int x = centre - HOUSE_HALF_WIDTH - 1; x <= centre; ++x) {
+            bool box = y >= houseTop && y < houseTop + HOUSE_HEIGHT && x >= centre - HOUSE_HALF_WIDTH;
+            bool inside = box && y > houseTop && y < houseTop + HOUSE_HEIGHT - 1 && x > centre - HOUSE_HALF_WIDTH;
+            grid.set(x, y, inside ? MazeLayout::GhostHome : box ? MazeLayout::Wall : MazeLayout::Empty);
+        }
+    }
+    grid.set(centre, houseTop, MazeLayout::Gate);
+
+    fillDeadEnds(grid);
+
+    // dots on every corridor but the ring and the tunnel mouths
+    auto inRing = [&](int x, int y) {
+        return y >= houseTop - 1 && y <= houseTop + HOUSE_HEIGHT && std::abs(x - centre) <= HOUSE_HALF_WIDTH + 1;
+    };
+    for (int y = 0; y < height; ++y) {
+        for (int x = 1; x <= centre; ++x) {
+            if (grid.open(x, y) && !inRing(x, y))
+                grid.set(x, y, MazeLayout::Dot);
+        }
+    }
+
+    // energizers near the corners, as in the arcade, and spread through big mazes
+    auto energize = [&grid](int i, int j) {
+        int x = 2 * i + 1;
+        int y = 2 * j + 1;
+        if (grid.get(x, y) == MazeLayout::Dot)
+            grid.set(x, y, MazeLayout::Energizer);
+    };
+    energize(0, 1);
+    energize(0, cellRows - 2);
+    for (int j = ENERGIZER_SPACING / 2; j < cellRows; j += ENERGIZER_SPACING) {
+        for (int i = ENERGIZER_SPACING / 2; i < half; i += ENERGIZER_SPACING)
+            energize(i, j);
+    }
+
+    // copy out at the requested size
+    const bool wider = columns != width;
+    const bool taller = rows != height;
+    auto layout = std::make_shared<MazeLayout>();
+    layout->columns = columns;
+    layout->rows = rows;
+    layout->tiles.resize(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows));
+    for (int y = 0; y < rows; ++y) {
+        int fromY = taller && y >= 2 ? y - 1 : y;
+        for (int x = 0; x < columns; ++x) {
+            int fromX = wider && x > centre ? x - 1 : x;
+            layout->tiles[static_cast<std::size_t>(y) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(x)] = grid.get(fromX, fromY);
+        }
+    }
+
+    const int top = houseTop + (taller ? 1 : 0);
+    layout->pacStart = sf::Vector2i(centre, top + HOUSE_HEIGHT);
+    layout->ghostStarts = { { { centre, top + 2 }, { centre - 1, top + 2 }, { centre + 1, top + 2 }, { centre + 2, top + 2 } } };
+    layout->homeExit = sf::Vector2i(centre, 0);
+    return layout;
+}
+
+} // namespace MazeGenerator
@@ -0,0 +1,63 @@
+#ifndef MAZEGENERATOR_H
+#define MAZEGENERATOR_H
+
+#include "MazeLayout.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief seeded Pac-Man-style mazes of any size
+ * @details A maze is carved on a grid of one-tile corridors and one-tile walls: a
+ * random spanning tree over the left half, mirrored onto the right, then every dead
+ * end is given a second way out. A ghost house with a gate is set in the middle
+ * inside a ring of open corridor, tunnels are cut through the side walls, and any
+ * dead end left over is filled in, so every corridor tile has at least two open
+ * neighbours and all of them are connected. Corridors get dots, with energizers
+ * near the four corners and on a regular spread across larger mazes; the ring, the
+ * house and the tunnel mouths stay empty, and Pac-Man starts below the house.
+ *
+ * Everything runs in time proportional to the number of tiles, and random numbers
+ * are drawn without std:: distributions, so a seed gives the same maze on every
+ * platform.
+ */
+namespace MazeGenerator {
+
+constexpr int MIN_SIDE = 15;      // room for the house, its ring and the border
+constexpr int MAX_SIDE = 16384;   // keeps tile indices well inside 32 bits
+
+/**
+ * @brief build a maze
+ *
+ * @param columns width in tiles, clamped to [MIN_SIDE, MAX_SIDE]
+ * @param rows height in tiles, clamped likewise
+ * @param seed any value; equal seeds and sizes give equal mazes
+ * @return std::shared_ptr<const MazeLayout> the maze, mirrored left to right
+ */
+std::shared_ptr<const MazeLayout> generate(int columns, int rows, std::uint32_t seed);
+
+/**
+ * @brief read one side of a maze from the command line or a settings file
+ * @details A side outside [MIN_SIDE, MAX_SIDE] is clamped, saying so on stderr.
+ *
+ * @param text a whole number above 0 and nothing else
+ * @param side set to the side generate() will use
+ * @return false if the text is not such a number
+ */
+bool parseSide(const std::string& text, int& side);
+
+/**
+ * @brief read a maze size written "WxH", or one number for a square maze
+ * @details Sides are clamped as by parseSide().
+ *
+ * @param text the size
+ * @param columns set to the width
+ * @param rows set to the height
+ * @return false if the text is not a size
+ */
+bool parseSize(const std::string& text, int& columns, int& rows);
+
+} // namespace MazeGenerator
+
+#endif // MAZEGENERATOR_H
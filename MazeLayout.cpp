@@ -0,0 +1,102 @@
+#include "MazeLayout.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+// written only by setCustom(), before the game starts
+std::shared_ptr<const MazeLayout> s_custom;
+
+} // namespace
+
+std::vector<std::vector<int>> MazeLayout::grid() const
+{
+    std::vector<std::vector<int>> grid(static_cast<std::size_t>(rows));
+    for (int row = 0; row < rows; ++row) {
+        auto first = tiles.begin() + static_cast<std::ptrdiff_t>(row) * columns;
+        grid[static_cast<std::size_t>(row)].assign(first, first + columns);
+    }
+    return grid;
+}
+
+std::shared_ptr<const MazeLayout> MazeLayout::loadText(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open maze file: " << path << std::endl;
+        return nullptr;
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    std::size_t width = 0;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        width = std::max(width, line.size());
+        lines.push_back(line);
+    }
+    while (!lines.empty() && lines.back().empty())
+        lines.pop_back();
+
+    auto layout = std::make_shared<MazeLayout>();
+    layout->columns = static_cast<int>(width);
+    layout->rows = static_cast<int>(lines.size());
+    layout->tiles.assign(width * lines.size(), Empty);
+
+    int ghosts = 0;
+    bool pacman = false;
+    bool gate = false;
+    for (int row = 0; row < layout->rows; ++row) {
+        const std::string& text = lines[static_cast<std::size_t>(row)];
+        for (int column = 0; column < static_cast<int>(text.size()); ++column) {
+            Tile tile = Empty;
+            switch (text[static_cast<std::size_t>(column)]) {
+            case '#': tile = Wall; break;
+            case '.': tile = Dot; break;
+            case 'o': tile = Energizer; break;
+            case '=': tile = GhostHome; break;
+            case '-':
+                tile = Gate;
+                if (!gate)
+                    layout->homeExit = sf::Vector2i(column, 0);
+                gate = true;
+                break;
+            case 'G':
+                tile = GhostHome;
+                if (ghosts < 4)
+                    layout->ghostStarts[static_cast<std::size_t>(ghosts++)] = sf::Vector2i(column, row);
+                break;
+            case 'P':
+                layout->pacStart = sf::Vector2i(column, row);
+                pacman = true;
+                break;
+            default:
+                break;
+            }
+            layout->tiles[static_cast<std::size_t>(row) * width + static_cast<std::size_t>(column)] = tile;
+        }
+    }
+
+    if (!pacman || ghosts == 0 || !gate) {
+        std::cerr << "Maze file " << path << " needs a 'P', at least one 'G' and a '-' gate" << std::endl;
+        return nullptr;
+    }
+    for (int i = ghosts; i < 4; ++i)
+        layout->ghostStarts[static_cast<std::size_t>(i)] = layout->ghostStarts[static_cast<std::size_t>(ghosts - 1)];
+
+    return layout;
+}
+
+const std::shared_ptr<const MazeLayout>& MazeLayout::custom()
+{
+    return s_custom;
+}
+
+void MazeLayout::setCustom(std::shared_ptr<const MazeLayout> layout)
+{
+    s_custom = std::move(layout);
+}
@@ -0,0 +1,77 @@
+#ifndef MAZELAYOUT_H
+#define MAZELAYOUT_H
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief a maze built from tiles rather than the arcade map image, of any size
+ * @details Tiles use the game's usual codes, stored row-major. A layout never
+ * changes once built, so snapshots hand it to the render thread by pointer;
+ * pellets eaten since are reported separately by a PelletLog. A layout larger than
+ * the screen scrolls, with the camera following Pac-Man.
+ */
+struct MazeLayout
+{
+    static constexpr int TILE_SIZE = 24;   // layout units per tile, in every maze
+
+    enum Tile : std::uint8_t
+    {
+        Empty,
+        Wall,
+        Dot,
+        Energizer,
+        GhostHome,
+        Gate
+    };
+
+    int columns = 0;
+    int rows = 0;
+    std::vector<std::uint8_t> tiles;            // rows * columns tile codes
+    sf::Vector2i pacStart;
+    std::array<sf::Vector2i, 4> ghostStarts;    // Blinky, Pinky, Inky, Clyde
+    sf::Vector2i homeExit;                      // what ghosts in the house aim for to get out
+
+    /**
+     * @brief tile code at a column and row, which must be inside the maze
+     */
+    std::uint8_t at(int column, int row) const
+    {
+        return tiles[static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(column)];
+    }
+
+    /**
+     * @brief the tiles as the [row][column] grid Player and Ghost walk on
+     */
+    std::vector<std::vector<int>> grid() const;
+
+    /**
+     * @brief read a maze from a text file, one line per row
+     * @details '#' is a wall, '.' a dot, 'o' an energizer, '-' a ghost gate, '=' the
+     * ghost house, 'G' a ghost's start in the house (Blinky's first, then Pinky's,
+     * Inky's and Clyde's; missing ones share the last) and 'P' Pac-Man's start;
+     * anything else is empty. Short rows are padded with empty tiles. Ghosts leave
+     * the house by aiming at the top row above its first gate.
+     *
+     * @param path maze file
+     * @return std::shared_ptr<const MazeLayout> the maze, or null after printing why not
+     */
+    static std::shared_ptr<const MazeLayout> loadText(const std::string& path);
+
+    /**
+     * @brief the maze every round is played in instead of the arcade's, or null
+     */
+    static const std::shared_ptr<const MazeLayout>& custom();
+
+    /**
+     * @brief play every round from now on in layout; call before the game starts
+     */
+    static void setCustom(std::shared_ptr<const MazeLayout> layout);
+};
+
+#endif // MAZELAYOUT_H
@@ -0,0 +1,122 @@
+#include "MazeView.h"
+#include "FrameBuffer.h"
+#include "PelletLog.h"
+#include "ResourceCache.h"
+
+#include <cstring>
+
+void MazeView::update(const FrameSnapshot::MazeLayer& maze)
+{
+    if (!m_created) {
+        // stored at native resolution, like the frame it is composited into
+        m_created = m_background.create(FrameBuffer::NATIVE_WIDTH, FrameBuffer::NATIVE_HEIGHT, FrameBuffer::layoutView());
+        m_hudGlyphs = &ResourceCache::glyphs("assets/fonts/PixelGaming.ttf", 40);
+        m_hudBatch.setTexture(m_hudGlyphs->texture());
+        m_hudBatch.reserve(32);
+        m_lifeTexture = &ResourceCache::texture("assets/sprites/pacmanspritesheet.png");
+    }
+
+    if (maze.generation != m_generation)
+        repaint(maze);
+
+    // pellets eaten since the last frame drawn, usually none or one
+    if (maze.pellets) {
+        for (; m_pelletsShown < maze.pelletsEaten; ++m_pelletsShown) {
+            std::size_t index = (*maze.pellets)[m_pelletsShown];
+            if (maze.layout)
+                m_chunks.eat(index);
+            else
+                eraseTile(maze, index);
+        }
+    }
+
+    // the HUD only changes when the score does
+    if (maze.score != m_score || maze.highScore != m_highScore || maze.lives != m_lives)
+        paintHud(maze);
+
+    m_background.commit();
+}
+
+void MazeView::repaint(const FrameSnapshot::MazeLayer& maze)
+{
+    sf::Vector2u layout = FrameBuffer::layoutSize();
+    m_background.fill(sf::FloatRect(0.f, 0.f, static_cast<float>(layout.x), static_cast<float>(layout.y)), sf::Color::Black);
+
+    if (maze.texture) {
+        sf::Sprite map(*maze.texture);
+        map.setScale(maze.scale, maze.scale);
+        map.setPosition(maze.position);
+        m_background.paint(map);
+    }
+
+    // a layout's tiles are drawn chunk by chunk over the layer
+    m_chunks.reset(maze.layout);
+
+    m_generation = maze.generation;
+    m_pelletsShown = 0;
+    m_score = -1;
+}
+
+sf::View MazeView::cameraView(const FrameSnapshot::MazeLayer& maze)
+{
+    sf::Vector2f layout(FrameBuffer::layoutSize());
+    sf::View view(maze.camera);
+    view.setViewport(sf::FloatRect(maze.position.x / layout.x, maze.position.y / layout.y, maze.camera.width / layout.x, maze.camera.height / layout.y));
+    return view;
+}
+
+void MazeView::eraseTile(const FrameSnapshot::MazeLayer& maze, std::size_t index)
+{
+    if (maze.columns == 0)
+        return;
+    float row = static_cast<float>(index / maze.columns);
+    float col = static_cast<float>(index % maze.columns);
+
+    // slightly oversized so no pellet edge survives scaling
+    float tileX = maze.position.x + col * maze.tileSize.x - 1.f;
+    float tileY = maze.position.y + row * maze.tileSize.y - 1.f;
+    m_background.fill(sf::FloatRect(tileX, tileY, maze.tileSize.x + 2.f, maze.tileSize.y + 2.f), sf::Color::Black);
+}
+
+void MazeView::paintHud(const FrameSnapshot::MazeLayer& maze)
+{
+    char text[32];
+    std::size_t length;
+    m_hudBatch.clear();
+
+    // 1-UP (player score, top-left)
+    std::memcpy(text, "1UP\n ", 5);
+    length = 5 + GlyphAtlas::formatInt(maze.score, text + 5);
+    m_hudGlyphs->append(m_hudBatch, text, length, sf::Vector2f(10.f, 10.f), 1.f, sf::Color::White);
+
+    // HIGH (centered on the window, top edge at y = 10)
+    std::memcpy(text, "HIGH\n ", 6);
+    length = 6 + GlyphAtlas::formatInt(maze.highScore, text + 6);
+    sf::FloatRect b = m_hudGlyphs->bounds(text, length);
+    float cx = static_cast<float>(FrameBuffer::layoutSize().x) / 2.f;
+    m_hudGlyphs->append(m_hudBatch, text, length, sf::Vector2f(cx - (b.left + b.width / 2.f), 10.f - b.top), 1.f, sf::Color::White);
+
+    // everything above the maze belongs to the HUD
+    m_background.fill(sf::FloatRect(0.f, 0.f, static_cast<float>(FrameBuffer::layoutSize().x), maze.position.y), sf::Color::Black);
+    m_background.paint(m_hudBatch);
+
+    // lives sprites …
+    sf::Sprite life(*m_lifeTexture, sf::IntRect(13, 0, 13, 13));
+    // at the native size and on whole native pixels, like the actors in the maze
+    const float pixel = static_cast<float>(FrameBuffer::LAYOUT_SCALE);
+    life.setScale(pixel, pixel);
+    for (int i = 0; i < maze.lives && i < 3; i++) {
+        life.setPosition(600.f - static_cast<float>(i) * 16.f * pixel, 12.f * pixel);
+        m_background.paint(life);
+    }
+
+    m_score = maze.score;
+    m_highScore = maze.highScore;
+    m_lives = maze.lives;
+}
+
+void MazeView::draw(CountedTarget& target) const
+{
+    // maze, eaten pellets and HUD in one quad
+    m_background.draw(target);
+}
@@ -0,0 +1,89 @@
+#ifndef MAZEVIEW_H
+#define MAZEVIEW_H
+
+#include "BackgroundLayer.h"
+#include "CountedTarget.h"
+#include "FrameSnapshot.h"
+#include "GlyphAtlas.h"
+#include "MazeChunks.h"
+#include "SpriteBatch.h"
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief the render thread's cached picture of the maze, eaten pellets and HUD
+ * @details Snapshots carry the maze as plain values; update() compares them with
+ * what is already painted and patches the background layer only where they differ:
+ * a newly eaten pellet is one black tile, a new score repaints the HUD band, and a
+ * new maze generation repaints everything. A maze from a layout scrolls instead:
+ * the layer keeps only the HUD, and drawChunks() draws the part of the maze under
+ * the camera. Render thread only.
+ */
+class MazeView
+{
+public:
+    /**
+     * @brief bring the painted layer up to date with a snapshot
+     *
+     * @param maze maze layer from the snapshot being drawn; generation must be non-zero
+     */
+    void update(const FrameSnapshot::MazeLayer& maze);
+
+    /**
+     * @brief draw the scrolling maze's visible chunks, for a snapshot with a layout
+     *
+     * @param target target whose view is cameraView() of the same snapshot
+     * @param maze maze layer passed to update() this frame
+     */
+    void drawChunks(CountedTarget& target, const FrameSnapshot::MazeLayer& maze) { m_chunks.draw(target, maze.camera); }
+
+    /**
+     * @brief view that shows the maze layer's camera area in its place on screen
+     *
+     * @param maze maze layer with a layout
+     * @return sf::View view over layout coordinates, clipped to the maze area
+     */
+    static sf::View cameraView(const FrameSnapshot::MazeLayer& maze);
+
+    /**
+     * @brief draw the painted maze, pellets and HUD
+     *
+     * @param target target in layout coordinates
+     */
+    void draw(CountedTarget& target) const;
+
+private:
+    /**
+     * @brief paint the bare maze for a new generation
+     */
+    void repaint(const FrameSnapshot::MazeLayer& maze);
+
+    /**
+     * @brief black out one eaten pellet
+     *
+     * @param index row-major tile index
+     */
+    void eraseTile(const FrameSnapshot::MazeLayer& maze, std::size_t index);
+
+    /**
+     * @brief repaint the score, high score and lives above the maze
+     */
+    void paintHud(const FrameSnapshot::MazeLayer& maze);
+
+    BackgroundLayer m_background;
+    bool m_created = false;
+    std::uint32_t m_generation = 0;
+    std::size_t m_pelletsShown = 0;      // entries of the pellet log already applied
+    MazeChunks m_chunks;
+
+    const GlyphAtlas* m_hudGlyphs = nullptr;
+    SpriteBatch m_hudBatch;
+    const sf::Texture* m_lifeTexture = nullptr;   // looked up once; the lookup builds a string
+    int m_score = -1;                    // HUD values last painted
+    int m_highScore = -1;
+    int m_lives = -1;
+};
+
+#endif // MAZEVIEW_H
@@ -0,0 +1,90 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+struct Descriptor
+{
+    const char* name;
+    const char* help;
+};
+
+const Descriptor COUNTERS[] = {
+    { "pacman_sim_ticks_total", "Simulation ticks run." },
+    { "pacman_frames_rendered_total", "Frames drawn and presented." },
+    { "pacman_draw_calls_total", "Draw calls issued by the render thread." },
+    { "pacman_texture_loads_total", "Textures loaded from disk." },
+    { "pacman_score_writes_total", "Durable writes to the score files." },
+    { "pacman_sim_allocations_total", "Heap allocations made by sim ticks, when counted." },
+    { "pacman_render_allocations_total", "Heap allocations made by rendered frames, when counted." },
+};
+
+const Descriptor GAUGES[] = {
+    { "pacman_level", "Level being played." },
+};
+
+const Descriptor HISTOGRAMS[] = {
+    { "pacman_update_microseconds", "Time to handle input for and update one sim tick." },
+    { "pacman_render_microseconds", "Time to draw and present one frame." },
+};
+
+static_assert(std::size(COUNTERS) == static_cast<std::size_t>(Metrics::Counter::Count), "a counter is missing its descriptor");
+static_assert(std::size(GAUGES) == static_cast<std::size_t>(Metrics::Gauge::Count), "a gauge is missing its descriptor");
+static_assert(std::size(HISTOGRAMS) == static_cast<std::size_t>(Metrics::Histogram::Count), "a histogram is missing its descriptor");
+
+void writeHeader(std::ostream& out, const Descriptor& metric, const char* type)
+{
+    out << "# HELP " << metric.name << ' ' << metric.help << '\n';
+    out << "# TYPE " << metric.name << ' ' << type << '\n';
+}
+
+} // namespace
+
+Metrics& Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+void Metrics::observe(Histogram histogram, std::uint64_t micros)
+{
+    Timings& timings = m_histograms[static_cast<std::size_t>(histogram)];
+    std::size_t bucket = static_cast<std::size_t>(std::lower_bound(BUCKETS.begin(), BUCKETS.end(), micros) - BUCKETS.begin());
+    timings.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    timings.sum.fetch_add(micros, std::memory_order_relaxed);
+}
+
+void Metrics::write(std::ostream& out) const
+{
+    for (std::size_t i = 0; i < m_counters.size(); ++i) {
+        writeHeader(out, COUNTERS[i], "counter");
+        out << COUNTERS[i].name << ' ' << m_counters[i].load(std::memory_order_relaxed) << '\n';
+    }
+    for (std::size_t i = 0; i < m_gauges.size(); ++i) {
+        writeHeader(out, GAUGES[i], "gauge");
+        out << GAUGES[i].name << ' ' << m_gauges[i].load(std::memory_order_relaxed) << '\n';
+    }
+
+    out << "# HELP pacman_state Screen the game is on.\n";
+    out << "# TYPE pacman_state gauge\n";
+    out << "pacman_state{state=\"" << m_state.load(std::memory_order_relaxed) << "\"} 1\n";
+
+    for (std::size_t i = 0; i < m_histograms.size(); ++i) {
+        const Timings& timings = m_histograms[i];
+        const char* name = HISTOGRAMS[i].name;
+        writeHeader(out, HISTOGRAMS[i], "histogram");
+
+        // buckets are stored apart and summed here, so +Inf always equals the count
+        std::uint64_t total = 0;
+        for (std::size_t b = 0; b < BUCKETS.size(); ++b) {
+            total += timings.buckets[b].load(std::memory_order_relaxed);
+            out << name << "_bucket{le=\"" << BUCKETS[b] << "\"} " << total << '\n';
+        }
+        total += timings.buckets[BUCKETS.size()].load(std::memory_order_relaxed);
+        out << name << "_bucket{le=\"+Inf\"} " << total << '\n';
+        out << name << "_sum " << timings.sum.load(std::memory_order_relaxed) << '\n';
+        out << name << "_count " << total << '\n';
+    }
+}
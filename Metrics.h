@@ -0,0 +1,106 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief process-wide counters, gauges and timing histograms for health checks
+ * @details Every metric is a fixed slot of relaxed atomics, so updating one from
+ * the sim or render thread is a single uncontended add: no lock, no allocation,
+ * and nothing a reader can hold up. write() reads the slots from any thread and
+ * formats them as Prometheus text; MetricsServer serves that on a local socket.
+ */
+class Metrics
+{
+public:
+    enum class Counter
+    {
+        SimTicks,
+        FramesRendered,
+        DrawCalls,
+        TextureLoads,
+        ScoreWrites,
+        SimAllocations,      // heap allocations in sim ticks, with --count-allocations
+        RenderAllocations,   // and in the render thread's frames
+        Count
+    };
+
+    enum class Gauge
+    {
+        Level,
+        Count
+    };
+
+    enum class Histogram
+    {
+        UpdateMicros,   // one sim tick's handleEvents and update
+        RenderMicros,   // drawing and presenting one frame
+        Count
+    };
+
+    // upper bounds of the histogram buckets, in microseconds; one more catches the rest
+    static constexpr std::array<std::uint32_t, 9> BUCKETS = { 100, 250, 500, 1000, 2000, 4000, 8000, 16667, 33333 };
+
+    /**
+     * @brief get the process-wide registry
+     */
+    static Metrics& instance();
+
+    /**
+     * @brief add to a counter
+     */
+    void add(Counter counter, std::uint64_t amount = 1)
+    {
+        m_counters[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief set a gauge
+     */
+    void set(Gauge gauge, std::int64_t value)
+    {
+        m_gauges[static_cast<std::size_t>(gauge)].store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief record one timing
+     *
+     * @param histogram which one
+     * @param micros duration in microseconds
+     */
+    void observe(Histogram histogram, std::uint64_t micros);
+
+    /**
+     * @brief name the state the game is in
+     *
+     * @param name a string literal, e.g. from GameState::name()
+     */
+    void setState(const char* name) { m_state.store(name, std::memory_order_relaxed); }
+
+    /**
+     * @brief write every metric in Prometheus text format
+     *
+     * @param out stream to write to
+     */
+    void write(std::ostream& out) const;
+
+private:
+    Metrics() = default;
+
+    struct Timings
+    {
+        std::array<std::atomic<std::uint64_t>, BUCKETS.size() + 1> buckets{};
+        std::atomic<std::uint64_t> sum{ 0 };
+    };
+
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::Count)> m_counters{};
+    std::array<std::atomic<std::int64_t>, static_cast<std::size_t>(Gauge::Count)> m_gauges{};
+    std::array<Timings, static_cast<std::size_t>(Histogram::Count)> m_histograms{};
+    std::atomic<const char*> m_state{ "none" };
+};
+
+#endif // METRICS_H
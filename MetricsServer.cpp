@@ -0,0 +1,184 @@
+#include "MetricsServer.h"
+#include "Metrics.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+#ifdef _WIN32
+
+bool MetricsServer::start(const std::string& address)
+{
+    std::cerr << "Metrics endpoint is not available on this platform: " << address << std::endl;
+    return false;
+}
+
+void MetricsServer::stop()
+{
+}
+
+void MetricsServer::run()
+{
+}
+
+void MetricsServer::answer(int)
+{
+}
+
+#else
+
+namespace {
+
+// how often the idle server looks at m_running, and how long a client gets
+const int POLL_MILLIS = 250;
+const int CLIENT_MILLIS = 200;
+
+} // namespace
+
+bool MetricsServer::start(const std::string& address)
+{
+    if (m_running)
+        return true;
+
+    // all digits is a port, anything else a socket path
+    bool isPort = !address.empty() && address.find_first_not_of("0123456789") == std::string::npos;
+    if (isPort) {
+        // 0 would bind a random port nobody knows to scrape
+        long port = std::strtol(address.c_str(), nullptr, 10);
+        if (port < 1 || port > 65535) {
+            std::cerr << "Metrics port must be 1-65535, not " << address << std::endl;
+            return false;
+        }
+        m_listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        ::setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(static_cast<std::uint16_t>(port));
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (m_listener < 0 || ::bind(m_listener, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            std::cerr << "Failed to bind metrics port " << address << ": " << std::strerror(errno) << std::endl;
+            stop();
+            return false;
+        }
+    }
+    else {
+        sockaddr_un local{};
+        if (address.size() >= sizeof(local.sun_path)) {
+            std::cerr << "Metrics socket path too long: " << address << std::endl;
+            return false;
+        }
+        m_listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        local.sun_family = AF_UNIX;
+        std::memcpy(local.sun_path, address.c_str(), address.size() + 1);
+        // a socket left behind by a crashed run would block the bind
+        ::unlink(address.c_str());
+        if (m_listener < 0 || ::bind(m_listener, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            std::cerr << "Failed to bind metrics socket " << address << ": " << std::strerror(errno) << std::endl;
+            stop();
+            return false;
+        }
+        m_socketPath = address;
+    }
+
+    if (::listen(m_listener, 4) != 0) {
+        std::cerr << "Failed to listen for metrics: " << std::strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::thread(&MetricsServer::run, this);
+    return true;
+}
+
+void MetricsServer::stop()
+{
+    if (m_running) {
+        m_running = false;
+        m_thread.join();
+    }
+    if (m_listener >= 0) {
+        ::close(m_listener);
+        m_listener = -1;
+    }
+    if (!m_socketPath.empty()) {
+        ::unlink(m_socketPath.c_str());
+        m_socketPath.clear();
+    }
+}
+
+void MetricsServer::run()
+{
+#ifdef __linux__
+    // only runs when the game's threads leave a core idle
+    sched_param idle{};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &idle);
+#endif
+
+    while (m_running.load(std::memory_order_acquire)) {
+        pollfd listener{ m_listener, POLLIN, 0 };
+        if (::poll(&listener, 1, POLL_MILLIS) <= 0)
+            continue;
+        int client = ::accept(m_listener, nullptr, nullptr);
+        if (client < 0)
+            continue;
+        answer(client);
+        ::close(client);
+    }
+}
+
+void MetricsServer::answer(int client)
+{
+    // a client that never reads cannot keep the server stuck in send()
+    timeval timeout{ 0, CLIENT_MILLIS * 1000 };
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // the request itself does not matter; read what has arrived so closing the
+    // socket does not reset it, and answer raw connections too
+    pollfd request{ client, POLLIN, 0 };
+    if (::poll(&request, 1, CLIENT_MILLIS) > 0) {
+        char discard[1024];
+        ::recv(client, discard, sizeof(discard), 0);
+    }
+
+    std::ostringstream body;
+    Metrics::instance().write(body);
+    std::string text = body.str();
+
+    std::ostringstream response;
+    response << "HTTP/1.0 200 OK\r\n"
+             << "Content-Type: text/plain; version=0.0.4\r\n"
+             << "Content-Length: " << text.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << text;
+    std::string reply = response.str();
+
+    std::size_t sent = 0;
+    while (sent < reply.size()) {
+        ssize_t n = ::send(client, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            break;
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+#endif
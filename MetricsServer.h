@@ -0,0 +1,45 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * @brief serves Metrics as Prometheus text on a local socket
+ * @details Listens on a Unix domain socket, or on a TCP port bound to 127.0.0.1,
+ * and answers every connection with one plain HTTP response holding the current
+ * metrics, so both `curl` and a Prometheus scraper can read it. The work happens on
+ * a thread of its own at the lowest scheduling priority; the game threads only
+ * ever touch the metrics' atomics, so a slow or stuck client cannot hold them up.
+ * Not available on Windows.
+ */
+class MetricsServer
+{
+public:
+    ~MetricsServer();
+
+    /**
+     * @brief start listening
+     *
+     * @param address a port number for 127.0.0.1, 1-65535, or a Unix socket path
+     * @return true if the socket is listening; false for a port out of range
+     */
+    bool start(const std::string& address);
+
+    /**
+     * @brief stop listening and remove the Unix socket, if any
+     */
+    void stop();
+
+private:
+    void run();
+    void answer(int client);
+
+    int m_listener = -1;
+    std::string m_socketPath;   // Unix socket to remove on stop
+    std::thread m_thread;
+    std::atomic<bool> m_running{ false };
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,234 @@
+#include "PelletBoard.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+int popcount(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1)
+        ++count;
+    return count;
+#endif
+}
+
+int highestBit(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(word);
+#else
+    int bit = 63;
+    while (!(word >> bit))
+        --bit;
+    return bit;
+#endif
+}
+
+int countWords(const std::vector<std::uint64_t>& words)
+{
+    int count = 0;
+    for (std::uint64_t w : words)
+        count += popcount(w);
+    return count;
+}
+
+// bits from..63 of a word
+std::uint64_t bitsFrom(int from)
+{
+    return ~std::uint64_t(0) << from;
+}
+
+// bits 0..to of a word
+std::uint64_t bitsTo(int to)
+{
+    return to >= 63 ? ~std::uint64_t(0) : (std::uint64_t(1) << (to + 1)) - 1;
+}
+
+} // namespace
+
+PelletBoard::PelletBoard(int columns, int rows)
+    : m_columns(std::max(columns, 0))
+    , m_rows(std::max(rows, 0))
+    , m_stride((static_cast<std::size_t>(m_columns) + 63) / 64)
+    , m_dots(m_stride * static_cast<std::size_t>(m_rows), 0)
+    , m_energizers(m_dots.size(), 0)
+    , m_pristineDots(m_dots.size(), 0)
+    , m_pristineEnergizers(m_dots.size(), 0)
+{
+}
+
+int PelletBoard::lowestBit(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!((word >> bit) & 1))
+        ++bit;
+    return bit;
+#endif
+}
+
+void PelletBoard::add(sf::Vector2i tile, Kind kind)
+{
+    if (!inside(tile) || kind == Kind::None)
+        return;
+    std::size_t word = wordOf(tile);
+    std::uint64_t bit = std::uint64_t(1) << (tile.x % 64);
+    if ((m_pristineDots[word] | m_pristineEnergizers[word]) & bit)
+        return;
+    std::vector<std::uint64_t>& board = kind == Kind::Dot ? m_dots : m_energizers;
+    std::vector<std::uint64_t>& pristine = kind == Kind::Dot ? m_pristineDots : m_pristineEnergizers;
+    board[word] |= bit;
+    pristine[word] |= bit;
+    ++m_laidOut;
+    ++m_left;
+}
+
+PelletBoard::Kind PelletBoard::at(sf::Vector2i tile) const
+{
+    if (!inside(tile))
+        return Kind::None;
+    std::size_t word = wordOf(tile);
+    std::uint64_t bit = std::uint64_t(1) << (tile.x % 64);
+    if (m_dots[word] & bit)
+        return Kind::Dot;
+    if (m_energizers[word] & bit)
+        return Kind::Energizer;
+    return Kind::None;
+}
+
+PelletBoard::Kind PelletBoard::eat(sf::Vector2i tile)
+{
+    Kind kind = at(tile);
+    if (kind != Kind::None) {
+        std::uint64_t keep = ~(std::uint64_t(1) << (tile.x % 64));
+        m_dots[wordOf(tile)] &= keep;
+        m_energizers[wordOf(tile)] &= keep;
+        --m_left;
+    }
+    return kind;
+}
+
+void PelletBoard::reset()
+{
+    // same sizes, so these copy in place
+    m_dots = m_pristineDots;
+    m_energizers = m_pristineEnergizers;
+    m_left = countWords(m_dots) + countWords(m_energizers);
+}
+
+int PelletBoard::remaining(Kind kind) const
+{
+    if (kind == Kind::Dot)
+        return countWords(m_dots);
+    if (kind == Kind::Energizer)
+        return countWords(m_energizers);
+    return 0;
+}
+
+int PelletBoard::countRow(int row, int first, int last) const
+{
+    std::size_t base = static_cast<std::size_t>(row) * m_stride;
+    std::size_t firstWord = base + static_cast<std::size_t>(first / 64);
+    std::size_t lastWord = base + static_cast<std::size_t>(last / 64);
+    if (firstWord == lastWord)
+        return popcount(pellets(firstWord) & bitsFrom(first % 64) & bitsTo(last % 64));
+
+    int count = popcount(pellets(firstWord) & bitsFrom(first % 64));
+    for (std::size_t w = firstWord + 1; w < lastWord; ++w)
+        count += popcount(pellets(w));
+    return count + popcount(pellets(lastWord) & bitsTo(last % 64));
+}
+
+int PelletBoard::countWithin(sf::Vector2i centre, int radius) const
+{
+    if (radius < 0)
+        return 0;
+    if (m_columns == 0 || m_rows == 0)
+        return 0;
+    // any further than the farthest corner covers the whole maze; the centre may be outside it
+    const std::int64_t cx = centre.x;
+    const std::int64_t cy = centre.y;
+    std::int64_t farthest = std::max(std::abs(cx), std::abs(cx - (m_columns - 1))) + std::max(std::abs(cy), std::abs(cy - (m_rows - 1)));
+    radius = static_cast<int>(std::min<std::int64_t>(radius, farthest));
+
+    int count = 0;
+    int top = std::max(centre.y - radius, 0);
+    int bottom = std::min(centre.y + radius, m_rows - 1);
+    for (int y = top; y <= bottom; ++y) {
+        // the diamond narrows by a column each side for every row away from the centre
+        int span = radius - std::abs(y - centre.y);
+        int first = std::max(centre.x - span, 0);
+        int last = std::min(centre.x + span, m_columns - 1);
+        if (first <= last)
+            count += countRow(y, first, last);
+    }
+    return count;
+}
+
+int PelletBoard::nearestInRow(int row, int column, int limit) const
+{
+    int first = std::max(column - limit, 0);
+    int last = std::min(column + limit, m_columns - 1);
+    if (first > last)
+        return -1;
+    std::size_t base = static_cast<std::size_t>(row) * m_stride;
+
+    // the first pellet at or right of the column
+    int right = -1;
+    for (int c = std::max(column, first); c <= last; c = (c / 64 + 1) * 64) {
+        std::uint64_t word = pellets(base + static_cast<std::size_t>(c / 64)) & bitsFrom(c % 64);
+        if (word != 0) {
+            int found = c / 64 * 64 + lowestBit(word);
+            if (found <= last)
+                right = found;
+            break;
+        }
+    }
+
+    // the first pellet left of it, searching no further than the right one
+    int leftLimit = right >= 0 ? std::max(column - (right - column), first) : first;
+    int left = -1;
+    for (int c = std::min(column - 1, last); c >= leftLimit; c = c / 64 * 64 - 1) {
+        std::uint64_t word = pellets(base + static_cast<std::size_t>(c / 64)) & bitsTo(c % 64);
+        if (word != 0) {
+            int found = c / 64 * 64 + highestBit(word);
+            if (found >= leftLimit)
+                left = found;
+            break;
+        }
+    }
+
+    // a tie goes left
+    return left >= 0 ? left : right;
+}
+
+bool PelletBoard::nearest(sf::Vector2i from, sf::Vector2i& found) const
+{
+    int best = INT_MAX / 2;
+    for (int d = 0; d < best && (from.y - d >= 0 || from.y + d < m_rows); ++d) {
+        // the upper row first, so it wins a tie
+        for (int side = 0; side < (d == 0 ? 1 : 2); ++side) {
+            int y = side == 0 ? from.y - d : from.y + d;
+            if (y < 0 || y >= m_rows)
+                continue;
+            // only a strictly nearer pellet beats the best so far
+            int column = nearestInRow(y, from.x, best - d - 1);
+            if (column < 0)
+                continue;
+            int distance = d + std::abs(column - from.x);
+            if (distance < best) {
+                best = distance;
+                found = sf::Vector2i(column, y);
+            }
+        }
+    }
+    return best < INT_MAX / 2;
+}
@@ -0,0 +1,151 @@
+#ifndef PELLETBOARD_H
+#define PELLETBOARD_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief which pellets a maze still holds, one bit per tile
+ * @details Dots and energizers are each a bitboard: every row starts on a fresh
+ * 64-bit word, so a tile is one shift and mask away and a run of columns is a few
+ * masked words. Eating or testing a tile is O(1), the count left is a popcount of
+ * the words, kept up to date as pellets go so the sim can ask every tick, and
+ * putting a level back is a copy of the pristine boards taken as the maze was
+ * laid out. Queries over an area (pellets within N tiles, the nearest
+ * pellet) work a word at a time, 64 columns per step, for bots and analytics that
+ * ask them many times a tick. The size is fixed when the board is made; nothing
+ * allocates afterwards.
+ */
+class PelletBoard
+{
+public:
+    enum class Kind : std::uint8_t
+    {
+        None,
+        Dot,
+        Energizer
+    };
+
+    /**
+     * @brief a board for no maze at all
+     */
+    PelletBoard() = default;
+
+    /**
+     * @brief an empty board for a maze of the given size
+     */
+    PelletBoard(int columns, int rows);
+
+    /**
+     * @brief lay out a pellet; it becomes part of what reset() restores
+     * @details A tile already laid out keeps the pellet it has.
+     *
+     * @param tile column and row, inside the maze
+     * @param kind Dot or Energizer
+     */
+    void add(sf::Vector2i tile, Kind kind);
+
+    /**
+     * @brief what lies on a tile now; None outside the maze
+     */
+    Kind at(sf::Vector2i tile) const;
+
+    /**
+     * @brief take whatever lies on a tile
+     *
+     * @return Kind what was there; None if nothing was, or outside the maze
+     */
+    Kind eat(sf::Vector2i tile);
+
+    /**
+     * @brief put back every pellet add() laid out
+     */
+    void reset();
+
+    /**
+     * @brief pellets left, dots and energizers together
+     */
+    int remaining() const { return m_left; }
+
+    /**
+     * @brief pellets of one kind left, counted afresh
+     */
+    int remaining(Kind kind) const;
+
+    /**
+     * @brief pellets eaten since the board was laid out or last reset
+     */
+    int eaten() const { return m_laidOut - m_left; }
+
+    /**
+     * @brief pellets no more than radius tiles away, counted along rows and columns
+     * @details Tunnels are not followed; distance is |dx| + |dy| across the grid.
+     * The centre may lie outside the maze.
+     */
+    int countWithin(sf::Vector2i centre, int radius) const;
+
+    /**
+     * @brief the pellet fewest tiles away, counted along rows and columns
+     * @details Ties go to the nearer row, then to the upper row, then to the left.
+     *
+     * @param from where to measure from
+     * @param found set to the pellet's tile if there is one
+     * @return true if any pellet is left
+     */
+    bool nearest(sf::Vector2i from, sf::Vector2i& found) const;
+
+    /**
+     * @brief call fn(tile) for every eaten pellet, in row-major order
+     */
+    template <class Fn>
+    void forEachEaten(Fn&& fn) const
+    {
+        for (std::size_t i = 0; i < m_dots.size(); ++i) {
+            std::uint64_t gone = (m_pristineDots[i] & ~m_dots[i]) | (m_pristineEnergizers[i] & ~m_energizers[i]);
+            while (gone != 0) {
+                int bit = lowestBit(gone);
+                gone &= gone - 1;
+                fn(sf::Vector2i(static_cast<int>(i % m_stride) * 64 + bit, static_cast<int>(i / m_stride)));
+            }
+        }
+    }
+
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+
+private:
+    static int lowestBit(std::uint64_t word);
+
+    bool inside(sf::Vector2i tile) const
+    {
+        return tile.x >= 0 && tile.y >= 0 && tile.x < m_columns && tile.y < m_rows;
+    }
+
+    std::size_t wordOf(sf::Vector2i tile) const
+    {
+        return static_cast<std::size_t>(tile.y) * m_stride + static_cast<std::size_t>(tile.x) / 64;
+    }
+
+    // both kinds of pellet in one word of a row
+    std::uint64_t pellets(std::size_t word) const { return m_dots[word] | m_energizers[word]; }
+
+    // pellets in columns first..last of a row, both inside the maze
+    int countRow(int row, int first, int last) const;
+
+    // the pellet column in a row closest to column, no further than limit; -1 if none
+    int nearestInRow(int row, int column, int limit) const;
+
+    int m_columns = 0;
+    int m_rows = 0;
+    std::size_t m_stride = 0;   // words per row
+    int m_laidOut = 0;          // pellets in the pristine boards
+    int m_left = 0;             // pellets in the current ones
+    std::vector<std::uint64_t> m_dots;
+    std::vector<std::uint64_t> m_energizers;
+    std::vector<std::uint64_t> m_pristineDots;
+    std::vector<std::uint64_t> m_pristineEnergizers;
+};
+
+#endif // PELLETBOARD_H
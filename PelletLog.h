@@ -0,0 +1,51 @@
+#ifndef PELLETLOG_H
+#define PELLETLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief the pellets eaten in one maze, in the order they went
+ * @details Sized for every pellet up front and only appended to, so an entry never
+ * moves or changes once written. The simulation appends; each snapshot records how
+ * many entries it covers and the render thread reads no further, so both share the
+ * log without locking and the render side only looks at what is new.
+ */
+class PelletLog
+{
+public:
+    /**
+     * @brief make room for every pellet the maze holds
+     *
+     * @param capacity pellets in the maze, eaten or not
+     */
+    explicit PelletLog(std::size_t capacity) : m_entries(capacity) {}
+
+    /**
+     * @brief record an eaten pellet; simulation thread only
+     *
+     * @param index row-major tile index
+     */
+    void push(std::uint32_t index)
+    {
+        if (m_size < m_entries.size())
+            m_entries[m_size++] = index;
+    }
+
+    /**
+     * @brief entries written so far; simulation thread only
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief one entry, below a count a published snapshot recorded
+     */
+    std::uint32_t operator[](std::size_t i) const { return m_entries[i]; }
+
+private:
+    std::vector<std::uint32_t> m_entries;
+    std::size_t m_size = 0;
+};
+
+#endif // PELLETLOG_H
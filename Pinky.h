@@ -13,7 +13,7 @@ public:
      * @param moveSpeed Speed of Pinky
      * @param mapPos Position of the map
      * @param level Current level of the game
-     * @details Initializes Pinky's position, speed, and animation. Calls the Ghost constructor to set m_pos, m_moveSpeed, etc.
+     * @details Initializes Pinky's position, speed, and animation. Calls the Ghost constructor to set the mover, speed, etc.
      */
     Pinky(sf::Vector2i startPos, float moveSpeed, sf::Vector2f mapPos, int level);
     
@@ -24,25 +24,16 @@ public:
     ~Pinky() = default;
 
     /**
-     * @brief Calculates the target tile for Pinky based on the player's position and direction.
-     * @param playerPos Position of the player
-     * @param playerDirection Direction of the player
-     * @return Target tile for Pinky
+     * @brief Targets four tiles ahead of Pac-Man; scatters to the top-left corner.
      */
-    sf::Vector2i calculateTarget(sf::Vector2i playerPos, sf::Vector2i playerDirection);
+    using Personality = Targeting::Speedy;
 
     /**
      * @brief Renders Pinky on the window.
-     * @param window Reference to the SFML window
+     * @param frame Snapshot to record into
      * @details Draws Pinky's sprite on the window. If debug mode is enabled, draws additional debug information.
      */
-    void render(sf::RenderWindow& window);
-
-    /**
-     * @brief Toggles debug mode.
-     * @details If debug mode is enabled, additional debug information is drawn on the window.
-     */
-    void toggleDebug() { m_debug = !m_debug; }
+    void render(FrameSnapshot& frame);
 
 private:
     /**
@@ -50,9 +41,6 @@ private:
      * @details Loads the texture and sets up the animation frames for Pinky.
      */
     void initAnimation();
-    sf::Vector2i m_targetTile;
-    bool m_debug = false;
-
 };
 
 #endif // PINKY_H
@@ -1,44 +1,51 @@
 #include "Player.h"
+#include "FrameBuffer.h"
 #include "PlayingState.h"
+#include "LatencyProbe.h"
 #include <iostream>
 
 Player::Player(sf::Vector2i startPos, sf::Vector2f mapPos)
-    : m_gridPos(startPos)
-    , m_targetPos(startPos)
-    , m_mapPos(mapPos)
+    : m_mover(startPos)
 {
     // Initialize sprite animation
     initAnimations();
 
-    m_moveSpeed = 0.f;
-    // Position the sprite at the start tile
-    m_animation.setPosition(
-        static_cast<float>(startPos.x) * static_cast<float>(m_tileSize.x) + m_animation.getLocalBounds().width + m_mapPos.x,
-        static_cast<float>(startPos.y) * static_cast<float>(m_tileSize.y) + m_animation.getLocalBounds().height + m_mapPos.y
+    // The sprite is drawn one frame width in from the tile corner
+    m_pixelOrigin = sf::Vector2f(
+        m_animation.getLocalBounds().width + mapPos.x,
+        m_animation.getLocalBounds().height + mapPos.y
     );
 
     m_animation.play();
 }
 
-void Player::handleEvents()
+void Player::handleEvents(const Input& input)
 {
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-        m_queuedDirection = { 0, -1 };
-        //std::cout << "up is pressed" << '\n';
-    }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
-        m_queuedDirection = { 0, 1 };
-        //std::cout << "Down is pressed" << '\n';
-    }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
-        m_queuedDirection = { -1, 0 };
-        //std::cout << "Left is pressed" << '\n';
-    }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
-        m_queuedDirection = { 1, 0 };
-        //std::cout << "Right is pressed" << '\n';
-    }
+    // presses are handled in the order they happened, so the latest one wins
+    for (const InputEvent& e : input.events()) {
+        if (e.type != InputEvent::Type::KeyPressed)
+            continue;
 
+        if (e.key == sf::Keyboard::W || e.key == sf::Keyboard::Up) {
+            m_queuedDirection = { 0, -1 };
+        }
+        else if (e.key == sf::Keyboard::S || e.key == sf::Keyboard::Down) {
+            m_queuedDirection = { 0, 1 };
+        }
+        else if (e.key == sf::Keyboard::A || e.key == sf::Keyboard::Left) {
+            m_queuedDirection = { -1, 0 };
+        }
+        else if (e.key == sf::Keyboard::D || e.key == sf::Keyboard::Right) {
+            m_queuedDirection = { 1, 0 };
+        }
+        else {
+            continue;
+        }
+
+        m_queuedPressTime = e.time;
+        m_turnPending = true;
+        LatencyProbe::instance().pressDelivered(e.time);
+    }
 }
 
 void Player::update(sf::Time dt)
@@ -47,81 +54,80 @@ void Player::update(sf::Time dt)
     m_animation.update(dt);
 
     // If we’re not currently moving between tiles.......
-    if (!m_isMoving)
+    if (!m_mover.moving())
     {
         // Check if queued direction is valid; if so, include it
-        if (isValidMove(m_gridPos + m_queuedDirection))
+        if (isValidMove(m_mover.tile() + m_queuedDirection))
         {
+            // only a change of direction counts as a turn for the latency probe
+            if (m_turnPending && m_queuedDirection != m_currentDirection)
+                LatencyProbe::instance().turnApplied(m_queuedPressTime);
+            m_turnPending = false;
             m_currentDirection = m_queuedDirection;
         }
 
         // Attempt to move one tile in the current direction
-        sf::Vector2i newTarget = m_gridPos + m_currentDirection;
-        if (isValidMove(newTarget))
+        if (isValidMove(m_mover.tile() + m_currentDirection))
         {
-            m_targetPos = newTarget;
-            m_isMoving = true;
-            m_moveProgress = 0.f;
+            m_mover.start(m_currentDirection);
+            m_tileEvent = true;
             updateRotation();
         }
-    }
-
-    // If we are moving between tiles, interpolate sprite position
-    if (m_isMoving)
-    {
-        // Use dt.asSeconds() to scale movement by real time
-        m_moveProgress += m_moveSpeed * dt.asSeconds();
-
-        // Once we surpass 1.0, we’ve finished moving to the next tile
-        if (m_moveProgress >= 1.0f)
+        else
         {
-            m_gridPos = m_targetPos;
-            m_moveProgress = 0.f;
-            m_isMoving = false;
-
-            // Wrap the player’s position if it went off the grid
-            if (!m_mapVector.empty() && !m_mapVector[0].empty())
-            {
-                int mapWidth = static_cast<int>(m_mapVector[0].size());
-
-                if (m_gridPos.x < 0) {
-                    m_gridPos.x = mapWidth - 1;
-                }
-                else if (m_gridPos.x >= mapWidth) {
-                    m_gridPos.x = 0;
-                }
-            }
+            m_mover.halt();
         }
+    }
 
-        sf::Vector2f offset(
-            m_animation.getLocalBounds().width + m_mapPos.x,
-            m_animation.getLocalBounds().height + m_mapPos.y
-        );
+    // Once we reach the next tile, wrap the player’s position if it went off the grid
+    if (!m_mover.step())
+        return;
+    m_tileEvent = true;
 
-        // Interpolate between the old tile (m_gridPos) and the new tile (m_targetPos)
-        sf::Vector2f start(static_cast<float>(m_gridPos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-            static_cast<float>(m_gridPos.y) * static_cast<float>(m_tileSize.y) + offset.y);
-        sf::Vector2f end(static_cast<float>(m_targetPos.x) * static_cast<float>(m_tileSize.x) + offset.x,
-            static_cast<float>(m_targetPos.y) * static_cast<float>(m_tileSize.y) + offset.y);
+    if (!m_mapVector.empty() && !m_mapVector[0].empty())
+    {
+        int mapWidth = static_cast<int>(m_mapVector[0].size());
 
-        sf::Vector2f interpolatedPos = start + (end - start) * m_moveProgress;
-        m_animation.setPosition(interpolatedPos);
+        if (m_mover.tile().x < 0) {
+            m_mover.wrapTo({ mapWidth - 1, m_mover.tile().y });
+        }
+        else if (m_mover.tile().x >= mapWidth) {
+            m_mover.wrapTo({ 0, m_mover.tile().y });
+        }
     }
 }
 
-void Player::render(sf::RenderWindow& window)
+void Player::render(FrameSnapshot& frame)
 {
-    window.draw(m_animation);
+    // Tile progress only becomes pixels here
+    m_animation.setPosition(m_mover.pixel(m_pixelOrigin, m_tileSize));
+    m_animation.render(frame);
 }
 
 void Player::setMap(const std::vector<std::vector<int>>& map)
 {
     m_mapVector = map;
+    m_tileEvent = true;
+}
+
+bool Player::takeTileEvent()
+{
+    bool happened = m_tileEvent;
+    m_tileEvent = false;
+    return happened;
 }
 
 sf::Vector2i Player::getPlayerPos()
 {
-    return m_gridPos;
+    return m_mover.tile();
+}
+
+sf::FloatRect Player::getHitBox() const
+{
+    // The sprite is centred on its origin, so its bounds sit around the mover's pixel
+    sf::FloatRect bounds = m_animation.getGlobalBounds();
+    sf::Vector2f centre = m_mover.pixel(m_pixelOrigin, m_tileSize);
+    return sf::FloatRect(centre.x - bounds.width / 2.f, centre.y - bounds.height / 2.f, bounds.width, bounds.height);
 }
 
 void Player::initAnimations()
@@ -146,8 +152,8 @@ void Player::initAnimations()
     sf::FloatRect pacBounds = m_animation.getLocalBounds();
     m_animation.setOrigin(pacBounds.width / 2.f, pacBounds.height / 2.f);
 
-    // Scale PacMan to be bigger
-    float sizeScale = 2.4f;
+    // Arcade size: a texel for every native pixel
+    const float sizeScale = static_cast<float>(FrameBuffer::LAYOUT_SCALE);
     m_animation.setScale(sizeScale, sizeScale);
     m_animation.setRotation(180);
 }
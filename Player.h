@@ -2,6 +2,9 @@
 #define PLAYER_H
 
 #include "AnimatedSprite.h"
+#include "Input.h"
+#include "MazeLayout.h"
+#include "TileMover.h"
 
 #include <SFML/Graphics.hpp>
 
@@ -23,21 +26,22 @@ public:
     ~Player() = default;
 
     /**
-     * @brief Handle events for the player
+     * @brief Queue a turn from this tick's direction key presses
+     * @param input Keyboard events for the current tick
      */
-    void handleEvents();
+    void handleEvents(const Input& input);
 
     /**
-     * @brief Update the player's position
-     * @param dt Time since last update
+     * @brief Move the player one simulation tick
+     * @param dt Length of the tick, for the animation; movement is per tick
      */
     void update(sf::Time dt);
 
     /**
      * @brief Render the player on the window
-     * @param window Reference to the SFML window
+     * @param frame Snapshot to record into
      */
-    void render(sf::RenderWindow& window);
+    void render(FrameSnapshot& frame);
 
     /**
      * @brief Set the map for the player
@@ -47,9 +51,9 @@ public:
 
     /**
      * @brief Set the player's speed
-     * @param speed The speed of the player
+     * @param perTick Fixed-point step per tick, see TileMover::speedPerTick
      */
-    void setSpeed(const float speed) { m_moveSpeed = speed; }
+    void setSpeed(TileMover::Fixed perTick) { m_mover.setSpeed(perTick); }
 
     /**
      * @brief Get the player's direction
@@ -63,12 +67,20 @@ public:
      */
     sf::Vector2i getPlayerPos();
 
+    /**
+     * @brief Whether Pac-Man set off or arrived somewhere since the last call
+     * @details Between those moments the tile under him and the one ahead stay
+     * the same, so the pellet and speed checks would find what they found before.
+     * @return true once after every start, arrival or new map
+     */
+    bool takeTileEvent();
+
     /**
      * @brief Get the Hit Box object
      * 
      * @return sf::FloatRect of the animated sprite
      */
-    sf::FloatRect getHitBox() const { return m_animation.getGlobalBounds(); }
+    sf::FloatRect getHitBox() const;
 
 private:
     /**
@@ -91,16 +103,14 @@ private:
 
     AnimatedSprite m_animation;
 
-    const sf::Vector2i m_tileSize{ 24, 24 };
-    sf::Vector2i m_gridPos;       // Current tile
-    sf::Vector2i m_targetPos;     // Target tile
+    const sf::Vector2f m_tileSize{ static_cast<float>(MazeLayout::TILE_SIZE), static_cast<float>(MazeLayout::TILE_SIZE) };
+    TileMover m_mover;            // Current tile and progress towards the next
     sf::Vector2i m_currentDirection{ -1, 0 };
     sf::Vector2i m_queuedDirection{ -1, 0 };
-    sf::Vector2f m_mapPos;        // Map position
-
-    bool m_isMoving = false;
-    float m_moveSpeed;
-    float m_moveProgress = 0.f;
+    sf::Time m_queuedPressTime;       // when the key behind m_queuedDirection was pressed
+    bool m_turnPending = false;       // that press has not turned Pac-Man yet
+    bool m_tileEvent = true;          // started or arrived since takeTileEvent() last looked
+    sf::Vector2f m_pixelOrigin;   // Where the sprite sits on tile (0, 0)
 
     // The map layout:
     std::vector<std::vector<int>> m_mapVector;
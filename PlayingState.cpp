@@ -3,72 +3,116 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
-#include <fstream>
 
+#include "AudioEngine.h"
 #include "MainMenuState.h"
 #include "Player.h"
 #include "EndGameState.h"
+#include "FrameBuffer.h"
+#include "Metrics.h"
+#include "ResourceCache.h"
+#include "ScoreStore.h"
+#include "Telemetry.h"
 
-PlayingState::PlayingState(StateManager& stateManager, const sf::RenderWindow& window, int lives, int level, int score, std::vector<std::vector<int>> mapVector, std::vector<std::vector<bool>> blackTiles)
-    : m_level(level)
+namespace {
+
+const char* const MAP_PATH = "assets/map/map.png";
+const char* const SPRITE_SHEET = "assets/sprites/pacmanspritesheet.png";   // Pac-Man's and the ghosts'
+const char* const PAUSED_FONT = "assets/fonts/pacfont.ttf";
+const unsigned int PAUSED_SIZE = 40;
+
+// a scrolling maze starts where the arcade map does, leaving the HUD its band
+const float SCROLL_TOP = 120.f;
+
+// the pause before each round, while the maze is shown and nothing moves
+const float START_DELAY_SECONDS = 1.5f;
+
+// how long play stands still after each of these
+const float GHOST_EATEN_FREEZE_SECONDS = 0.2f;
+const float DEATH_FREEZE_SECONDS = 1.f;
+const float LEVEL_CLEAR_FREEZE_SECONDS = 1.f;
+
+} // namespace
+
+void PlayingState::preload()
+{
+    ResourceCache::texture(MAP_PATH);
+    ResourceCache::texture(SPRITE_SHEET);
+    ResourceCache::glyphs(PAUSED_FONT, PAUSED_SIZE);
+}
+
+PlayingState::PlayingState(StateManager& stateManager, const sf::RenderWindow& window, int lives, int level, int score, std::vector<std::vector<int>> mapVector, PelletBoard pellets)
+    : m_layout(MazeLayout::custom())
+    , m_level(level)
     , m_lives(lives)
+    , m_params(LevelTable::get(level))
     , m_score(score)
     , m_stateManager(stateManager)
     , m_window(window)
 {
     // 0 = empty, 1 = wall, 2 = dot, 3 = big dot, 4 = ghost home, 5 = ghost gate!!!
 
-    initScoreText();
-    initModeTimers(level);
-    initPlayerSpeeds(level);
-    if (!m_mapTexture.loadFromFile("assets/map/map.png")) {
-        std::cerr << "Failed to load map image: assets/map/map.png" << std::endl;
-    }
-    m_mapSprite.setTexture(m_mapTexture);
+    m_highScore = readHighScore();
+    Metrics::instance().set(Metrics::Gauge::Level, m_level);
+    m_normalSpeed = LevelParams::BASE_TILES_PER_SECOND * m_params.pacSpeed;
+    m_normalStep = TileMover::speedPerTick(m_normalSpeed);
+    m_eatingStep = TileMover::speedPerTick(LevelParams::BASE_TILES_PER_SECOND * m_params.pacEatingSpeed);
 
-    // Get the window width and height
-    sf::Vector2u windowSize = m_window.getSize();
+    // Set up grid spacing and offset
+    m_gridSpacing.x = MazeLayout::TILE_SIZE;
+    m_gridSpacing.y = MazeLayout::TILE_SIZE;
+    m_offset.x = 0.f;
+    m_offset.y = 0.f;
 
-    // Get the sprite's local bounds (original size)
-    sf::FloatRect spriteBounds = m_mapSprite.getLocalBounds();
+    // a layout is placed at the origin of its own coordinates; the camera puts it on screen
+    sf::Vector2f mapPos;
+    if (!m_layout) {
+        m_mapSprite.setTexture(ResourceCache::texture(MAP_PATH));
 
-    // Calculate the scaling factor to fit the window's width while preserving aspect ratio
-    float scaleFactor = static_cast<float>(windowSize.x) / spriteBounds.width;
-    m_mapSprite.setScale(scaleFactor, scaleFactor);
+        // Get the layout width and height
+        sf::Vector2u windowSize = FrameBuffer::layoutSize();
 
-    // Adjust the sprite's position so its bottom aligns with the bottom of the window
-    float scaledHeight = spriteBounds.height * scaleFactor;
-    m_mapSprite.setPosition(0.f, static_cast<float>(windowSize.y) - scaledHeight);
+        // Get the sprite's local bounds (original size)
+        sf::FloatRect spriteBounds = m_mapSprite.getLocalBounds();
 
-    // std::cout << "offsetx: " << m_mapSprite.getPosition().x << '\n';
-    // std::cout << "offsety: " << m_mapSprite.getPosition().y << '\n';
+        // Calculate the scaling factor to fit the window's width while preserving aspect ratio
+        float scaleFactor = static_cast<float>(windowSize.x) / spriteBounds.width;
+        m_mapSprite.setScale(scaleFactor, scaleFactor);
 
-    // Set up grid spacing and offset
-    m_gridSpacing.x = 24.f;
-    m_gridSpacing.y = 24.f;
-    m_offset.x = 0.f;
-    m_offset.y = 0.f;
+        // Adjust the sprite's position so its bottom aligns with the bottom of the window
+        float scaledHeight = spriteBounds.height * scaleFactor;
+        m_mapSprite.setPosition(0.f, static_cast<float>(windowSize.y) - scaledHeight);
+
+        mapPos = m_mapSprite.getPosition();
+    }
 
-    sf::Vector2f mapPos = m_mapSprite.getPosition();
+    sf::Vector2i pacStart = m_layout ? m_layout->pacStart : sf::Vector2i{ 13, 23 };
+    std::array<sf::Vector2i, 4> ghostStarts = m_layout ? m_layout->ghostStarts
+        : std::array<sf::Vector2i, 4>{ { { 13, 14 }, { 12, 14 }, { 14, 14 }, { 15, 14 } } };
 
-    m_pacman = std::make_unique<Player>(sf::Vector2i{ 13, 23 }, mapPos);
-    m_blinky = std::make_unique<Blinky>(sf::Vector2i{ 13, 14 }, m_normalSpeed, mapPos, level);
-    m_pinky = std::make_unique<Pinky>(sf::Vector2i{ 12, 14 }, m_normalSpeed, mapPos, level);
-    m_inky = std::make_unique<Inky>(sf::Vector2i{ 14, 14 }, m_normalSpeed, mapPos, level);
-    m_clyde = std::make_unique<Clyde>(sf::Vector2i{ 15, 14 }, m_normalSpeed, mapPos, level);
+    m_pacman = std::make_unique<Player>(pacStart, mapPos);
+    m_ghosts.spawn<Blinky>(ghostStarts[0], m_normalSpeed, mapPos, level);
+    m_ghosts.spawn<Pinky>(ghostStarts[1], m_normalSpeed, mapPos, level);
+    m_ghosts.spawn<Inky>(ghostStarts[2], m_normalSpeed, mapPos, level);
+    m_ghosts.spawn<Clyde>(ghostStarts[3], m_normalSpeed, mapPos, level);
 
-    m_blinky->setMode(Ghost::Mode::Scatter);
-    m_pinky->setMode(Ghost::Mode::Scatter);
-    m_inky->setMode(Ghost::Mode::Scatter);
-    m_clyde->setMode(Ghost::Mode::Scatter);
+    m_ghosts.forEach([](Ghost& ghost) { ghost.setMode(Ghost::Mode::Scatter); });
+    if (m_layout)
+        m_ghosts.forEach([this](Ghost& ghost) { ghost.setMazeRules(m_layout->homeExit, false); });
 
     if (!mapVector.empty()) {
         m_mapVector = std::move(mapVector);
-        m_blackTiles = std::move(blackTiles);
+        m_pelletBoard = std::move(pellets);
+    }
+    else if (m_layout) {
+        m_mapVector = m_layout->grid();
     }
     else {
         analyzeGridCells();
@@ -77,111 +121,229 @@ PlayingState::PlayingState(StateManager& stateManager, const sf::RenderWindow& w
 
     initLevel();
 
-    m_timer.restart();
+    // every construction lays the maze out again, so the render side repaints it
+    static std::uint32_t s_lastGeneration = 0;
+    m_mazeGeneration = ++s_lastGeneration;
+
+    m_startTimer = m_timers.add([this] { startRound(); });
+    m_phaseTimer = m_timers.add([this] { nextPhase(); });
+    m_frightTimer = m_timers.add([this] { m_ghosts.forEach([](Ghost& ghost) { ghost.endFrightened(); }); });
+    m_blinkTimer = m_timers.add([this] { m_ghosts.forEach([](Ghost& ghost) { ghost.startBlinking(); }); });
+    m_timers.start(m_startTimer, TimerWheel::ticksFor(START_DELAY_SECONDS));
+    m_freezeTimer = m_freezeTimers.add([this] { m_frozen = false; });
+
+    m_pausedText.setGlyphs(ResourceCache::glyphs(PAUSED_FONT, PAUSED_SIZE));
+    m_pausedText.setString("Paused");
+    m_pausedText.setColor(sf::Color::Yellow);
 }
 
-void PlayingState::handleEvents(sf::RenderWindow& window)
+void PlayingState::handleEvents(sf::RenderWindow& window, const Input& input)
 {
     if (window.isOpen()) {
-        if ([&]() { static bool wasSpacePressed = false; bool isSpacePressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Period); bool released = wasSpacePressed && !isSpacePressed; wasSpacePressed = isSpacePressed; return released; }()) {
-            m_pinky->toggleDebug();
-            m_blinky->toggleDebug();
-            m_inky->toggleDebug();
-            m_clyde->toggleDebug();
+        if (input.pressed(sf::Keyboard::Period)) {
+            m_ghosts.forEach([](Ghost& ghost) { ghost.toggleDebug(); });
         }
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
+        if (input.pressed(sf::Keyboard::Space)) {
             m_stateManager.changeState(std::make_unique<MainMenuState>(m_stateManager, m_window));
             return;
         }
 
-        m_pacman->handleEvents();
+        if (input.pressed(sf::Keyboard::P)) {
+            togglePause();
+        }
+
+        // turns pressed while paused are not kept for later
+        if (!m_paused) {
+            m_pacman->handleEvents(input);
+        }
     }
 }
 
-void PlayingState::update(sf::Time dt)
+void PlayingState::togglePause()
 {
-    if (!m_modeTimerActive) {
-        if (m_timer.getElapsedTime().asSeconds() > 1.5f) {
-            m_pacman->setMap(m_mapVector);
-            m_blinky->setMap(m_mapVector);
-            m_pinky->setMap(m_mapVector);
-            m_inky->setMap(m_mapVector);
-            m_clyde->setMap(m_mapVector);
-            m_modeTimerActive = true;
-            m_timer.restart();
-        }
+    m_paused = !m_paused;
+    if (m_paused) {
+        AudioEngine::instance().stopLoop();
     }
-    else {
-        sf::Time phaseLimit = m_inScatter ? m_scatterTimers[m_phaseIndex] : m_chaseTimers[m_phaseIndex];
+    // a death or a cleared level has already silenced the round for good
+    else if (m_roundStarted && !(m_frozen && m_freeze != Freeze::GhostEaten)) {
+        bool frightened = m_ghosts.any([](Ghost& ghost) { return ghost.getMode() == Ghost::Mode::Frightened; });
+        AudioEngine::instance().loop(frightened ? Sound::Frightened : Sound::Siren);
+    }
+}
 
-        if (phaseLimit != sf::Time::Zero && m_timer.getElapsedTime() >= phaseLimit) {
-            m_inScatter = !m_inScatter;
-            m_timer.restart();
+void PlayingState::startRound()
+{
+    m_pacman->setMap(m_mapVector);
+    m_ghosts.forEach([this](Ghost& ghost) { ghost.setMap(m_mapVector); });
+    m_roundStarted = true;
+    AudioEngine::instance().setSirenPitch(sirenPitch());
+    AudioEngine::instance().loop(Sound::Siren);
+    Telemetry::instance().record(Telemetry::Event::RoundStart, m_level, m_pacman->getPlayerPos(), m_lives);
+    startPhase();
+}
+
+void PlayingState::startPhase()
+{
+    float seconds = m_inScatter ? m_params.scatterSeconds[m_phaseIndex] : m_params.chaseSeconds[m_phaseIndex];
+    if (seconds > 0.f) {
+        m_timers.start(m_phaseTimer, TimerWheel::ticksFor(seconds));
+    }
+}
+
+void PlayingState::nextPhase()
+{
+    m_inScatter = !m_inScatter;
 
-            Ghost::Mode newMode = m_inScatter ? Ghost::Mode::Scatter : Ghost::Mode::Chase;
+    Ghost::Mode newMode = m_inScatter ? Ghost::Mode::Scatter : Ghost::Mode::Chase;
 
-            m_blinky->setMode(newMode);
-            m_pinky->setMode(newMode);
-            m_inky->setMode(newMode);
-            m_clyde->setMode(newMode);
+    m_ghosts.forEach([newMode](Ghost& ghost) { ghost.setMode(newMode); });
+    Telemetry::instance().record(Telemetry::Event::ModeChange, m_level, m_pacman->getPlayerPos(), m_phaseIndex,
+        Telemetry::NO_GHOST, static_cast<std::uint8_t>(newMode));
 
-            if (!m_inScatter && m_phaseIndex < 3) {
-                ++m_phaseIndex;
+    if (!m_inScatter && m_phaseIndex < 3) {
+        ++m_phaseIndex;
+    }
+    startPhase();
+}
+
+void PlayingState::update(sf::Time dt)
+{
+    // a paused round does not tick, so no timer runs down and nothing moves
+    if (m_paused) {
+        return;
+    }
+
+    // a frozen round only counts down the freeze; the round's own timers stand still
+    if (m_frozen) {
+        m_freezeTimers.tick();
+        if (m_frozen)
+            return;
+        // what the freeze was for happens once it is over, as the last thing this state does
+        if (m_freeze == Freeze::Death) {
+            if (m_lives == 1) {
+                m_stateManager.changeState(std::make_unique<EndGameState>(m_stateManager, m_window, m_score));
+            }
+            else {
+                m_stateManager.changeState(std::make_unique<PlayingState>(m_stateManager, m_window, --m_lives, m_level, m_score, m_mapVector, m_pelletBoard));
             }
         }
+        else if (m_freeze == Freeze::LevelClear) {
+            m_level++;
+            // the same maze again with every pellet back, without laying it out anew
+            PelletBoard pellets = m_pelletBoard;
+            pellets.reset();
+            m_stateManager.changeState(std::make_unique<PlayingState>(m_stateManager, m_window, m_lives, m_level, m_score, m_mapVector, std::move(pellets)));
+        }
+        return;
     }
-
-    m_blinky->update(dt, m_blinky->calculateTarget(m_pacman->getPlayerPos()));
-    m_pinky->update(dt, m_pinky->calculateTarget(m_pacman->getPlayerPos(), m_pacman->getDirection()));
-    m_inky->update(dt, m_inky->calculateTarget(m_pacman->getPlayerPos(), m_pacman->getDirection(), m_blinky->getPos()));
-    m_clyde->update(dt, m_clyde->calculateTarget(m_pacman->getPlayerPos()));
+    m_timers.tick();
+
+    // one context for every ghost's targeting this tick
+    TargetContext ctx;
+    ctx.playerTile = m_pacman->getPlayerPos();
+    ctx.playerDirection = m_pacman->getDirection();
+    const Blinky* blinky = m_ghosts.first<Blinky>();
+    ctx.blinkyTile = blinky ? blinky->getPos() : ctx.playerTile;
+    ctx.mazeSize = sf::Vector2i(m_mapVector.empty() ? 0 : static_cast<int>(m_mapVector[0].size()), static_cast<int>(m_mapVector.size()));
+    m_ghosts.update(dt, ctx);
     m_pacman->update(dt);
-    updateMap(m_mapVector);
+    // the pellet under Pac-Man and the tile ahead only change when he sets off or arrives
+    if (m_pacman->takeTileEvent())
+        updateMap(m_mapVector);
 
     if (checkDeath()) {
-        sf::sleep(sf::seconds(1));
-        if (m_lives == 1) {
-            m_stateManager.changeState(std::make_unique<EndGameState>(m_stateManager, m_window, m_score));
-        }
-        else {
-            m_stateManager.changeState(std::make_unique<PlayingState>(m_stateManager, m_window, --m_lives, m_level, m_score, m_mapVector, m_blackTiles));
-        }
+        // the siren is off for good: no frightened time may run out and bring it back
+        m_timers.stop(m_frightTimer);
+        m_timers.stop(m_blinkTimer);
+        freeze(Freeze::Death, DEATH_FREEZE_SECONDS);
+        return;
     }
 
-    if (m_remainingPellets <= 0) {
-        sf::sleep(sf::seconds(1));
-        m_level++;
-        m_stateManager.changeState(std::make_unique<PlayingState>(m_stateManager, m_window, m_lives, m_level, m_score));
+    if (m_pelletBoard.remaining() == 0) {
+        Telemetry::instance().record(Telemetry::Event::LevelClear, m_level, m_pacman->getPlayerPos(), m_score);
+        AudioEngine::instance().stopLoop();
+        m_timers.stop(m_frightTimer);
+        m_timers.stop(m_blinkTimer);
+        freeze(Freeze::LevelClear, LEVEL_CLEAR_FREEZE_SECONDS);
     }
 }
 
-void PlayingState::render(sf::RenderWindow& window)
+void PlayingState::freeze(Freeze reason, float seconds)
 {
-    // Draw the map sprite first.
-    window.draw(m_mapSprite);
+    m_freeze = reason;
+    m_frozen = true;
+    m_freezeTimers.start(m_freezeTimer, TimerWheel::ticksFor(seconds));
+}
 
-    drawBlackTiles(window);
+void PlayingState::render(FrameSnapshot& frame)
+{
+    // maze, eaten pellets and HUD as values; MazeView paints what changed
+    FrameSnapshot::MazeLayer& maze = frame.maze();
+    maze.generation = m_mazeGeneration;
+    maze.texture = m_layout ? nullptr : m_mapSprite.getTexture();
+    maze.layout = m_layout;
+    maze.position = m_layout ? sf::Vector2f(0.f, SCROLL_TOP) : m_mapSprite.getPosition();
+    maze.scale = m_mapSprite.getScale().x;
+    maze.tileSize = sf::Vector2f((float)m_gridSpacing.x, (float)m_gridSpacing.y);
+    maze.columns = static_cast<std::size_t>(m_pelletBoard.columns());
+    maze.pellets = m_pellets;
+    maze.pelletsEaten = m_pellets->size();
+    maze.score = m_score;
+    maze.highScore = m_highScore;
+    maze.lives = m_lives;
 
     // draw pacman
-    m_pacman->render(window);
-    m_blinky->render(window);
-    m_pinky->render(window);
-    m_clyde->render(window, m_pacman->getPlayerPos());
-    m_inky->render(window);
-
-    for (auto& sprite : m_pacSprite) {
-        window.draw(sprite);
+    m_pacman->render(frame);
+    if (!m_layout) {
+        m_ghosts.forEach([&frame](auto& ghost) { ghost.render(frame); });
+    }
+    else {
+        // a scrolling maze only shows what the camera sees; ghosts off screen are left out
+        maze.camera = cameraArea();
+        float margin = static_cast<float>(MazeLayout::TILE_SIZE);
+        sf::FloatRect visible(maze.camera.left - margin, maze.camera.top - margin, maze.camera.width + margin * 2.f, maze.camera.height + margin * 2.f);
+        m_ghosts.forEach([&frame, &visible](auto& ghost) {
+            if (visible.intersects(ghost.getHitBox()))
+                ghost.render(frame);
+        });
     }
 
-    window.draw(m_scoreText);
-    window.draw(m_highScoreText);
+    if (m_paused) {
+        // in the middle of the screen, which for a scrolling maze is where the camera is
+        sf::Vector2f centre(static_cast<float>(FrameBuffer::layoutSize().x) / 2.f, static_cast<float>(FrameBuffer::layoutSize().y) / 2.f);
+        if (m_layout)
+            centre = sf::Vector2f(maze.camera.left + maze.camera.width / 2.f, maze.camera.top + maze.camera.height / 2.f);
+        m_pausedText.centerOn(centre);
+        m_pausedText.render(frame);
+    }
+}
+
+sf::FloatRect PlayingState::cameraArea() const
+{
+    // the screen below the HUD band, and the whole maze, in maze coordinates
+    sf::Vector2f view(static_cast<float>(FrameBuffer::layoutSize().x), static_cast<float>(FrameBuffer::layoutSize().y) - SCROLL_TOP);
+    sf::Vector2f extent(static_cast<float>(m_layout->columns * MazeLayout::TILE_SIZE), static_cast<float>(m_layout->rows * MazeLayout::TILE_SIZE));
+    sf::FloatRect pac = m_pacman->getHitBox();
+
+    // centred on Pac-Man but kept inside the maze, or centred on a maze smaller than the view
+    auto start = [](float centre, float viewSize, float mazeSize) {
+        float first = mazeSize <= viewSize ? (mazeSize - viewSize) / 2.f : std::clamp(centre - viewSize / 2.f, 0.f, mazeSize - viewSize);
+        // whole native pixels, so walls do not shimmer as the maze scrolls
+        const float pixel = static_cast<float>(FrameBuffer::LAYOUT_SCALE);
+        return std::round(first / pixel) * pixel;
+    };
+    return sf::FloatRect(start(pac.left + pac.width / 2.f, view.x, extent.x), start(pac.top + pac.height / 2.f, view.y, extent.y), view.x, view.y);
 }
 
 void PlayingState::analyzeGridCells()
 {
-    // Get the image from the texture
-    sf::Image mapImage = m_mapTexture.copyToImage();
+    // read the pixels from the file rather than back from the GPU
+    sf::Image mapImage;
+    if (!mapImage.loadFromFile(MAP_PATH)) {
+        std::cerr << "Failed to load map image: " << MAP_PATH << std::endl;
+    }
 
     // Get sprite bounds and scale factor
     sf::FloatRect spriteBounds = m_mapSprite.getGlobalBounds();
@@ -203,12 +365,6 @@ void PlayingState::analyzeGridCells()
     m_mapVector.clear();
     m_mapVector.resize(numRows, std::vector<int>(numCols, 0));
 
-    m_blackTiles.clear();
-    m_blackTiles.resize(m_mapVector.size());
-    for (size_t row = 0; row < m_mapVector.size(); row++) {
-        m_blackTiles[row].resize(m_mapVector[row].size(), false);
-    }
-
     // We'll need the texture size as int to avoid sign warnings
     int texWidth = static_cast<int>(mapImage.getSize().x);
     int texHeight = static_cast<int>(mapImage.getSize().y);
@@ -292,16 +448,27 @@ void PlayingState::analyzeGridCells()
 
 void PlayingState::initLevel()
 {
-    m_remainingPellets = 0;
-    // Count the number of pellets in the map
-    for (int y = 0; y < (int)m_mapVector.size(); ++y) {
-        for (std::size_t x = 0; x < m_mapVector[static_cast<std::size_t>(y)].size(); ++x) {
-            int tile = m_mapVector[static_cast<std::size_t>(y)][x];
-            // assuming 2 = small pellet, 3 = power pellet
-            if (tile == 2 || tile == 3)
-                ++m_remainingPellets;
+    std::size_t columns = m_mapVector.empty() ? 0 : m_mapVector[0].size();
+
+    // a maze laid out just now: its dots and energizers become the board's pristine copy
+    if (m_pelletBoard.columns() == 0) {
+        m_pelletBoard = PelletBoard(static_cast<int>(columns), static_cast<int>(m_mapVector.size()));
+        for (std::size_t y = 0; y < m_mapVector.size(); ++y) {
+            for (std::size_t x = 0; x < m_mapVector[y].size(); ++x) {
+                // 2 = small pellet, 3 = power pellet
+                int tile = m_mapVector[y][x];
+                if (tile == 2 || tile == 3)
+                    m_pelletBoard.add(sf::Vector2i(static_cast<int>(x), static_cast<int>(y)), tile == 2 ? PelletBoard::Kind::Dot : PelletBoard::Kind::Energizer);
+            }
         }
     }
+
+    // the log has room for every pellet in the maze and starts with those already gone
+    int eaten = m_pelletBoard.eaten();
+    m_pellets = std::make_shared<PelletLog>(static_cast<std::size_t>(m_pelletBoard.remaining() + eaten));
+    m_pelletBoard.forEachEaten([this, columns](sf::Vector2i tile) {
+        m_pellets->push(static_cast<std::uint32_t>(static_cast<std::size_t>(tile.y) * columns + static_cast<std::size_t>(tile.x)));
+    });
 }
 
 void PlayingState::manualOverrides()
@@ -322,184 +489,80 @@ void PlayingState::manualOverrides()
 void PlayingState::updateMap(std::vector<std::vector<int>>& map)
 {
     sf::Vector2i pos = m_pacman->getPlayerPos();
+    std::uint32_t index = static_cast<std::uint32_t>(static_cast<std::size_t>(pos.y) * map[0].size() + static_cast<std::size_t>(pos.x));
 
-    // Ensure pos.x >= 0 and pos.y >= 0 if needed
-    size_t row = static_cast<size_t>(pos.y);
-    size_t col = static_cast<size_t>(pos.x);
-
-    // Check if pellet is eaten
-    if (map.at(row).at(col) == 2)
+    // Check if a pellet is eaten
+    PelletBoard::Kind eaten = m_pelletBoard.eat(pos);
+    if (eaten == PelletBoard::Kind::Dot)
     {
-        m_blackTiles.at(row).at(col) = true;
-        map.at(row).at(col) = 0;
+        m_pellets->push(index);
         m_score += 10;
-        m_scoreText.setString("1UP\n " + std::to_string(m_score));
-        --m_remainingPellets;
+        Telemetry::instance().record(Telemetry::Event::Pellet, m_level, pos, 10);
+        AudioEngine::instance().play(Sound::Waka);
+        AudioEngine::instance().setSirenPitch(sirenPitch());
     }
-
-    // Check if power pellet is eaten
-    if (map.at(row).at(col) == 3)
+    else if (eaten == PelletBoard::Kind::Energizer)
     {
-        m_blackTiles.at(row).at(col) = true;
-        map.at(row).at(col) = 0;
+        m_pellets->push(index);
         m_score += 50;
-        m_blinky->setMode(Ghost::Mode::Frightened);
-        m_inky->setMode(Ghost::Mode::Frightened);
-        m_pinky->setMode(Ghost::Mode::Frightened);
-        m_clyde->setMode(Ghost::Mode::Frightened);
-        m_scoreText.setString("1UP\n " + std::to_string(m_score));
-        --m_remainingPellets;
+        m_ghosts.forEach([](Ghost& ghost) { ghost.setMode(Ghost::Mode::Frightened); });
+        m_ghostChain = 0;
+        // a later energizer starts the fright over; flashing only if it comes before the end
+        std::uint32_t frightTicks = TimerWheel::ticksFor(m_params.frightenedSeconds);
+        std::uint32_t blinkTicks = TimerWheel::ticksFor(m_params.blinkSeconds);
+        m_timers.start(m_frightTimer, frightTicks);
+        if (blinkTicks < frightTicks) {
+            m_timers.start(m_blinkTimer, blinkTicks);
+        }
+        else {
+            m_timers.stop(m_blinkTimer);
+        }
+        Telemetry::instance().record(Telemetry::Event::Energizer, m_level, pos, 50);
+        AudioEngine::instance().play(Sound::Waka);
+        AudioEngine::instance().setSirenPitch(sirenPitch());
     }
 
     // slow down pacman when eating
-    row = (size_t)m_pacman->getPlayerPos().y;
-    col = (size_t)m_pacman->getPlayerPos().x;
-    int dirX = m_pacman->getDirection().x;
-    int dirY = m_pacman->getDirection().y;
-
-    int mapHeight = static_cast<int>(map.size());
     int mapWidth = static_cast<int>(map[0].size());
+    sf::Vector2i target = pos + m_pacman->getDirection();
 
-    int targetCol = (int)col + dirX;
-    int targetRow = (int)row + dirY;
-
-    if (row >= 0 && (int)row < mapHeight && col > 0 && (int)col < mapWidth - 1 && targetCol >= 0 && targetCol < mapWidth) {
-
-        int tile = map[(size_t)targetRow][(size_t)targetCol];
-
-        if (tile == 2 || tile == 3) {
-            m_pacman->setSpeed(m_eatingSpeed);
+    if (pos.x > 0 && pos.x < mapWidth - 1) {
+        if (m_pelletBoard.at(target) != PelletBoard::Kind::None) {
+            m_pacman->setSpeed(m_eatingStep);
         }
         else {
-            m_pacman->setSpeed(m_normalSpeed);
+            m_pacman->setSpeed(m_normalStep);
         }
     }
 }
 
-void PlayingState::drawBlackTiles(sf::RenderWindow& window)
+PlayingState::~PlayingState()
 {
-    for (size_t row = 0; row < m_blackTiles.size(); row++) {
-        for (size_t col = 0; col < m_blackTiles[row].size(); col++) {
-            if (m_blackTiles[row][col]) {
-                sf::RectangleShape blackRect(sf::Vector2f((float)m_gridSpacing.x + 2.f, (float)m_gridSpacing.y + 2.f));
-                blackRect.setFillColor(sf::Color::Black);
-
-                // Set the origin to the center of the rectangle
-                float tileX = m_mapSprite.getPosition().x + (float)m_offset.x + (float)col * (float)m_gridSpacing.x - 1.f;
-                float tileY = m_mapSprite.getPosition().y + (float)m_offset.y + (float)row * (float)m_gridSpacing.y - 1.f;
-
-                // Set the position of the rectangle
-                blackRect.setPosition(tileX, tileY);
-                window.draw(blackRect);
-            }
-        }
-    }
-}
-
-void PlayingState::initScoreText() {
-    if (!m_scoreFont.loadFromFile("assets/fonts/PixelGaming.ttf"))
-        std::cerr << "Failed to load score font.\n";
-
-    // 1-UP (player score, top-left)
-    m_scoreText.setFont(m_scoreFont);
-    m_scoreText.setString("1UP\n " + std::to_string(m_score));
-    m_scoreText.setCharacterSize(40);
-    m_scoreText.setFillColor(sf::Color::White);
-    m_scoreText.setPosition(10.f, 10.f);
-
-    // HIGH (centered)
-    int hi = readHighScore();
-    m_highScoreText.setFont(m_scoreFont);
-    m_highScoreText.setString("HIGH\n " + std::to_string(hi));
-    m_highScoreText.setCharacterSize(40);
-    m_highScoreText.setFillColor(sf::Color::White);
-
-    // centre on the window
-    float cx = static_cast<float>(m_window.getSize().x) / 2.f;
-    sf::FloatRect b = m_highScoreText.getLocalBounds();
-    m_highScoreText.setOrigin(b.left + b.width / 2.f, b.top);
-    m_highScoreText.setPosition(cx, 10.f);
-
-    // lives sprites …
-    m_pacTexture.loadFromFile("assets/sprites/pacmanspritesheet.png");
-    for (int i = 0; i < m_lives; i++) {
-        m_pacSprite[i].setTexture(m_pacTexture);
-        m_pacSprite[i].setTextureRect(sf::IntRect(13, 0, 13, 13));
-        m_pacSprite[i].setScale(3.5f, 3.5f);
-        m_pacSprite[i].setPosition(600.f - static_cast<float>(i) * 50.f, 35.f);
-    }
+    // leaving the round, whichever way: no siren over the next screen
+    AudioEngine::instance().stopLoop();
 }
 
-int PlayingState::readHighScore()
+float PlayingState::sirenPitch() const
 {
-    std::ifstream in("scores.txt");
-    int best = 0;
-    std::string line;
-    while (std::getline(in, line)) {
-        if (line.size() >= 4) {
-            int val = std::stoi(line.substr(3));
-            if (val > best) best = val;
-        }
-    }
-    return best;
+    // the siren climbs in steps as the maze empties, like the arcade's
+    int remaining = m_pelletBoard.remaining();
+    if (remaining > 160)
+        return 1.f;
+    if (remaining > 96)
+        return 1.1f;
+    if (remaining > 48)
+        return 1.2f;
+    if (remaining > 16)
+        return 1.3f;
+    return 1.4f;
 }
 
-void PlayingState::initModeTimers(int level)
-{
-    const sf::Time ONE_FRAME = sf::seconds(1.f / 60.f);
-
-    // Set the timers for each ghost
-    // different levels have different timers
-    if (level == 1) {
-        m_scatterTimers[0] = sf::seconds(7.f);    m_chaseTimers[0] = sf::seconds(20.f);
-        m_scatterTimers[1] = sf::seconds(7.f);    m_chaseTimers[1] = sf::seconds(20.f);
-        m_scatterTimers[2] = sf::seconds(5.f);    m_chaseTimers[2] = sf::seconds(20.f);
-        m_scatterTimers[3] = sf::seconds(5.f);    m_chaseTimers[3] = sf::Time::Zero;
-    }
-    else if (level >= 2 && level <= 4) {
-        m_scatterTimers[0] = sf::seconds(7.f);    m_chaseTimers[0] = sf::seconds(20.f);
-        m_scatterTimers[1] = sf::seconds(7.f);    m_chaseTimers[1] = sf::seconds(20.f);
-        m_scatterTimers[2] = sf::seconds(5.f);    m_chaseTimers[2] = sf::seconds(1033.f);
-        m_scatterTimers[3] = ONE_FRAME;           m_chaseTimers[3] = sf::Time::Zero;
-    }
-    else {
-        m_scatterTimers[0] = sf::seconds(5.f);    m_chaseTimers[0] = sf::seconds(20.f);
-        m_scatterTimers[1] = sf::seconds(5.f);    m_chaseTimers[1] = sf::seconds(20.f);
-        m_scatterTimers[2] = sf::seconds(5.f);    m_chaseTimers[2] = sf::seconds(1037.f);
-        m_scatterTimers[3] = ONE_FRAME;           m_chaseTimers[3] = sf::Time::Zero;
-    }
-}
-
-void PlayingState::initPlayerSpeeds(int level)
+int PlayingState::readHighScore()
 {
-    // Set the speed of Pac‑Man and the ghosts based on the level
-    float baseSpeed = 7.5f; // base: tiles/sec
-    float normalMultiplier = 1.0f;
-    float eatingMultiplier = 0.9f;
-
-    if (level == 1) {
-        normalMultiplier = 0.8f;
-        eatingMultiplier = 0.71f;
-    }
-    else if (level >= 2 && level <= 4) {
-        normalMultiplier = 0.9f;
-        eatingMultiplier = 0.79f;
-    }
-    else if (level >= 5 && level <= 20) {
-        normalMultiplier = 1.0f;
-        eatingMultiplier = 0.9f;
-    }
-    else if (level >= 21) {
-        normalMultiplier = 1.1f;
-        eatingMultiplier = 0.9f;
-    }
-
-    m_normalSpeed = baseSpeed * normalMultiplier;
-    m_eatingSpeed = baseSpeed * eatingMultiplier;
+    // the store parses the score files once per process
+    return ScoreStore::instance().best();
 }
 
-
-
 bool PlayingState::checkDeath()
 {
     sf::FloatRect pacBounds = m_pacman->getHitBox();
@@ -513,58 +576,29 @@ bool PlayingState::checkDeath()
         pacBounds.height - inset * 2
     );
 
-    // Inky
-    if (m_inky->getMode() != Ghost::Mode::Eaten &&
-        pacBounds.intersects(m_inky->getHitBox()))
-    {
-        if (m_inky->getMode() == Ghost::Mode::Frightened) {
-            m_inky->setMode(Ghost::Mode::Eaten);
+    // the first ghost touching Pac-Man either dies or kills him
+    bool killed = false;
+    m_ghosts.any([&](auto& ghost) {
+        if (ghost.getMode() == Ghost::Mode::Eaten || !pacBounds.intersects(ghost.getHitBox()))
+            return false;
+        std::uint8_t id = Squad::indexOf<std::decay_t<decltype(ghost)>>();
+        if (ghost.getMode() == Ghost::Mode::Frightened) {
+            ghost.setMode(Ghost::Mode::Eaten);
             m_score += 400;
-            sf::sleep(sf::seconds(0.1f));
+            ++m_ghostChain;
+            Telemetry::instance().record(Telemetry::Event::GhostEaten, m_level, ghost.getPos(), 400, id,
+                static_cast<std::uint8_t>(std::min(m_ghostChain, 255)));
+            AudioEngine::instance().play(Sound::EatGhost);
+            freeze(Freeze::GhostEaten, GHOST_EATEN_FREEZE_SECONDS);
         }
         else {
-            return true;  // kill Pac‑Man
+            killed = true;  // kill Pac‑Man
+            Telemetry::instance().record(Telemetry::Event::Death, m_level, m_pacman->getPlayerPos(), m_score, id);
+            AudioEngine::instance().stopLoop();
+            AudioEngine::instance().play(Sound::Death);
         }
-    }
-    // Blinky
-    else if (m_blinky->getMode() != Ghost::Mode::Eaten &&
-        pacBounds.intersects(m_blinky->getHitBox()))
-    {
-        if (m_blinky->getMode() == Ghost::Mode::Frightened) {
-            m_blinky->setMode(Ghost::Mode::Eaten);
-            m_score += 400;
-            sf::sleep(sf::seconds(0.2f));
-        }
-        else {
-            return true;
-        }
-    }
-    // Pinky
-    else if (m_pinky->getMode() != Ghost::Mode::Eaten &&
-        pacBounds.intersects(m_pinky->getHitBox()))
-    {
-        if (m_pinky->getMode() == Ghost::Mode::Frightened) {
-            m_pinky->setMode(Ghost::Mode::Eaten);
-            m_score += 400;
-            sf::sleep(sf::seconds(0.2f));
-        }
-        else {
-            return true;
-        }
-    }
-    // Clyde
-    else if (m_clyde->getMode() != Ghost::Mode::Eaten &&
-        pacBounds.intersects(m_clyde->getHitBox()))
-    {
-        if (m_clyde->getMode() == Ghost::Mode::Frightened) {
-            m_clyde->setMode(Ghost::Mode::Eaten);
-            m_score += 400;
-            sf::sleep(sf::seconds(0.2f));
-        }
-        else {
-            return true;
-        }
-    }
+        return true;
+    });
 
-    return false;
+    return killed;
 }
\ No newline at end of file
@@ -9,7 +9,17 @@
 #include "Pinky.h"
 #include "Inky.h"
 #include "Clyde.h"
+#include "GhostSquad.h"
+#include "LevelParams.h"
+#include "MazeLayout.h"
+#include "PelletBoard.h"
+#include "PelletLog.h"
+#include "TextLabel.h"
+#include "TimerWheel.h"
+#include "TileMover.h"
 #include <SFML/Graphics/Texture.hpp>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 class PlayingState : public GameState
@@ -23,21 +33,30 @@ public:
      * @param level Current level
      * @param score Current score
      * @param mapVector 2D vector representing the map layout
-     * @param blackTiles 2D vector representing the black tiles
+     * @param pellets Pellets still in that layout; ignored without one
      */
-    PlayingState(StateManager& stateManager, const sf::RenderWindow& window, int lives = 3, int level = 1, int score = 0, std::vector<std::vector<int>> mapVector = {}, std::vector<std::vector<bool>> blackTiles = {});
-    
+    PlayingState(StateManager& stateManager, const sf::RenderWindow& window, int lives = 3, int level = 1, int score = 0, std::vector<std::vector<int>> mapVector = {}, PelletBoard pellets = {});
+
+    /**
+     * @brief Load every texture and glyph atlas this state uses
+     * @details Called while the window's GL context is current, before the sim
+     * thread starts, so constructing the state later only looks them up.
+     */
+    static void preload();
+
+
     /**
      * @brief PlayingState destructor
-     * @details Default destructor.
+     * @details Stops the background siren.
      */
-    ~PlayingState() override = default;
+    ~PlayingState() override;
 
     /**
      * @brief Handle events for the playing state
      * @param window Reference to the SFML window
+     * @param input Keyboard events for this tick
      */
-    void handleEvents(sf::RenderWindow& window) override;
+    void handleEvents(sf::RenderWindow& window, const Input& input) override;
     
     /**
      * @brief Update the playing state
@@ -46,10 +65,15 @@ public:
     void update(sf::Time dt) override;
     
     /**
-     * @brief Render the playing state
-     * @param window Reference to the SFML window
+     * @brief Record the maze state, HUD values and actors into a frame snapshot
+     * @param frame Snapshot to record into
      */
-    void render(sf::RenderWindow& window) override;
+    void render(FrameSnapshot& frame) override;
+
+    /**
+     * @brief Name reported by the metrics endpoint
+     */
+    const char* name() const override { return "playing"; }
 
 private:
     /**
@@ -71,83 +95,123 @@ private:
     void updateMap(std::vector<std::vector<int>>& map);
 
     /**
-     * @brief Draw the black tiles on the map
-     * @param window Reference to the SFML window
+     * @brief Look up the high score from the score store
      */
-    void drawBlackTiles(sf::RenderWindow& window);
+    int readHighScore();
 
     /**
-     * @brief Initialize the score text
+     * @brief Siren playback rate for the pellets left in the maze
      */
-    void initScoreText();
+    float sirenPitch() const;
 
     /**
-     * @brief Initialize the high score text from file
+     * @brief Check if the player has collided with a ghost
+     * @return true if a ghost is not in frighten mode and collided with the player
+     * @return false otherwise
      */
-    int readHighScore();
+    bool checkDeath();
 
     /**
-     * @brief Initialize the timers for the ghost modes
-     * @param level Current level
+     * @brief initialize the possible pellets on the map and the log of eaten ones
      */
-    void initModeTimers(int level);
+    void initLevel();
 
     /**
-     * @brief Initialize the player speeds based on the level
-     * @param level Current level
+     * @brief Hand the actors the maze and start the scatter/chase phases
+     * @details Called by the start timer once the round's opening delay is over.
      */
-    void initPlayerSpeeds(int level);
+    void startRound();
 
     /**
-     * @brief Check if the player has collided with a ghost
-     * @return true if a ghost is not in frighten mode and collided with the player
-     * @return false otherwise
+     * @brief Start the timer of the current scatter or chase phase
+     * @details A phase of zero seconds lasts until the level ends.
      */
-    bool checkDeath();
+    void startPhase();
 
     /**
-     * @brief initialize the possible pellets on the map
+     * @brief Switch between scatter and chase when a phase runs out
      */
-    void initLevel();
+    void nextPhase();
+
+    /**
+     * @brief Stop or restart the round; while paused no tick passes
+     */
+    void togglePause();
+
+    // why play is frozen; a death or a cleared level changes state once it is over
+    enum class Freeze
+    {
+        GhostEaten,
+        Death,
+        LevelClear
+    };
+
+    /**
+     * @brief Hold play still for a while, drawing as usual
+     * @details update() only counts the freeze down until it runs out, then does
+     * what the reason calls for. A later freeze replaces an earlier one.
+     *
+     * @param reason what happened
+     * @param seconds how long to hold
+     */
+    void freeze(Freeze reason, float seconds);
+
+    /**
+     * @brief Part of a scrolling maze on screen, following Pac-Man
+     * @return sf::FloatRect camera area in maze coordinates
+     */
+    sf::FloatRect cameraArea() const;
+
+    std::vector<std::vector<int>> m_mapVector;   // as laid out; pellets eaten since are in m_pelletBoard
+    PelletBoard m_pelletBoard;
 
-    std::vector<std::vector<int>> m_mapVector;
-    std::vector<std::vector<bool>> m_blackTiles;
-    int  m_remainingPellets = 0;
+    std::shared_ptr<const MazeLayout> m_layout;   // tiles to play on, null for the arcade map
+    std::shared_ptr<PelletLog> m_pellets;         // pellets eaten, shared with the render thread
 
     int m_level;
     int m_lives;
+    const LevelParams& m_params;   // this level's row of the tuning table
 
     int m_score;
-    sf::Font m_scoreFont;
-    sf::Text m_scoreText;
-    sf::Text m_highScoreText;
+    int m_highScore = 0;
 
-    sf::Sprite m_pacSprite[3];
-    sf::Texture m_pacTexture;
-
-    sf::Texture m_mapTexture;
     sf::Sprite m_mapSprite;
 
+    // tells the render thread's MazeView when this maze needs painting from scratch
+    std::uint32_t m_mazeGeneration;
+
     sf::Vector2i m_gridSpacing;
     sf::Vector2i m_offset;
 
     std::unique_ptr<Player> m_pacman;
-    float m_normalSpeed;
-    float m_eatingSpeed;
-
-    std::unique_ptr<Blinky> m_blinky;
-    std::unique_ptr<Pinky> m_pinky;
-    std::unique_ptr<Inky> m_inky;
-    std::unique_ptr<Clyde> m_clyde;
-
-    sf::Clock m_timer;
-
-    sf::Time m_scatterTimers[4]{};
-    sf::Time m_chaseTimers[4]{};
+    float m_normalSpeed;             // tiles per second, also the ghosts' base speed
+    TileMover::Fixed m_normalStep;   // Pac-Man's per-tick steps
+    TileMover::Fixed m_eatingStep;
+
+    // new ghost types only need adding here
+    using Squad = GhostSquad<Blinky, Pinky, Inky, Clyde>;
+    Squad m_ghosts;
+    int m_ghostChain = 0;   // ghosts eaten on the current energizer
+
+    // every timed event of the round, counted in sim ticks
+    TimerWheel m_timers;
+    TimerWheel::Id m_startTimer;    // the opening delay
+    TimerWheel::Id m_phaseTimer;    // the current scatter or chase phase
+    TimerWheel::Id m_frightTimer;   // the last energizer's frightened time
+    TimerWheel::Id m_blinkTimer;    // when the frightened ghosts start to flash
+
+    // the freeze after a ghost is eaten, a death or a cleared level, kept apart so
+    // the round's timers above stand still meanwhile
+    TimerWheel m_freezeTimers;
+    TimerWheel::Id m_freezeTimer;
+    Freeze m_freeze = Freeze::GhostEaten;
+    bool m_frozen = false;
 
     int m_phaseIndex = 0;
     bool m_inScatter = true;
-    bool m_modeTimerActive = false;
+    bool m_roundStarted = false;
+    bool m_paused = false;
+    TextLabel m_pausedText;
 
     StateManager& m_stateManager;
     const sf::RenderWindow& m_window;
@@ -0,0 +1,68 @@
+#include "RenderBudget.h"
+#include "FileUtils.h"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Entry
+{
+    std::string state;
+    DrawCounts limit;
+};
+
+// written only by loadOverrides(), before the game starts; "playing" allows for a
+// screenful of scrolling maze chunks and every ghost's debug overlay
+std::vector<Entry> s_budgets = {
+    //  state        draws  primitives  texture switches
+    { "menu",      { 8,     4000,       6 } },
+    { "playing",   { 32,    40000,      16 } },
+    { "end_game",  { 8,     4000,       6 } },
+};
+
+} // namespace
+
+const DrawCounts* RenderBudget::get(const char* state)
+{
+    for (const Entry& entry : s_budgets) {
+        if (entry.state == state)
+            return &entry.limit;
+    }
+    return nullptr;
+}
+
+bool RenderBudget::within(const char* state, const DrawCounts& frame)
+{
+    const DrawCounts* limit = get(state);
+    return !limit
+        || (frame.drawCalls <= limit->drawCalls && frame.primitives <= limit->primitives
+            && frame.textureSwitches <= limit->textureSwitches);
+}
+
+bool RenderBudget::loadOverrides(const std::string& path)
+{
+    // edit a copy, so a bad line leaves the budgets as they were
+    std::vector<Entry> budgets = s_budgets;
+    bool read = readLines(path, "render budgets", [&budgets](std::istream& fields) {
+        Entry entry;
+        if (!(fields >> entry.state >> entry.limit.drawCalls >> entry.limit.primitives >> entry.limit.textureSwitches))
+            return false;
+
+        bool replaced = false;
+        for (Entry& existing : budgets) {
+            if (existing.state == entry.state) {
+                existing.limit = entry.limit;
+                replaced = true;
+            }
+        }
+        if (!replaced)
+            budgets.push_back(std::move(entry));
+        return true;
+    });
+    if (!read)
+        return false;
+
+    s_budgets = std::move(budgets);
+    return true;
+}
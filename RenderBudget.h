@@ -0,0 +1,47 @@
+#ifndef RENDERBUDGET_H
+#define RENDERBUDGET_H
+
+#include "CountedTarget.h"
+
+#include <string>
+
+/**
+ * @brief the most each state may draw in one frame
+ * @details Frames are checked against the budget of the state that recorded them,
+ * by GameState::name(). The built-in budgets leave room over what each state
+ * draws today; a frame over them means a render change added draw calls, vertices
+ * or texture switches, and is worth a look. States without a budget are not checked.
+ */
+namespace RenderBudget {
+
+/**
+ * @brief the budget of a state
+ *
+ * @param state a GameState::name()
+ * @return const DrawCounts* its limits, or nullptr if it has none
+ */
+const DrawCounts* get(const char* state);
+
+/**
+ * @brief whether a frame kept to its state's budget
+ *
+ * @param state name of the state that recorded the frame
+ * @param frame what the frame drew
+ * @return true if every count is within the budget, or there is no budget
+ */
+bool within(const char* state, const DrawCounts& frame);
+
+/**
+ * @brief replace budgets from a text file
+ * @details One state per line: its name, then the most draw calls, primitives and
+ * texture switches a frame may use; '#' starts a comment. A file with any bad
+ * line changes nothing.
+ *
+ * @param path budget file
+ * @return true if the whole file was applied
+ */
+bool loadOverrides(const std::string& path);
+
+} // namespace RenderBudget
+
+#endif // RENDERBUDGET_H
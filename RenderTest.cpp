@@ -0,0 +1,288 @@
+#include "RenderTest.h"
+
+#include "AllocCounter.h"
+#include "FrameArena.h"
+#include "FrameBuffer.h"
+#include "FrameRenderer.h"
+#include "FileUtils.h"
+#include "FrameSnapshot.h"
+#include "Ghost.h"
+#include "Input.h"
+#include "InputScript.h"
+#include "MainMenuState.h"
+#include "MazeGenerator.h"
+#include "MazeLayout.h"
+#include "RenderBudget.h"
+#include "ScoreStore.h"
+#include "StateManager.h"
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const sf::Time TICK = sf::seconds(1.f / 60.f);
+const int MAX_TICKS = 60 * 60 * 10;   // ten minutes of play
+
+struct Settings
+{
+    std::uint32_t seed = 1;
+    int channelTolerance = 16;
+    double pixelTolerance = 0.001;
+    std::vector<int> captures;   // ascending
+    int mazeColumns = 0;         // generated maze size, 0 for the arcade map
+    int mazeRows = 0;
+    int steadyFrom = 0;          // ticks that must not allocate, 0 for none
+    int steadyTo = MAX_TICKS;
+};
+
+bool loadSettings(const std::string& path, Settings& settings)
+{
+    bool read = readLines(path, "render test settings", [&settings](std::istream& fields) {
+        std::string name;
+        if (!(fields >> name))
+            return false;
+
+        bool ok = false;
+        if (name == "seed") {
+            ok = static_cast<bool>(fields >> settings.seed);
+        }
+        else if (name == "tolerance") {
+            ok = fields >> settings.channelTolerance >> settings.pixelTolerance
+                && settings.channelTolerance >= 0 && settings.pixelTolerance >= 0.0;
+        }
+        else if (name == "maze") {
+            std::string size;
+            ok = fields >> size && MazeGenerator::parseSize(size, settings.mazeColumns, settings.mazeRows);
+        }
+        else if (name == "steady") {
+            ok = fields >> settings.steadyFrom && settings.steadyFrom > 0;
+            if (ok && !(fields >> settings.steadyTo)) {
+                settings.steadyTo = MAX_TICKS;   // to the end of the run
+                fields.clear();
+            }
+            ok = ok && settings.steadyTo >= settings.steadyFrom;
+        }
+        else if (name == "capture") {
+            int tick = 0;
+            while (fields >> tick) {
+                ok = tick > 0;
+                if (!ok)
+                    break;
+                settings.captures.push_back(tick);
+            }
+            ok = ok && fields.eof();
+        }
+        return ok;
+    });
+    if (!read)
+        return false;
+
+    std::sort(settings.captures.begin(), settings.captures.end());
+    settings.captures.erase(std::unique(settings.captures.begin(), settings.captures.end()), settings.captures.end());
+    return true;
+}
+
+std::string imagePath(const std::string& directory, const char* prefix, int tick)
+{
+    return directory + "/" + prefix + std::to_string(tick) + ".png";
+}
+
+// pixels that differ by more than tolerance in some channel, marked red in diff
+std::size_t countDifferences(const sf::Image& expected, const sf::Image& actual, int tolerance, sf::Image& diff)
+{
+    sf::Vector2u size = actual.getSize();
+    diff.create(size.x, size.y, sf::Color::Black);
+    std::size_t count = 0;
+    for (unsigned int y = 0; y < size.y; ++y) {
+        for (unsigned int x = 0; x < size.x; ++x) {
+            sf::Color a = expected.getPixel(x, y);
+            sf::Color b = actual.getPixel(x, y);
+            int worst = std::max({ std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b), std::abs(a.a - b.a) });
+            if (worst > tolerance) {
+                diff.setPixel(x, y, sf::Color::Red);
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+// compare one captured frame with its golden image; true if it matches
+bool checkFrame(const std::string& directory, int tick, const sf::Image& actual, const Settings& settings)
+{
+    sf::Image expected;
+    if (!expected.loadFromFile(imagePath(directory, "frame_", tick))) {
+        std::cerr << "Tick " << tick << ": no golden image; run with --record first" << std::endl;
+        actual.saveToFile(imagePath(directory, "actual_", tick));
+        return false;
+    }
+    if (expected.getSize() != actual.getSize()) {
+        std::cerr << "Tick " << tick << ": golden image is " << expected.getSize().x << "x" << expected.getSize().y
+                  << ", frame is " << actual.getSize().x << "x" << actual.getSize().y << std::endl;
+        actual.saveToFile(imagePath(directory, "actual_", tick));
+        return false;
+    }
+
+    sf::Image diff;
+    std::size_t differences = countDifferences(expected, actual, settings.channelTolerance, diff);
+    std::size_t pixels = static_cast<std::size_t>(actual.getSize().x) * actual.getSize().y;
+    if (static_cast<double>(differences) <= settings.pixelTolerance * static_cast<double>(pixels))
+        return true;
+
+    std::cerr << "Tick " << tick << ": " << differences << " of " << pixels << " pixels differ" << std::endl;
+    actual.saveToFile(imagePath(directory, "actual_", tick));
+    diff.saveToFile(imagePath(directory, "diff_", tick));
+    return false;
+}
+
+std::int64_t percentile(const std::vector<std::int64_t>& sorted, double fraction)
+{
+    if (sorted.empty())
+        return 0;
+    std::size_t index = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+} // namespace
+
+int runRenderTest(const std::string& directory, bool record)
+{
+    Settings settings;
+    InputScript script;
+    if (!loadSettings(directory + "/render-test.txt", settings) || !script.load(directory + "/script.txt"))
+        return 1;
+
+#ifndef _WIN32
+    // Mesa's software rasterizer: the same pixels with or without a GPU
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+#endif
+
+    // a fresh score table, so the HUD's high score is the same on every run
+    const std::string scores = directory + "/.scores";
+    for (const char* extension : { ".bin", ".txt", ".log", ".lock" })
+        std::remove((scores + extension).c_str());
+    ScoreStore::setBasePath(scores);
+    Ghost::seed(settings.seed);
+    if (settings.mazeColumns > 0)
+        MazeLayout::setCustom(MazeGenerator::generate(settings.mazeColumns, settings.mazeRows, settings.seed));
+
+    // the states want a window to poll; this one is never shown
+    sf::RenderWindow window(sf::VideoMode(FrameBuffer::NATIVE_WIDTH, FrameBuffer::NATIVE_HEIGHT), "PacMan render test", sf::Style::None);
+    window.setVisible(false);
+    FrameBuffer buffer;
+    if (!buffer.create())
+        return 1;
+
+    FrameRenderer renderer;
+    FrameSnapshot frame;
+    StateManager states;
+    states.pushState(std::make_unique<MainMenuState>(states, window));
+    Input input;
+    script.start(sf::Time::Zero);
+
+    std::ofstream timings(directory + "/timings.csv");
+    timings << "tick,state,draw_calls,primitives,texture_switches,render_us,allocations,arena_bytes\n";
+    std::vector<std::int64_t> renderMicros;
+    renderMicros.reserve(MAX_TICKS);
+    std::size_t nextCapture = 0;
+    int failures = 0;
+    int allocatingTicks = 0;
+    int overBudgetFrames = 0;
+    const char* overBudgetState = nullptr;
+    AllocCounter::enable();
+
+    // the same tick as Game::run, in simulated time
+    for (int tick = 1; tick <= MAX_TICKS; ++tick) {
+        sf::Time tickEnd = TICK * static_cast<sf::Int64>(tick);
+        // one thread ticks and draws here, so one arena and one reset per frame
+        FrameArena& arena = FrameArena::local();
+        arena.reset();
+        std::uint64_t allocations = AllocCounter::thisThread();
+        if (!script.feed(input, tickEnd))
+            break;
+        input.beginTick(tickEnd);
+        if (GameState* state = states.getCurrentState())
+            state->handleEvents(window, input);
+        if (GameState* state = states.getCurrentState())
+            state->update(TICK);
+        GameState* state = states.getCurrentState();
+        if (!state)
+            break;
+
+        frame.clear();
+        frame.setSequence(static_cast<std::uint64_t>(tick));
+        state->render(frame);
+        frame.setState(state->name());
+
+        // reading every frame back waits for the rasterizer, so the time is the
+        // whole frame's
+        sf::Clock clock;
+        DrawCounts counts = renderer.draw(buffer, frame);
+        // the tick and its drawing; reading the frame back is the harness's own
+        allocations = AllocCounter::thisThread() - allocations;
+        sf::Image image = buffer.capture();
+        std::int64_t micros = clock.getElapsedTime().asMicroseconds();
+        renderMicros.push_back(micros);
+        timings << tick << ',' << frame.state() << ',' << counts.drawCalls << ',' << counts.primitives << ','
+                << counts.textureSwitches << ',' << micros << ',' << allocations << ',' << arena.peak() << '\n';
+
+        // as in a scripted game run; reported once as a state goes over
+        if (RenderBudget::within(frame.state(), counts)) {
+            overBudgetState = nullptr;
+        }
+        else {
+            if (overBudgetFrames++ == 0 || frame.state() != overBudgetState) {
+                const DrawCounts* limit = RenderBudget::get(frame.state());
+                std::cerr << "Tick " << tick << ": render budget exceeded in " << frame.state() << ": "
+                          << counts.drawCalls << "/" << limit->drawCalls << " draw calls, "
+                          << counts.primitives << "/" << limit->primitives << " primitives, "
+                          << counts.textureSwitches << "/" << limit->textureSwitches << " texture switches" << std::endl;
+            }
+            overBudgetState = frame.state();
+        }
+
+        if (settings.steadyFrom > 0 && tick >= settings.steadyFrom && tick <= settings.steadyTo && allocations > 0) {
+            if (allocatingTicks++ == 0)
+                std::cerr << "Tick " << tick << ": " << allocations << " heap allocations in a steady-state tick" << std::endl;
+        }
+
+        if (nextCapture < settings.captures.size() && settings.captures[nextCapture] == tick) {
+            if (record)
+                image.saveToFile(imagePath(directory, "frame_", tick));
+            else if (!checkFrame(directory, tick, image, settings))
+                ++failures;
+            ++nextCapture;
+        }
+        if (nextCapture == settings.captures.size() && !script.active())
+            break;
+    }
+
+    for (std::size_t i = nextCapture; i < settings.captures.size(); ++i) {
+        std::cerr << "Tick " << settings.captures[i] << ": the run ended before it" << std::endl;
+        ++failures;
+    }
+
+    std::sort(renderMicros.begin(), renderMicros.end());
+    std::cout << "Render test: " << renderMicros.size() << " frames, render p50 " << percentile(renderMicros, 0.5)
+              << " us, p95 " << percentile(renderMicros, 0.95) << " us, max " << percentile(renderMicros, 1.0) << " us\n";
+    std::cout << "Frame arena high water " << FrameArena::local().highWater() << " of " << FrameArena::local().capacity()
+              << " bytes, " << FrameArena::local().overflows() << " overflows\n";
+    if (record)
+        std::cout << "Recorded " << nextCapture << " golden frames in " << directory << "\n";
+    else
+        std::cout << settings.captures.size() - static_cast<std::size_t>(failures) << " of " << settings.captures.size() << " frames match\n";
+    if (settings.steadyFrom > 0) {
+        std::cout << allocatingTicks << " steady-state ticks allocated"
+                  << (allocatingTicks > 0 ? "; see the allocations column of timings.csv\n" : "\n");
+    }
+    std::cout << overBudgetFrames << " frames over their render budget\n";
+    return failures == 0 && allocatingTicks == 0 && overBudgetFrames == 0 ? 0 : 1;
+}
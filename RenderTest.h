@@ -0,0 +1,38 @@
+#ifndef RENDERTEST_H
+#define RENDERTEST_H
+
+#include <string>
+
+/**
+ * @brief play a scripted run offscreen and check its frames against golden images
+ * @details The test directory holds script.txt, an InputScript, and
+ * render-test.txt, one setting per line ('#' starts a comment):
+ *
+ *     seed 7                 ghost and maze random seed, default 1
+ *     maze 60x40             play in a generated maze instead of the arcade map
+ *     tolerance 16 0.001     per-channel difference a pixel may have, and the
+ *                            fraction of pixels that may exceed it
+ *     capture 30 90 400      sim ticks whose frames are checked
+ *     steady 200 1500        ticks, from the first to the last (the end of the
+ *                            run if left out), that must not touch the heap
+ *                            while ticking and drawing
+ *
+ * The game runs from the main menu in simulated time, one frame per 60 Hz tick,
+ * with no visible window and Mesa's software rasterizer (llvmpipe), so results do
+ * not depend on the GPU or on how fast the machine is. The score table starts
+ * empty. Captured frames are compared against frame_<tick>.png; a mismatch writes
+ * actual_<tick>.png and diff_<tick>.png beside it, and a missing golden image
+ * fails with actual_<tick>.png written, so a new capture tick is never skipped. Every frame's draw counts and
+ * render time, including reading the frame back, go to timings.csv, and the render
+ * time percentiles to stdout. Heap allocations, counted with AllocCounter, and
+ * the most FrameArena scratch in use are recorded per tick in the same file.
+ * Every frame is held to its state's RenderBudget, as a scripted game run is.
+ *
+ * @param directory test directory
+ * @param record write the captured frames as the new golden images instead
+ * @return int process exit code, non-zero if a frame differed, a tick was not
+ * reached, a steady-state tick allocated or a frame went over its budget
+ */
+int runRenderTest(const std::string& directory, bool record);
+
+#endif // RENDERTEST_H
@@ -0,0 +1,79 @@
+#include "ResourceCache.h"
+#include "FrameBuffer.h"
+#include "Metrics.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+struct Cache
+{
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<sf::Texture>> textures;
+    std::map<std::string, std::unique_ptr<sf::Font>> fonts;
+    std::map<std::pair<std::string, unsigned int>, std::unique_ptr<GlyphAtlas>> glyphs;
+};
+
+Cache& cache()
+{
+    // deliberately never destroyed: GL resources must not outlive SFML's contexts,
+    // which are torn down before static destructors run
+    static Cache* instance = new Cache;
+    return *instance;
+}
+
+const sf::Font& loadFont(Cache& c, const std::string& path)
+{
+    std::unique_ptr<sf::Font>& font = c.fonts[path];
+    if (!font) {
+        font = std::make_unique<sf::Font>();
+        if (!font->loadFromFile(path))
+            std::cerr << "Failed to load font: " << path << std::endl;
+    }
+    return *font;
+}
+
+} // namespace
+
+const sf::Texture& ResourceCache::texture(const std::string& path)
+{
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    std::unique_ptr<sf::Texture>& texture = c.textures[path];
+    if (!texture) {
+        texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromFile(path))
+            std::cerr << "Failed to load texture: " << path << std::endl;
+        Metrics::instance().add(Metrics::Counter::TextureLoads);
+    }
+    return *texture;
+}
+
+const sf::Font& ResourceCache::font(const std::string& path)
+{
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return loadFont(c, path);
+}
+
+const GlyphAtlas& ResourceCache::glyphs(const std::string& path, unsigned int characterSize)
+{
+    // building touches the font's glyph pages, so it stays under the lock too
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    std::unique_ptr<GlyphAtlas>& atlas = c.glyphs[std::make_pair(path, characterSize)];
+    if (!atlas) {
+        // text ends up in the native frame, so rasterize it at native pixels and let
+        // the window's integer upscale be the only scaling it sees
+        const unsigned int scale = FrameBuffer::LAYOUT_SCALE;
+        unsigned int nativeSize = std::max(1u, (characterSize + scale / 2) / scale);
+        atlas = std::make_unique<GlyphAtlas>();
+        atlas->build(loadFont(c, path), nativeSize, static_cast<float>(scale));
+    }
+    return *atlas;
+}
@@ -0,0 +1,47 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+
+#include "GlyphAtlas.h"
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+/**
+ * @brief textures, fonts and glyph atlases loaded once and kept for the whole run
+ * @details Frame snapshots refer to textures by pointer and may still be drawn on
+ * the render thread after the state that recorded them is gone, so nothing a
+ * snapshot can point at is ever freed. Every file is also loaded only once, however
+ * many sprites or states use it. Safe to call from any thread.
+ */
+class ResourceCache
+{
+public:
+    /**
+     * @brief get a texture, loading it on first use
+     *
+     * @param path image file
+     * @return const sf::Texture& the texture, empty if the file failed to load
+     */
+    static const sf::Texture& texture(const std::string& path);
+
+    /**
+     * @brief get a font, loading it on first use
+     *
+     * @param path font file
+     * @return const sf::Font& the font, empty if the file failed to load
+     */
+    static const sf::Font& font(const std::string& path);
+
+    /**
+     * @brief get printable ASCII of a font at one size, rasterizing it on first use
+     * @details Rasterized at the nearest native pixel size, one texture pixel to
+     * each arcade pixel, and laid out in layout units as before.
+     *
+     * @param path font file
+     * @param characterSize size in layout units
+     * @return const GlyphAtlas& the atlas
+     */
+    static const GlyphAtlas& glyphs(const std::string& path, unsigned int characterSize);
+};
+
+#endif // RESOURCECACHE_H
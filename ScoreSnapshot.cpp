@@ -0,0 +1,184 @@
+#include "ScoreSnapshot.h"
+#include "FileUtils.h"
+
+#include <cstring>
+
+namespace {
+
+const char MAGIC[4] = { 'P', 'M', 'S', 'B' };
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t BLOCK_RECORDS = 4096;
+
+void putU32(unsigned char* p, std::uint32_t v)
+{
+    for (int i = 0; i < 4; ++i)
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+void putU64(unsigned char* p, std::uint64_t v)
+{
+    for (int i = 0; i < 8; ++i)
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+std::uint32_t getU32(const unsigned char* p)
+{
+    std::uint32_t v = 0;
+    for (int i = 3; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+std::uint64_t getU64(const unsigned char* p)
+{
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+void encodeHeader(unsigned char* p, std::uint64_t seq, std::uint64_t count)
+{
+    std::memcpy(p, MAGIC, 4);
+    putU32(p + 4, VERSION);
+    putU64(p + 8, seq);
+    putU64(p + 16, count);
+}
+
+bool decodeHeader(const unsigned char* p, std::uint64_t& seq, std::uint64_t& count)
+{
+    if (std::memcmp(p, MAGIC, 4) != 0 || getU32(p + 4) != VERSION)
+        return false;
+    seq = getU64(p + 8);
+    count = getU64(p + 16);
+    return true;
+}
+
+} // namespace
+
+namespace ScoreSnapshot
+{
+
+Reader::~Reader()
+{
+    if (m_file)
+        std::fclose(m_file);
+}
+
+bool Reader::open(const std::string& path)
+{
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file)
+        return false;
+
+    unsigned char header[HEADER_SIZE];
+    if (std::fread(header, 1, HEADER_SIZE, m_file) != HEADER_SIZE || !decodeHeader(header, m_seq, m_count)) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_buffer.resize(BLOCK_RECORDS * RECORD_SIZE);
+    return true;
+}
+
+bool Reader::next(ScoreEntry& out)
+{
+    if (!m_file || m_read >= m_count)
+        return false;
+
+    if (m_bufferPos == m_bufferEnd) {
+        std::size_t got = std::fread(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_bufferEnd = got - got % RECORD_SIZE;
+        m_bufferPos = 0;
+        if (m_bufferEnd == 0)
+            return false;  // truncated file: keep what we have
+    }
+
+    const unsigned char* p = m_buffer.data() + m_bufferPos;
+    out.name.assign(reinterpret_cast<const char*>(p), 3);
+    out.score = static_cast<int>(getU32(p + 4));
+    out.day = getU32(p + 8);
+    m_bufferPos += RECORD_SIZE;
+    ++m_read;
+    return true;
+}
+
+Writer::~Writer()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        std::remove((m_path + ".tmp").c_str());
+    }
+}
+
+bool Writer::open(const std::string& path, std::uint64_t seq)
+{
+    m_path = path;
+    m_seq = seq;
+    m_count = 0;
+    m_file = std::fopen((path + ".tmp").c_str(), "wb");
+    if (!m_file)
+        return false;
+
+    // the record count is patched in by commit()
+    unsigned char header[HEADER_SIZE];
+    encodeHeader(header, m_seq, 0);
+    m_ok = std::fwrite(header, 1, HEADER_SIZE, m_file) == HEADER_SIZE;
+    m_buffer.clear();
+    m_buffer.reserve(BLOCK_RECORDS * RECORD_SIZE);
+    return m_ok;
+}
+
+bool Writer::append(const ScoreEntry& entry)
+{
+    unsigned char record[RECORD_SIZE] = {};
+    for (std::size_t i = 0; i < 3 && i < entry.name.size(); ++i)
+        record[i] = static_cast<unsigned char>(entry.name[i]);
+    putU32(record + 4, static_cast<std::uint32_t>(entry.score));
+    putU32(record + 8, entry.day);
+
+    m_buffer.insert(m_buffer.end(), record, record + RECORD_SIZE);
+    ++m_count;
+    if (m_buffer.size() >= BLOCK_RECORDS * RECORD_SIZE)
+        return flushBuffer();
+    return m_ok;
+}
+
+bool Writer::flushBuffer()
+{
+    if (m_ok && !m_buffer.empty())
+        m_ok = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) == m_buffer.size();
+    m_buffer.clear();
+    return m_ok;
+}
+
+bool Writer::commit()
+{
+    if (!m_file)
+        return false;
+
+    flushBuffer();
+    unsigned char header[HEADER_SIZE];
+    encodeHeader(header, m_seq, m_count);
+    m_ok = m_ok && std::fseek(m_file, 0, SEEK_SET) == 0
+        && std::fwrite(header, 1, HEADER_SIZE, m_file) == HEADER_SIZE
+        && syncFile(m_file);
+
+    std::fclose(m_file);
+    m_file = nullptr;
+
+    std::string tmpPath = m_path + ".tmp";
+    if (!m_ok || !replaceFileAtomically(tmpPath, m_path)) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t readSeq(const std::string& path)
+{
+    Reader reader;
+    return reader.open(path) ? reader.seq() : 0;
+}
+
+} // namespace ScoreSnapshot
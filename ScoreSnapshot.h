@@ -0,0 +1,128 @@
+#ifndef SCORESNAPSHOT_H
+#define SCORESNAPSHOT_H
+
+#include "Leaderboard.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief compact binary score table (scores.bin)
+ * @details Layout, all little-endian:
+ *   header  "PMSB" | u32 version | u64 journal sequence | u64 record count
+ *   record  3 initials | u8 reserved | i32 score | u32 day      (12 bytes)
+ * Records are stored highest score first, so a loader can bulk-build its boards
+ * in one pass without sorting.
+ */
+namespace ScoreSnapshot
+{
+    constexpr std::size_t HEADER_SIZE = 24;
+    constexpr std::size_t RECORD_SIZE = 12;
+
+    /**
+     * @brief streams records out of a snapshot file in large blocks
+     */
+    class Reader
+    {
+    public:
+        Reader() = default;
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /**
+         * @brief open a snapshot and validate its header
+         *
+         * @param path snapshot file
+         * @return true if the file exists and is a snapshot
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief read the next record
+         *
+         * @param out filled with the record
+         * @return true if a record was read
+         */
+        bool next(ScoreEntry& out);
+
+        /**
+         * @brief journal sequence number folded into this snapshot
+         */
+        std::uint64_t seq() const { return m_seq; }
+
+        /**
+         * @brief number of records in the snapshot
+         */
+        std::uint64_t count() const { return m_count; }
+
+    private:
+        std::FILE* m_file = nullptr;
+        std::uint64_t m_seq = 0;
+        std::uint64_t m_count = 0;
+        std::uint64_t m_read = 0;
+        std::vector<unsigned char> m_buffer;
+        std::size_t m_bufferPos = 0;
+        std::size_t m_bufferEnd = 0;
+    };
+
+    /**
+     * @brief writes a snapshot to a temporary file, then swaps it in atomically
+     */
+    class Writer
+    {
+    public:
+        Writer() = default;
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        /**
+         * @brief start a new snapshot; it is written to path + ".tmp"
+         *
+         * @param path final snapshot path
+         * @param seq journal sequence number folded into the snapshot
+         * @return true if the temporary file could be created
+         */
+        bool open(const std::string& path, std::uint64_t seq);
+
+        /**
+         * @brief append a record; records must be appended highest score first
+         *
+         * @param entry record to write
+         * @return true on success
+         */
+        bool append(const ScoreEntry& entry);
+
+        /**
+         * @brief finish the header, sync, and rename over the final path
+         *
+         * @return true if the new snapshot is in place
+         */
+        bool commit();
+
+    private:
+        bool flushBuffer();
+
+        std::FILE* m_file = nullptr;
+        std::string m_path;
+        std::uint64_t m_seq = 0;
+        std::uint64_t m_count = 0;
+        std::vector<unsigned char> m_buffer;
+        bool m_ok = false;
+    };
+
+    /**
+     * @brief read only the journal sequence number of a snapshot
+     *
+     * @param path snapshot file
+     * @return std::uint64_t the sequence number, 0 if the file is missing
+     */
+    std::uint64_t readSeq(const std::string& path);
+}
+
+#endif // SCORESNAPSHOT_H
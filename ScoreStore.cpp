@@ -0,0 +1,356 @@
+#include "ScoreStore.h"
+#include "FileUtils.h"
+#include "Metrics.h"
+#include "ScoreSnapshot.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// journal records before the I/O thread folds them into the snapshot; large tables
+// compact proportionally less often so the rewrite cost stays amortised
+constexpr std::size_t COMPACT_THRESHOLD = 32;
+constexpr std::size_t COMPACT_RATIO = 64;
+
+struct JournalRecord
+{
+    std::uint64_t seq;
+    ScoreEntry entry;
+};
+
+// "ABC12345" -> {"ABC", 12345}; rejects torn or malformed text.
+bool parseEntry(const std::string& text, ScoreEntry& out)
+{
+    if (text.size() < 4)
+        return false;
+    const char* digits = text.c_str() + 3;
+    char* end = nullptr;
+    long value = std::strtol(digits, &end, 10);
+    if (end == digits || (*end != '\0' && *end != '\r'))
+        return false;
+    out.name = text.substr(0, 3);
+    out.score = static_cast<int>(value);
+    return true;
+}
+
+std::string formatJournal(std::uint64_t seq, const ScoreEntry& entry)
+{
+    return std::to_string(seq) + " " + std::to_string(entry.day) + " "
+        + entry.name + std::to_string(entry.score) + "\n";
+}
+
+bool higherScore(const ScoreEntry& a, const ScoreEntry& b)
+{
+    return a.score > b.score;
+}
+
+// Journal format: "<seq> <day> ABC12345" per line ("<seq> ABC12345" from older
+// builds). A record is only trusted once its newline is on disk, so a write torn
+// by a crash is simply ignored. Records already in the snapshot are skipped.
+std::vector<JournalRecord> readJournal(const std::string& path, std::uint64_t afterSeq)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::vector<JournalRecord> records;
+    std::size_t start = 0;
+    for (std::size_t nl = data.find('\n'); nl != std::string::npos; nl = data.find('\n', start)) {
+        std::string line = data.substr(start, nl - start);
+        start = nl + 1;
+
+        std::string::size_type first = line.find(' ');
+        if (first == std::string::npos)
+            continue;
+        JournalRecord record{ std::strtoull(line.c_str(), nullptr, 10), ScoreEntry{} };
+        if (record.seq <= afterSeq)
+            continue;
+
+        std::string::size_type second = line.find(' ', first + 1);
+        std::string text = line.substr(first + 1);
+        if (second != std::string::npos) {
+            record.entry.day = static_cast<std::uint32_t>(std::strtoul(text.c_str(), nullptr, 10));
+            text = line.substr(second + 1);
+        }
+        if (parseEntry(text, record.entry))
+            records.push_back(std::move(record));
+    }
+    return records;
+}
+
+// Merge the snapshot with the journal into a new snapshot, then empty the journal.
+// The new header records the last folded sequence number, so a crash between the
+// rename and the truncation cannot double-count anything.
+bool compactStore(const std::string& snapshotPath, const std::string& logPath,
+    std::vector<JournalRecord> journal, std::uint64_t seq)
+{
+    // journal is in submission order; a stable sort keeps older entries first on ties
+    std::stable_sort(journal.begin(), journal.end(),
+        [](const JournalRecord& a, const JournalRecord& b) { return higherScore(a.entry, b.entry); });
+
+    ScoreSnapshot::Writer out;
+    if (!out.open(snapshotPath, seq))
+        return false;
+
+    {
+        // the old snapshot must be closed again before it is replaced
+        ScoreSnapshot::Reader old;
+        ScoreEntry current;
+        bool haveOld = old.open(snapshotPath) && old.next(current);
+        auto it = journal.begin();
+        while (haveOld || it != journal.end()) {
+            if (haveOld && (it == journal.end() || current.score >= it->entry.score)) {
+                out.append(current);
+                haveOld = old.next(current);
+            }
+            else {
+                out.append(it->entry);
+                ++it;
+            }
+        }
+    }
+
+    if (!out.commit())
+        return false;
+    writeFileDurably(logPath, std::string(), false);
+    return true;
+}
+
+// set before the store is first used
+std::string s_basePath = "scores";
+
+} // namespace
+
+ScoreStore& ScoreStore::instance()
+{
+    static ScoreStore store(s_basePath);
+    return store;
+}
+
+void ScoreStore::setBasePath(const std::string& basePath)
+{
+    s_basePath = basePath;
+}
+
+std::uint32_t ScoreStore::today()
+{
+    return static_cast<std::uint32_t>(std::time(nullptr) / (24 * 60 * 60));
+}
+
+ScoreStore::ScoreStore(const std::string& basePath)
+    : m_snapshotPath(basePath + ".bin")
+    , m_legacyPath(basePath + ".txt")
+    , m_logPath(basePath + ".log")
+    , m_lockPath(basePath + ".lock")
+{
+    {
+        FileLock lock(m_lockPath);
+        importLegacyTable();
+        reload();
+    }
+    m_ioThread = std::thread(&ScoreStore::ioLoop, this);
+}
+
+ScoreStore::~ScoreStore()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+    }
+    m_queueCv.notify_one();
+    if (m_ioThread.joinable())
+        m_ioThread.join();
+}
+
+int ScoreStore::best() const
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    const std::vector<ScoreEntry>& top = m_boards->allTime().top();
+    return top.empty() ? 0 : top.front().score;
+}
+
+std::vector<ScoreEntry> ScoreStore::top(std::size_t count) const
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    const std::vector<ScoreEntry>& top = m_boards->allTime().top();
+    count = std::min(count, top.size());
+    return std::vector<ScoreEntry>(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+std::vector<ScoreEntry> ScoreStore::dailyTop(std::size_t count) const
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    const Leaderboard* board = m_boards->daily(today());
+    if (!board)
+        return {};
+    count = std::min(count, board->top().size());
+    return std::vector<ScoreEntry>(board->top().begin(), board->top().begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+Placement ScoreStore::placement(int score) const
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    return m_boards->allTime().placement(score);
+}
+
+Placement ScoreStore::dailyPlacement(int score) const
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    const Leaderboard* board = m_boards->daily(today());
+    return board ? board->placement(score) : Placement{};
+}
+
+void ScoreStore::submit(const std::string& name, int score)
+{
+    ScoreEntry entry{ name, score, today() };
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_boards->insert(entry);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_pending.push_back(std::move(entry));
+    }
+    m_queueCv.notify_one();
+}
+
+void ScoreStore::flush()
+{
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_idleCv.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+void ScoreStore::importLegacyTable()
+{
+    std::ifstream probe(m_snapshotPath, std::ios::binary);
+    if (probe.good())
+        return;
+
+    // Old table: optional "#<seq>" header, then one "ABC12345" line per entry.
+    std::ifstream in(m_legacyPath);
+    if (!in.good())
+        return;
+
+    std::vector<ScoreEntry> entries;
+    std::uint64_t seq = 0;
+    std::string line;
+    ScoreEntry entry;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[0] == '#')
+            seq = std::strtoull(line.c_str() + 1, nullptr, 10);
+        else if (parseEntry(line, entry))
+            entries.push_back(entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(), higherScore);
+
+    ScoreSnapshot::Writer out;
+    if (out.open(m_snapshotPath, seq)) {
+        for (const ScoreEntry& e : entries)
+            out.append(e);
+        if (out.commit())
+            return;
+    }
+    std::cerr << "Failed to import " << m_legacyPath << std::endl;
+}
+
+void ScoreStore::reload()
+{
+    auto boards = std::make_unique<Leaderboards>();
+
+    // the snapshot is sorted, so the boards can be bulk-built in one pass
+    ScoreSnapshot::Reader reader;
+    std::uint64_t tableSeq = 0;
+    if (reader.open(m_snapshotPath)) {
+        tableSeq = reader.seq();
+        ScoreEntry entry;
+        while (reader.next(entry))
+            boards->appendDescending(entry);
+    }
+    boards->finishBulkLoad();
+
+    std::uint64_t appliedSeq = tableSeq;
+    for (const JournalRecord& record : readJournal(m_logPath, tableSeq)) {
+        boards->insert(record.entry);
+        appliedSeq = std::max(appliedSeq, record.seq);
+    }
+
+    m_tableSeq = tableSeq;
+    m_appliedSeq = appliedSeq;
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    m_boards = std::move(boards);
+}
+
+void ScoreStore::ioLoop()
+{
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    for (;;) {
+        m_queueCv.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty())
+            break;  // stopping and fully drained
+
+        ScoreEntry entry = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_writing = true;
+
+        lock.unlock();
+        commit(entry);
+        lock.lock();
+
+        m_writing = false;
+        m_idleCv.notify_all();
+    }
+}
+
+void ScoreStore::commit(const ScoreEntry& entry)
+{
+    FileLock lock(m_lockPath);
+
+    if (ScoreSnapshot::readSeq(m_snapshotPath) != m_tableSeq) {
+        // another cabinet compacted: rebuild from disk, then re-apply what this
+        // process has shown on screen but not written yet
+        reload();
+        std::lock_guard<std::mutex> queueLock(m_queueMutex);
+        std::lock_guard<std::mutex> indexLock(m_indexMutex);
+        m_boards->insert(entry);
+        for (const ScoreEntry& queued : m_pending)
+            m_boards->insert(queued);
+    }
+
+    // pick up records other cabinets appended since we last looked
+    std::vector<JournalRecord> journal = readJournal(m_logPath, m_tableSeq);
+    std::size_t total = 0;
+    {
+        std::lock_guard<std::mutex> indexLock(m_indexMutex);
+        for (const JournalRecord& record : journal) {
+            if (record.seq > m_appliedSeq) {
+                m_boards->insert(record.entry);
+                m_appliedSeq = record.seq;
+            }
+        }
+        total = m_boards->allTime().size();
+    }
+
+    std::uint64_t seq = m_appliedSeq + 1;
+    if (!writeFileDurably(m_logPath, formatJournal(seq, entry), true)) {
+        std::cerr << "Failed to append to " << m_logPath << std::endl;
+        return;
+    }
+    m_appliedSeq = seq;
+    journal.push_back(JournalRecord{ seq, entry });
+    Metrics::instance().add(Metrics::Counter::ScoreWrites);
+
+    if (journal.size() >= std::max(COMPACT_THRESHOLD, total / COMPACT_RATIO)) {
+        if (compactStore(m_snapshotPath, m_logPath, std::move(journal), seq)) {
+            m_tableSeq = seq;
+            Metrics::instance().add(Metrics::Counter::ScoreWrites);
+        }
+        else
+            std::cerr << "Failed to compact " << m_snapshotPath << std::endl;
+    }
+}
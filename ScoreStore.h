@@ -0,0 +1,169 @@
+#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+#include "Leaderboard.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief process-wide high-score store
+ * @details The table lives in two files: a compacted binary snapshot (scores.bin, see
+ * ScoreSnapshot) and an append-only journal (scores.log). Both are read once per
+ * process into the all-time, daily and per-initials leaderboards; submissions update
+ * the boards immediately and are written to disk by a background I/O thread so the
+ * game never waits on the file system. Writers take an advisory lock on scores.lock,
+ * so several cabinets can share the same files. A plain-text scores.txt from older
+ * builds is imported on first run.
+ */
+class ScoreStore
+{
+public:
+    /**
+     * @brief get the store, loading the score files on first use
+     *
+     * @return ScoreStore& the shared store
+     */
+    static ScoreStore& instance();
+
+    /**
+     * @brief keep the score files somewhere other than ./scores.*
+     * @details Only has an effect before the first instance() call.
+     *
+     * @param basePath path the files are named from, e.g. "scores" for scores.bin
+     */
+    static void setBasePath(const std::string& basePath);
+
+    /**
+     * @brief the current day number used by the daily boards
+     *
+     * @return std::uint32_t days since 1970-01-01 (UTC)
+     */
+    static std::uint32_t today();
+
+    /**
+     * @brief Destroy the Score Store object
+     * @details Drains any queued submissions before returning.
+     */
+    ~ScoreStore();
+
+    ScoreStore(const ScoreStore&) = delete;
+    ScoreStore& operator=(const ScoreStore&) = delete;
+
+    /**
+     * @brief the highest score on record
+     *
+     * @return int best score, 0 when the table is empty
+     */
+    int best() const;
+
+    /**
+     * @brief the best all-time entries, highest first
+     *
+     * @param count maximum number of entries to return
+     * @return std::vector<ScoreEntry> up to count entries
+     */
+    std::vector<ScoreEntry> top(std::size_t count) const;
+
+    /**
+     * @brief the best entries set today, highest first
+     *
+     * @param count maximum number of entries to return
+     * @return std::vector<ScoreEntry> up to count entries
+     */
+    std::vector<ScoreEntry> dailyTop(std::size_t count) const;
+
+    /**
+     * @brief where a score ranks among every game on record
+     *
+     * @param score score to place
+     * @return Placement rank and percentile
+     */
+    Placement placement(int score) const;
+
+    /**
+     * @brief where a score ranks among today's games
+     *
+     * @param score score to place
+     * @return Placement rank and percentile
+     */
+    Placement dailyPlacement(int score) const;
+
+    /**
+     * @brief record a finished game
+     * @details The entry is visible through the queries right away; the disk write
+     * happens later on the I/O thread.
+     *
+     * @param name three-character initials
+     * @param score final score
+     */
+    void submit(const std::string& name, int score);
+
+    /**
+     * @brief block until every queued submission has reached the disk
+     */
+    void flush();
+
+private:
+    /**
+     * @brief Construct a new Score Store object and load the files
+     *
+     * @param basePath path prefix shared by the snapshot, journal and lock files
+     */
+    explicit ScoreStore(const std::string& basePath);
+
+    /**
+     * @brief rebuild every board from the snapshot and journal on disk
+     * @details Must be called with the file lock held.
+     */
+    void reload();
+
+    /**
+     * @brief convert an old plain-text table into a snapshot
+     * @details Must be called with the file lock held.
+     */
+    void importLegacyTable();
+
+    /**
+     * @brief body of the background I/O thread
+     */
+    void ioLoop();
+
+    /**
+     * @brief append one record to the journal, compacting it when it grows too long
+     *
+     * @param entry record to write
+     */
+    void commit(const ScoreEntry& entry);
+
+    std::string m_snapshotPath;
+    std::string m_legacyPath;
+    std::string m_logPath;
+    std::string m_lockPath;
+
+    // in-memory boards, replaced wholesale when another cabinet compacts the files
+    mutable std::mutex m_indexMutex;
+    std::unique_ptr<Leaderboards> m_boards;
+
+    // journal bookkeeping, only touched with the file lock held
+    std::uint64_t m_tableSeq = 0;     // last journal record folded into the snapshot
+    std::uint64_t m_appliedSeq = 0;   // last journal record reflected in m_boards
+
+    // submissions waiting for the I/O thread
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCv;
+    std::condition_variable m_idleCv;
+    std::deque<ScoreEntry> m_pending;
+    bool m_writing = false;
+    bool m_stopping = false;
+    std::thread m_ioThread;
+};
+
+#endif // SCORESTORE_H
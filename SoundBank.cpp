@@ -0,0 +1,137 @@
+#include "SoundBank.h"
+
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+double lerp(double a, double b, double t) { return a + (b - a) * t; }
+
+// one cycle of a triangle wave for phase in [0, 1), in [-1, 1]
+double triangle(double phase) { return 1.0 - 4.0 * std::abs(phase - 0.5); }
+
+/**
+ * @brief synthesize a tone whose pitch follows freq(t) over t in [0, 1)
+ * @details A loop's pitch is nudged so it ends on a whole cycle and wraps without
+ * a click; one-shots get a 5 ms fade at each end instead.
+ */
+template <class Freq>
+std::vector<std::int16_t> tone(double seconds, double gain, bool loop, Freq freq)
+{
+    const double rate = SoundBank::SAMPLE_RATE;
+    std::size_t count = static_cast<std::size_t>(seconds * rate);
+
+    double scale = 1.0;
+    if (loop) {
+        double cycles = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+            cycles += freq(static_cast<double>(i) / static_cast<double>(count)) / rate;
+        scale = std::max(1.0, std::round(cycles)) / cycles;
+    }
+
+    std::vector<std::int16_t> out(count);
+    const double fade = 0.005 * rate;
+    double phase = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        double t = static_cast<double>(i) / static_cast<double>(count);
+        double envelope = 1.0;
+        if (!loop)
+            envelope = std::min({ 1.0, static_cast<double>(i) / fade, static_cast<double>(count - i) / fade });
+        out[i] = static_cast<std::int16_t>(std::lround(triangle(phase) * gain * envelope * 32767.0));
+        phase += freq(t) * scale / rate;
+        phase -= std::floor(phase);
+    }
+    return out;
+}
+
+// arcade-like stand-ins for effects without a file
+std::vector<std::int16_t> synthesize(Sound sound)
+{
+    switch (sound) {
+    case Sound::Waka:
+        return tone(0.16, 0.5, false, [](double t) { return t < 0.5 ? lerp(480.0, 240.0, t * 2.0) : lerp(240.0, 480.0, t * 2.0 - 1.0); });
+    case Sound::Siren:
+        return tone(0.45, 0.3, true, [](double t) { return 500.0 + 250.0 * (1.0 - std::abs(2.0 * t - 1.0)); });
+    case Sound::Frightened:
+        return tone(0.13, 0.25, true, [](double t) { return lerp(250.0, 650.0, t); });
+    case Sound::EatGhost:
+        return tone(0.5, 0.5, false, [](double t) { return lerp(150.0, 1400.0, t * t); });
+    case Sound::Death:
+        return tone(1.4, 0.5, false, [](double t) { return lerp(900.0, 150.0, t) * (1.0 + 0.15 * std::sin(2.0 * PI * 8.0 * t)); });
+    case Sound::Count:
+        break;
+    }
+    return {};
+}
+
+// decode a file to mono at SAMPLE_RATE; false if there is no such file
+bool decode(const std::string& path, std::vector<std::int16_t>& out)
+{
+    if (!std::ifstream(path).good())
+        return false;
+    sf::SoundBuffer buffer;
+    if (!buffer.loadFromFile(path) || buffer.getSampleCount() == 0)
+        return false;
+
+    std::size_t channels = std::max(1u, buffer.getChannelCount());
+    std::size_t frames = static_cast<std::size_t>(buffer.getSampleCount()) / channels;
+    std::vector<double> mono(frames);
+    for (std::size_t f = 0; f < frames; ++f) {
+        double sum = 0.0;
+        for (std::size_t c = 0; c < channels; ++c)
+            sum += buffer.getSamples()[f * channels + c];
+        mono[f] = sum / static_cast<double>(channels);
+    }
+
+    // linear resampling is plenty for short effects
+    double ratio = static_cast<double>(buffer.getSampleRate()) / SoundBank::SAMPLE_RATE;
+    std::size_t count = static_cast<std::size_t>(static_cast<double>(frames) / ratio);
+    out.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        double src = static_cast<double>(i) * ratio;
+        std::size_t at = std::min(static_cast<std::size_t>(src), frames - 1);
+        double next = mono[std::min(at + 1, frames - 1)];
+        out[i] = static_cast<std::int16_t>(std::lround(lerp(mono[at], next, src - static_cast<double>(at))));
+    }
+    return !out.empty();
+}
+
+} // namespace
+
+const char* SoundBank::name(Sound sound)
+{
+    switch (sound) {
+    case Sound::Waka: return "waka";
+    case Sound::Siren: return "siren";
+    case Sound::Frightened: return "frightened";
+    case Sound::EatGhost: return "eat_ghost";
+    case Sound::Death: return "death";
+    case Sound::Count: break;
+    }
+    return "";
+}
+
+std::size_t SoundBank::load()
+{
+    std::size_t fromFiles = 0;
+    for (std::size_t i = 0; i < m_samples.size(); ++i) {
+        Sound sound = static_cast<Sound>(i);
+        bool found = false;
+        for (const char* extension : { ".wav", ".ogg", ".flac" }) {
+            if (decode(std::string("assets/sounds/") + name(sound) + extension, m_samples[i])) {
+                found = true;
+                break;
+            }
+        }
+        if (found)
+            ++fromFiles;
+        else
+            m_samples[i] = synthesize(sound);
+    }
+    return fromFiles;
+}
@@ -0,0 +1,56 @@
+#ifndef SOUNDBANK_H
+#define SOUNDBANK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief the game's sound effects
+ */
+enum class Sound : std::uint8_t
+{
+    Waka,          // Pac-Man eats a dot
+    Siren,         // background loop while ghosts hunt
+    Frightened,    // background loop while ghosts are blue
+    EatGhost,
+    Death,
+    Count
+};
+
+/**
+ * @brief every sound effect decoded once into 16-bit mono at the mixer's rate
+ * @details Each effect is read from assets/sounds/<name>.wav (or .ogg / .flac),
+ * mixed down to mono and resampled on load. Effects with no file get a
+ * synthesized stand-in, so the game always has a full set. Loops are built to
+ * wrap without a click. The buffers never change after load(), so the audio
+ * thread reads them without locking.
+ */
+class SoundBank
+{
+public:
+    static constexpr unsigned int SAMPLE_RATE = 44100;
+
+    /**
+     * @brief decode or synthesize every effect
+     *
+     * @return std::size_t how many effects came from files
+     */
+    std::size_t load();
+
+    /**
+     * @brief one effect's samples
+     */
+    const std::vector<std::int16_t>& samples(Sound sound) const { return m_samples[static_cast<std::size_t>(sound)]; }
+
+    /**
+     * @brief file name stem of an effect, e.g. "waka"
+     */
+    static const char* name(Sound sound);
+
+private:
+    std::array<std::vector<std::int16_t>, static_cast<std::size_t>(Sound::Count)> m_samples;
+};
+
+#endif // SOUNDBANK_H
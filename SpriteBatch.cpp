@@ -0,0 +1,29 @@
+#include "SpriteBatch.h"
+
+void SpriteBatch::addQuad(const sf::FloatRect& dest, const sf::FloatRect& source, const sf::Color& color)
+{
+    float left = dest.left;
+    float top = dest.top;
+    float right = dest.left + dest.width;
+    float bottom = dest.top + dest.height;
+
+    float u1 = source.left;
+    float v1 = source.top;
+    float u2 = source.left + source.width;
+    float v2 = source.top + source.height;
+
+    m_vertices.emplace_back(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1));
+    m_vertices.emplace_back(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+    m_vertices.emplace_back(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+    m_vertices.emplace_back(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+    m_vertices.emplace_back(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+    m_vertices.emplace_back(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2));
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (m_vertices.empty() || !m_texture)
+        return;
+    states.texture = m_texture;
+    target.draw(m_vertices.data(), m_vertices.size(), sf::Triangles, states);
+}
@@ -0,0 +1,65 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief textured quads collected into one vertex list and drawn in a single call
+ * @details Every quad samples the same texture. The vertex storage is kept between
+ * clear() calls, so rebuilding a batch of the same size allocates nothing.
+ */
+class SpriteBatch : public sf::Drawable
+{
+public:
+    /**
+     * @brief Construct a new Sprite Batch object
+     *
+     * @param texture texture every quad samples, may be set later
+     */
+    explicit SpriteBatch(const sf::Texture* texture = nullptr) : m_texture(texture) {}
+
+    /**
+     * @brief Set the Texture object
+     *
+     * @param texture texture every quad samples
+     */
+    void setTexture(const sf::Texture* texture) { m_texture = texture; }
+
+    /**
+     * @brief drop every quad, keeping the storage
+     */
+    void clear() { m_vertices.clear(); }
+
+    /**
+     * @brief make room for a number of quads up front
+     *
+     * @param quads expected quad count
+     */
+    void reserve(std::size_t quads) { m_vertices.reserve(quads * 6); }
+
+    /**
+     * @brief add one axis-aligned quad
+     *
+     * @param dest screen rectangle
+     * @param source texture rectangle in pixels
+     * @param color vertex colour the texture is multiplied by
+     */
+    void addQuad(const sf::FloatRect& dest, const sf::FloatRect& source, const sf::Color& color);
+
+    /**
+     * @brief number of quads in the batch
+     *
+     * @return std::size_t quad count
+     */
+    std::size_t quadCount() const { return m_vertices.size() / 6; }
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    std::vector<sf::Vertex> m_vertices;  // two triangles per quad
+    const sf::Texture* m_texture;
+};
+
+#endif // SPRITEBATCH_H
@@ -0,0 +1,259 @@
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[4] = { 'P', 'M', 'T', 'L' };
+const std::uint16_t FORMAT_VERSION = 1;
+const std::size_t HEADER_BYTES = 8;
+const std::size_t RECORDS_PER_WRITE = 256;
+const auto DRAIN_INTERVAL = std::chrono::milliseconds(100);
+
+const char* const GHOST_NAMES[] = { "blinky", "pinky", "inky", "clyde" };
+const char* const MODE_NAMES[] = { "scatter", "chase", "frightened", "eaten" };
+
+void putU16(unsigned char* out, std::uint16_t v)
+{
+    out[0] = static_cast<unsigned char>(v);
+    out[1] = static_cast<unsigned char>(v >> 8);
+}
+
+void putU32(unsigned char* out, std::uint32_t v)
+{
+    putU16(out, static_cast<std::uint16_t>(v));
+    putU16(out + 2, static_cast<std::uint16_t>(v >> 16));
+}
+
+std::uint16_t getU16(const unsigned char* in)
+{
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+std::uint32_t getU32(const unsigned char* in)
+{
+    return static_cast<std::uint32_t>(getU16(in)) | (static_cast<std::uint32_t>(getU16(in + 2)) << 16);
+}
+
+void encode(const Telemetry::Record& record, unsigned char* out)
+{
+    putU32(out, record.tick);
+    out[4] = static_cast<unsigned char>(record.event);
+    out[5] = record.ghost;
+    out[6] = record.detail;
+    out[7] = record.level;
+    putU16(out + 8, static_cast<std::uint16_t>(record.tileX));
+    putU16(out + 10, static_cast<std::uint16_t>(record.tileY));
+    putU32(out + 12, static_cast<std::uint32_t>(record.value));
+}
+
+Telemetry::Record decode(const unsigned char* in)
+{
+    Telemetry::Record record;
+    record.tick = getU32(in);
+    record.event = static_cast<Telemetry::Event>(in[4]);
+    record.ghost = in[5];
+    record.detail = in[6];
+    record.level = in[7];
+    record.tileX = static_cast<std::int16_t>(getU16(in + 8));
+    record.tileY = static_cast<std::int16_t>(getU16(in + 10));
+    record.value = static_cast<std::int32_t>(getU32(in + 12));
+    return record;
+}
+
+} // namespace
+
+Telemetry& Telemetry::instance()
+{
+    static Telemetry telemetry;
+    return telemetry;
+}
+
+Telemetry::~Telemetry()
+{
+    stop();
+}
+
+bool Telemetry::start(const std::string& path)
+{
+    if (m_running)
+        return true;
+    m_path = path;
+    if (!openLog())
+        return false;
+
+    m_enabled = true;
+    m_running = true;
+    m_writer = std::thread(&Telemetry::runWriter, this);
+    return true;
+}
+
+void Telemetry::stop()
+{
+    if (!m_running)
+        return;
+    m_enabled = false;
+    m_running = false;
+    m_writer.join();
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void Telemetry::record(Event event, int level, sf::Vector2i tile, std::int32_t value, std::uint8_t ghost, std::uint8_t detail)
+{
+    if (!m_enabled)
+        return;
+
+    std::size_t head = m_queueHead.load(std::memory_order_relaxed);
+    std::size_t next = (head + 1) % QUEUE_SIZE;
+    if (next == m_queueTail.load(std::memory_order_acquire)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Record& record = m_queue[head];
+    record.tick = m_tick;
+    record.event = event;
+    record.ghost = ghost;
+    record.detail = detail;
+    record.level = static_cast<std::uint8_t>(std::clamp(level, 0, 255));
+    record.tileX = static_cast<std::int16_t>(tile.x);
+    record.tileY = static_cast<std::int16_t>(tile.y);
+    record.value = value;
+    m_queueHead.store(next, std::memory_order_release);
+}
+
+void Telemetry::runWriter()
+{
+    // a few writes a second; the game never waits on them
+    while (m_running.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(DRAIN_INTERVAL);
+    }
+    drain();
+}
+
+void Telemetry::drain()
+{
+    unsigned char buffer[RECORD_BYTES * RECORDS_PER_WRITE];
+    std::size_t tail = m_queueTail.load(std::memory_order_relaxed);
+    std::size_t head = m_queueHead.load(std::memory_order_acquire);
+    bool wrote = false;
+
+    while (tail != head) {
+        std::size_t count = 0;
+        while (tail != head && count < RECORDS_PER_WRITE) {
+            encode(m_queue[tail], buffer + count * RECORD_BYTES);
+            tail = (tail + 1) % QUEUE_SIZE;
+            ++count;
+        }
+        // the slots are copied out, so the game may reuse them
+        m_queueTail.store(tail, std::memory_order_release);
+
+        std::size_t bytes = count * RECORD_BYTES;
+        if (m_fileBytes + bytes > MAX_FILE_BYTES && m_fileBytes > HEADER_BYTES)
+            rotate();
+        if (m_file && std::fwrite(buffer, 1, bytes, m_file) == bytes) {
+            m_fileBytes += bytes;
+            m_written += count;
+            wrote = true;
+        }
+        head = m_queueHead.load(std::memory_order_acquire);
+    }
+
+    if (wrote)
+        std::fflush(m_file);
+}
+
+bool Telemetry::openLog()
+{
+    m_file = std::fopen(m_path.c_str(), "ab");
+    if (!m_file) {
+        std::cerr << "Failed to open telemetry log: " << m_path << std::endl;
+        return false;
+    }
+    std::fseek(m_file, 0, SEEK_END);
+    long size = std::ftell(m_file);
+    m_fileBytes = size > 0 ? static_cast<std::size_t>(size) : 0;
+
+    // a new file starts with its header
+    if (m_fileBytes == 0) {
+        unsigned char header[HEADER_BYTES];
+        std::memcpy(header, MAGIC, 4);
+        putU16(header + 4, FORMAT_VERSION);
+        putU16(header + 6, static_cast<std::uint16_t>(RECORD_BYTES));
+        std::fwrite(header, 1, HEADER_BYTES, m_file);
+        m_fileBytes = HEADER_BYTES;
+    }
+    return true;
+}
+
+void Telemetry::rotate()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+
+    // log.2 -> log.3, log.1 -> log.2, log -> log.1; the oldest is dropped
+    std::remove((m_path + "." + std::to_string(KEEP_FILES - 1)).c_str());
+    for (int i = KEEP_FILES - 2; i >= 1; --i)
+        std::rename((m_path + "." + std::to_string(i)).c_str(), (m_path + "." + std::to_string(i + 1)).c_str());
+    std::rename(m_path.c_str(), (m_path + ".1").c_str());
+
+    ++m_rotations;
+    openLog();
+}
+
+void Telemetry::report(std::ostream& out) const
+{
+    out << "Telemetry: " << m_written << " events written to " << m_path;
+    if (m_rotations > 0)
+        out << " (rotated " << m_rotations << " times)";
+    out << ", " << m_dropped.load(std::memory_order_relaxed) << " dropped\n";
+}
+
+const char* Telemetry::eventName(Event event)
+{
+    static const char* const NAMES[] = { "round_start", "pellet", "energizer", "ghost_eaten", "death", "mode_change", "level_clear" };
+    std::size_t index = static_cast<std::size_t>(event);
+    return index < static_cast<std::size_t>(Event::Count) ? NAMES[index] : "unknown";
+}
+
+bool Telemetry::toCsv(const std::vector<std::string>& paths, std::ostream& out)
+{
+    out << "tick,event,level,ghost,detail,tile_x,tile_y,value\n";
+    bool ok = true;
+    for (const std::string& path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        unsigned char header[HEADER_BYTES];
+        if (!file.read(reinterpret_cast<char*>(header), HEADER_BYTES) || std::memcmp(header, MAGIC, 4) != 0
+            || getU16(header + 4) != FORMAT_VERSION || getU16(header + 6) != RECORD_BYTES) {
+            std::cerr << "Not a telemetry log: " << path << std::endl;
+            ok = false;
+            continue;
+        }
+
+        // a record cut short by a crash is skipped
+        unsigned char bytes[RECORD_BYTES];
+        while (file.read(reinterpret_cast<char*>(bytes), RECORD_BYTES)) {
+            Record record = decode(bytes);
+            out << record.tick << ',' << eventName(record.event) << ',' << static_cast<int>(record.level) << ',';
+            if (record.ghost < 4)
+                out << GHOST_NAMES[record.ghost];
+            out << ',';
+            if (record.event == Event::ModeChange && record.detail < 4)
+                out << MODE_NAMES[record.detail];
+            else
+                out << static_cast<int>(record.detail);
+            out << ',' << record.tileX << ',' << record.tileY << ',' << record.value << '\n';
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,150 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief gameplay events streamed to a binary log for later analysis
+ * @details The simulation thread records fixed-size events into a lock-free
+ * single-producer ring; recording is a copy and a release store, with no
+ * allocation, lock or system call, and an event that finds the ring full is
+ * counted and dropped instead of waiting. A background thread drains the ring a
+ * few times a second into a log file, rotated by size. toCsv() turns a log back
+ * into text. Off unless started; every call returns straight away then.
+ *
+ * A log file is an 8-byte header ("PMTL", format version, record size, all
+ * little-endian) followed by RECORD_BYTES-byte records, also little-endian:
+ * tick u32, event u8, ghost u8, detail u8, level u8, tile x i16, tile y i16,
+ * value i32.
+ */
+class Telemetry
+{
+public:
+    enum class Event : std::uint8_t
+    {
+        RoundStart,    // the start delay ended; value = lives
+        Pellet,        // value = points
+        Energizer,     // value = points
+        GhostEaten,    // ghost eaten, detail = its place in this energizer's chain, value = points
+        Death,         // ghost = the killer, tile = Pac-Man's, value = score
+        ModeChange,    // scatter/chase phase change, detail = new mode, value = phase index
+        LevelClear,    // value = score
+        Count
+    };
+
+    // ghost field of events no ghost took part in
+    static constexpr std::uint8_t NO_GHOST = 0xFF;
+
+    static constexpr std::size_t RECORD_BYTES = 16;
+    static constexpr std::size_t QUEUE_SIZE = 4096;
+    static constexpr std::size_t MAX_FILE_BYTES = 4 << 20;   // then the log rotates
+    static constexpr int KEEP_FILES = 4;                     // log, log.1, log.2, log.3
+
+    struct Record
+    {
+        std::uint32_t tick;
+        Event event;
+        std::uint8_t ghost;     // 0 Blinky, 1 Pinky, 2 Inky, 3 Clyde, or NO_GHOST
+        std::uint8_t detail;
+        std::uint8_t level;     // capped at 255
+        std::int16_t tileX;
+        std::int16_t tileY;
+        std::int32_t value;
+    };
+
+    /**
+     * @brief get the process-wide stream
+     */
+    static Telemetry& instance();
+
+    /**
+     * @brief open the log and start the writer thread
+     *
+     * @param path log file; appended to, and rotated to path.1 and on when full
+     * @return true if the file could be opened
+     */
+    bool start(const std::string& path);
+
+    /**
+     * @brief write out everything recorded, then close the log
+     */
+    void stop();
+
+    /**
+     * @brief count one simulation tick; events are stamped with the count
+     */
+    void tick() { ++m_tick; }
+
+    /**
+     * @brief record an event; simulation thread only
+     *
+     * @param event what happened
+     * @param level current level
+     * @param tile where it happened
+     * @param value points, score or lives, see Event
+     * @param ghost ghost involved, or NO_GHOST
+     * @param detail event-specific, see Event
+     */
+    void record(Event event, int level, sf::Vector2i tile, std::int32_t value, std::uint8_t ghost = NO_GHOST, std::uint8_t detail = 0);
+
+    /**
+     * @brief print how many events were written and dropped
+     *
+     * @param out stream to write to
+     */
+    void report(std::ostream& out) const;
+
+    /**
+     * @brief convert logs to CSV, one row per event
+     *
+     * @param paths log files, in the order their rows should appear
+     * @param out stream to write to
+     * @return true if every file was a readable log
+     */
+    static bool toCsv(const std::vector<std::string>& paths, std::ostream& out);
+
+    /**
+     * @brief readable name of an event, as used in the CSV
+     */
+    static const char* eventName(Event event);
+
+private:
+    Telemetry() = default;
+    ~Telemetry();
+
+    void runWriter();
+    void drain();
+    bool openLog();
+    void rotate();
+
+    // simulation thread -> writer thread, single producer and single consumer
+    std::array<Record, QUEUE_SIZE> m_queue{};
+    std::atomic<std::size_t> m_queueHead{ 0 };   // next slot to write
+    std::atomic<std::size_t> m_queueTail{ 0 };   // next slot to read
+    std::atomic<std::uint64_t> m_dropped{ 0 };   // events lost to a full queue
+
+    // simulation thread only
+    bool m_enabled = false;
+    std::uint32_t m_tick = 0;
+
+    // writer thread only, once started
+    std::string m_path;
+    std::FILE* m_file = nullptr;
+    std::size_t m_fileBytes = 0;
+    std::uint64_t m_written = 0;
+    std::uint32_t m_rotations = 0;
+
+    std::thread m_writer;
+    std::atomic<bool> m_running{ false };
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,41 @@
+#include "TextLabel.h"
+
+void TextLabel::setGlyphs(const GlyphAtlas& glyphs)
+{
+    m_glyphs = &glyphs;
+    layout();
+}
+
+void TextLabel::setString(const std::string& text)
+{
+    m_text = text;
+    layout();
+}
+
+void TextLabel::fitWidth(float maxWidth)
+{
+    m_maxWidth = maxWidth;
+    layout();
+}
+
+void TextLabel::centerOn(sf::Vector2f centre)
+{
+    m_centre = centre;
+    layout();
+}
+
+void TextLabel::layout()
+{
+    if (!m_glyphs)
+        return;
+    sf::FloatRect b = m_glyphs->bounds(m_text.data(), m_text.size());
+    m_scale = m_maxWidth > 0.f && b.width > m_maxWidth ? m_maxWidth / b.width : 1.f;
+    m_position = sf::Vector2f(m_centre.x - (b.left + b.width / 2.f) * m_scale,
+        m_centre.y - (b.top + b.height / 2.f) * m_scale);
+}
+
+void TextLabel::render(FrameSnapshot& frame) const
+{
+    if (m_glyphs)
+        m_glyphs->append(frame, m_text.data(), m_text.size(), m_position, m_scale, m_color);
+}
@@ -0,0 +1,76 @@
+#ifndef TEXTLABEL_H
+#define TEXTLABEL_H
+
+#include "FrameSnapshot.h"
+#include "GlyphAtlas.h"
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+/**
+ * @brief a line of menu text drawn from a glyph atlas
+ * @details Stands in for sf::Text on screens that record frame snapshots. A label
+ * can be centred on a point and capped to a width; both are kept when the string
+ * changes. Oversized text is scaled down as quads rather than re-rasterized.
+ */
+class TextLabel
+{
+public:
+    /**
+     * @brief choose the font and size
+     *
+     * @param glyphs atlas from the ResourceCache
+     */
+    void setGlyphs(const GlyphAtlas& glyphs);
+
+    /**
+     * @brief change the text
+     *
+     * @param text characters, '\n' starts a new line
+     */
+    void setString(const std::string& text);
+
+    /**
+     * @brief change the fill colour
+     *
+     * @param color fill colour
+     */
+    void setColor(const sf::Color& color) { m_color = color; }
+
+    /**
+     * @brief shrink the label whenever it is wider than this
+     *
+     * @param maxWidth width in layout units
+     */
+    void fitWidth(float maxWidth);
+
+    /**
+     * @brief keep the middle of the text's ink on a point
+     *
+     * @param centre point in layout coordinates
+     */
+    void centerOn(sf::Vector2f centre);
+
+    /**
+     * @brief record the label into a frame
+     *
+     * @param frame snapshot to record into
+     */
+    void render(FrameSnapshot& frame) const;
+
+private:
+    /**
+     * @brief recompute scale and position after any change
+     */
+    void layout();
+
+    const GlyphAtlas* m_glyphs = nullptr;
+    std::string m_text;
+    sf::Color m_color = sf::Color::White;
+    sf::Vector2f m_centre;
+    sf::Vector2f m_position;
+    float m_maxWidth = 0.f;   // 0 = no limit
+    float m_scale = 1.f;
+};
+
+#endif // TEXTLABEL_H
@@ -0,0 +1,184 @@
+#ifndef TILEMOVER_H
+#define TILEMOVER_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief integer tile-to-tile movement, one step per simulation tick
+ * @details Progress through the current tile is a 16.16 fixed-point fraction and
+ * speed is the amount added to it every tick, so an actor covers exactly the same
+ * ground on every machine and at every frame rate. Whatever a step overshoots the
+ * next tile by is carried into the following move, which spreads the extra sixteenths
+ * evenly like the arcade's per-frame speed patterns instead of rounding every tile up
+ * to whole ticks. Floats only appear in pixel(), when a frame is drawn.
+ */
+class TileMover
+{
+public:
+    using Fixed = std::uint32_t;
+
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr Fixed ONE_TILE = Fixed(1) << FRACTION_BITS;
+    static constexpr int TICKS_PER_SECOND = 60;
+    static constexpr std::uint32_t NEVER = 0xFFFFFFFFu;   // ticksToArrival() of an actor that is not going anywhere
+
+    /**
+     * @brief convert a speed in tiles per second to the fixed-point step per tick
+     * @details Done once when a speed is chosen, never while moving.
+     */
+    static Fixed speedPerTick(float tilesPerSecond)
+    {
+        if (!(tilesPerSecond > 0.f))
+            return 0;
+        return static_cast<Fixed>(std::lround(static_cast<double>(tilesPerSecond) * ONE_TILE / TICKS_PER_SECOND));
+    }
+
+    explicit TileMover(sf::Vector2i tile = { 0, 0 })
+        : m_tile(tile)
+    {
+    }
+
+    /**
+     * @brief put the actor on a tile, at rest, forgetting any partial move
+     */
+    void place(sf::Vector2i tile)
+    {
+        m_tile = tile;
+        m_progress = 0;
+        m_moving = false;
+    }
+
+    /**
+     * @brief head for the neighbouring tile in dir; only valid while at rest
+     */
+    void start(sf::Vector2i dir)
+    {
+        m_direction = dir;
+        m_moving = true;
+    }
+
+    /**
+     * @brief stay on the current tile; the carried overshoot is dropped
+     */
+    void halt() { m_progress = 0; }
+
+    /**
+     * @brief advance one tick
+     * @return true if the actor reached the next tile on this tick
+     */
+    bool step()
+    {
+        if (!m_moving)
+            return false;
+        m_progress += m_speed;
+        if (m_progress < ONE_TILE)
+            return false;
+        m_progress -= ONE_TILE;
+        m_tile += m_direction;
+        m_moving = false;
+        return true;
+    }
+
+    /**
+     * @brief ticks of step() until the actor reaches the next tile, counting the arriving one
+     * @details Fixed-point speed makes this exact, so a scheduler can file the actor
+     * under its arrival tick and leave it alone until then.
+     *
+     * @return std::uint32_t ticks to arrival, or NEVER when at rest or stopped
+     */
+    std::uint32_t ticksToArrival() const
+    {
+        if (!m_moving || m_speed == 0)
+            return NEVER;
+        return (ONE_TILE - m_progress + m_speed - 1) / m_speed;
+    }
+
+    /**
+     * @brief the same as ticks calls to step(), in one go
+     * @details Stops at the arrival if it comes first, so the actor never runs
+     * past a tile where it had a decision to make.
+     *
+     * @return true if the actor reached the next tile within those ticks
+     */
+    bool advance(std::uint32_t ticks)
+    {
+        if (!m_moving)
+            return false;
+        std::uint64_t reached = m_progress + static_cast<std::uint64_t>(m_speed) * ticks;
+        if (reached < ONE_TILE) {
+            m_progress = static_cast<Fixed>(reached);
+            return false;
+        }
+        // usually the arrival is the last of the ticks; otherwise find its overshoot
+        if (reached - ONE_TILE >= m_speed)
+            reached = m_progress + static_cast<std::uint64_t>(m_speed) * ticksToArrival();
+        m_progress = static_cast<Fixed>(reached - ONE_TILE);
+        m_tile += m_direction;
+        m_moving = false;
+        return true;
+    }
+
+    void setSpeed(Fixed perTick) { m_speed = perTick; }
+    Fixed speed() const { return m_speed; }
+
+    /**
+     * @brief the tile being left, or the one the actor rests on
+     */
+    sf::Vector2i tile() const { return m_tile; }
+
+    /**
+     * @brief where the move in progress ends; the current tile when at rest
+     */
+    sf::Vector2i target() const { return m_moving ? m_tile + m_direction : m_tile; }
+
+    sf::Vector2i direction() const { return m_direction; }
+    bool moving() const { return m_moving; }
+    Fixed progress() const { return m_moving ? m_progress : 0; }
+
+    /**
+     * @brief progress() as it will be ticks steps from now, short of the arrival
+     * @details Lets an actor that is only brought up to date at arrivals be drawn
+     * in between without stepping it.
+     */
+    Fixed progressAfter(std::uint32_t ticks) const
+    {
+        if (!m_moving)
+            return 0;
+        std::uint32_t arrival = ticksToArrival();
+        if (ticks >= arrival)
+            ticks = arrival - 1;   // drawn on the last tick before it gets there
+        return m_progress + m_speed * ticks;
+    }
+
+    /**
+     * @brief jump to an equivalent tile without losing progress, e.g. through the side tunnel
+     */
+    void wrapTo(sf::Vector2i tile) { m_tile = tile; }
+
+    /**
+     * @brief screen position of the actor, for drawing and hit boxes
+     *
+     * @param origin pixel position of tile (0, 0)
+     * @param tileSize size of one tile in pixels
+     * @param ticksAhead steps not yet taken, for an actor last brought up to date that many ticks ago
+     */
+    sf::Vector2f pixel(sf::Vector2f origin, sf::Vector2f tileSize, std::uint32_t ticksAhead = 0) const
+    {
+        float fraction = static_cast<float>(progressAfter(ticksAhead)) / static_cast<float>(ONE_TILE);
+        sf::Vector2i dir = m_moving ? m_direction : sf::Vector2i{ 0, 0 };
+        return sf::Vector2f(
+            origin.x + (static_cast<float>(m_tile.x) + static_cast<float>(dir.x) * fraction) * tileSize.x,
+            origin.y + (static_cast<float>(m_tile.y) + static_cast<float>(dir.y) * fraction) * tileSize.y);
+    }
+
+private:
+    sf::Vector2i m_tile;
+    sf::Vector2i m_direction{ 0, 0 };
+    Fixed m_progress = 0;   // fraction of the way to the next tile, carries overshoot while at rest
+    Fixed m_speed = 0;      // added to m_progress every tick
+    bool m_moving = false;
+};
+
+#endif // TILEMOVER_H
@@ -0,0 +1,101 @@
+#include "TimerWheel.h"
+#include "TileMover.h"
+
+#include <cmath>
+
+std::uint32_t TimerWheel::ticksFor(float seconds)
+{
+    if (!(seconds > 0.f))
+        return 0;
+    return static_cast<std::uint32_t>(std::lround(static_cast<double>(seconds) * TileMover::TICKS_PER_SECOND));
+}
+
+TimerWheel::TimerWheel()
+    : m_slots(SLOTS, NONE)
+{
+}
+
+TimerWheel::Id TimerWheel::add(std::function<void()> onExpiry)
+{
+    Timer timer;
+    timer.onExpiry = std::move(onExpiry);
+    m_timers.push_back(std::move(timer));
+    // every timer can come due on the same tick
+    m_due.reserve(m_timers.size());
+    return static_cast<Id>(m_timers.size() - 1);
+}
+
+void TimerWheel::start(Id timer, std::uint32_t ticks)
+{
+    Timer& t = m_timers[timer];
+    if (t.filed)
+        unfile(timer);
+    t.expiry = m_now + (ticks > 0 ? ticks : 1);
+    t.running = true;
+    file(timer);
+}
+
+void TimerWheel::stop(Id timer)
+{
+    if (m_timers[timer].filed)
+        unfile(timer);
+    m_timers[timer].running = false;
+}
+
+std::uint32_t TimerWheel::remaining(Id timer) const
+{
+    const Timer& t = m_timers[timer];
+    return t.running ? static_cast<std::uint32_t>(t.expiry - m_now) : 0;
+}
+
+void TimerWheel::tick()
+{
+    ++m_now;
+
+    // take out what expires now first, so the calls below can start and stop timers freely
+    m_due.clear();
+    Id id = m_slots[static_cast<std::size_t>(m_now & (SLOTS - 1))];
+    while (id != NONE) {
+        Id next = m_timers[id].next;
+        if (m_timers[id].expiry == m_now) {
+            unfile(id);
+            m_due.push_back(id);
+        }
+        id = next;
+    }
+
+    for (Id due : m_due) {
+        // an earlier call this tick may have stopped or restarted it
+        Timer& t = m_timers[due];
+        if (!t.running || t.filed)
+            continue;
+        t.running = false;
+        t.onExpiry();
+    }
+}
+
+void TimerWheel::file(Id timer)
+{
+    Timer& t = m_timers[timer];
+    Id& head = m_slots[static_cast<std::size_t>(t.expiry & (SLOTS - 1))];
+    t.prev = NONE;
+    t.next = head;
+    if (head != NONE)
+        m_timers[head].prev = timer;
+    head = timer;
+    t.filed = true;
+}
+
+void TimerWheel::unfile(Id timer)
+{
+    Timer& t = m_timers[timer];
+    if (t.prev != NONE)
+        m_timers[t.prev].next = t.next;
+    else
+        m_slots[static_cast<std::size_t>(t.expiry & (SLOTS - 1))] = t.next;
+    if (t.next != NONE)
+        m_timers[t.next].prev = t.prev;
+    t.prev = NONE;
+    t.next = NONE;
+    t.filed = false;
+}
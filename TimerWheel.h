@@ -0,0 +1,97 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief game timers counted in simulation ticks, each with a call on expiry
+ * @details Every timer a state needs is made once with add(), then started,
+ * restarted and stopped as play goes on; each of those is O(1) and none
+ * allocates. A running timer is linked into one slot of a hashed timing wheel,
+ * slot expiry mod SLOTS, and stopping or restarting unlinks it again, so a timer
+ * is never filed twice and the wheel holds at most one entry per timer. tick()
+ * moves the clock on by one and calls whatever expires; a timer further off than
+ * the wheel is wide just stays in its slot for another lap. Time only passes when
+ * the owner calls tick(), so pausing is not calling it and a run without a frame
+ * cap or from a replay keeps the same timing as a real-time one.
+ */
+class TimerWheel
+{
+public:
+    using Id = std::uint32_t;
+
+    /**
+     * @brief the ticks closest to a length of time, at TileMover::TICKS_PER_SECOND
+     */
+    static std::uint32_t ticksFor(float seconds);
+
+    TimerWheel();
+
+    /**
+     * @brief make a stopped timer
+     *
+     * @param onExpiry called from tick() when it runs out; may start timers, itself included
+     * @return Id handle for the other calls
+     */
+    Id add(std::function<void()> onExpiry);
+
+    /**
+     * @brief run out ticks from now, forgetting any earlier start
+     *
+     * @param timer from add()
+     * @param ticks at least 1; 0 counts as 1
+     */
+    void start(Id timer, std::uint32_t ticks);
+
+    /**
+     * @brief stop without calling it
+     */
+    void stop(Id timer);
+
+    /**
+     * @brief whether a timer is counting down
+     */
+    bool running(Id timer) const { return m_timers[timer].running; }
+
+    /**
+     * @brief ticks until a running timer runs out, 0 if stopped
+     */
+    std::uint32_t remaining(Id timer) const;
+
+    /**
+     * @brief one simulation tick, calling every timer that runs out on it
+     */
+    void tick();
+
+    /**
+     * @brief ticks since the wheel was made
+     */
+    std::uint64_t now() const { return m_now; }
+
+private:
+    static constexpr std::size_t SLOTS = 64;   // a power of two
+    static constexpr Id NONE = 0xFFFFFFFFu;
+
+    struct Timer
+    {
+        std::function<void()> onExpiry;
+        std::uint64_t expiry = 0;
+        bool running = false;
+        bool filed = false;   // linked into its slot
+        Id prev = NONE;
+        Id next = NONE;
+    };
+
+    void file(Id timer);
+    void unfile(Id timer);
+
+    std::vector<Timer> m_timers;
+    std::vector<Id> m_slots;   // first timer in each slot's list
+    std::vector<Id> m_due;     // reused by tick(); room for every timer
+    std::uint64_t m_now = 0;
+};
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,66 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief hands the newest value from one producer thread to one consumer thread
+ * @details Three slots: the producer fills one, the consumer reads another and the
+ * third holds the most recent finished value. publish() and acquire() swap a slot
+ * with the middle one in a single atomic exchange, so neither side ever waits or
+ * locks, and the consumer always sees the latest value; values it never got round
+ * to are dropped. Slots are reused, so T may keep its storage between uses.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * @brief the slot the producer is filling; only the producer may touch it
+     *
+     * @return T& the write slot, still holding whatever was last written to it
+     */
+    T& write() { return m_slots[m_write]; }
+
+    /**
+     * @brief make the write slot the newest value and take a fresh one to write
+     */
+    void publish()
+    {
+        std::uint8_t previous = m_middle.exchange(static_cast<std::uint8_t>(m_write | FRESH), std::memory_order_acq_rel);
+        m_write = previous & INDEX;
+    }
+
+    /**
+     * @brief move the consumer onto the newest value, if one was published
+     *
+     * @return true if read() now returns a value it has not seen before
+     */
+    bool acquire()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        std::uint8_t previous = m_middle.exchange(m_read, std::memory_order_acq_rel);
+        m_read = previous & INDEX;
+        return true;
+    }
+
+    /**
+     * @brief the slot the consumer is reading; only the consumer may touch it
+     *
+     * @return const T& the newest value as of the last acquire()
+     */
+    const T& read() const { return m_slots[m_read]; }
+
+private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;   // middle slot holds an unread value
+
+    T m_slots[3];
+    std::uint8_t m_write = 0;
+    std::uint8_t m_read = 1;
+    std::atomic<std::uint8_t> m_middle{ 2 };
+};
+
+#endif // TRIPLEBUFFER_H
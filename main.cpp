@@ -3,11 +3,201 @@ CSCI 200: Final Project PACKMAN
 Author: Max Kacere
 */
 
+#include "AllocCounter.h"
+#include "AudioEngine.h"
+#include "Benchmarks.h"
 #include "Game.h"
+#include "LatencyProbe.h"
+#include "LevelParams.h"
+#include "MazeGenerator.h"
+#include "MazeLayout.h"
+#include "MetricsServer.h"
+#include "RenderBudget.h"
+#include "RenderTest.h"
+#include "Telemetry.h"
 
-int main()
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// a whole number above 0 and nothing else; strtoull alone takes "-1", "12abc" and ""
+bool parseCount(const char* text, std::size_t& count)
+{
+    if (!std::isdigit(static_cast<unsigned char>(text[0])))
+        return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value == 0)
+        return false;
+    count = static_cast<std::size_t>(value);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
 {
-    Game game;
+    // developer tools
+    if (argc >= 2 && std::string(argv[1]) == "--bench-leaderboard") {
+        std::size_t count = 10000000;
+        if (argc >= 3 && !parseCount(argv[2], count)) {
+            std::cerr << "usage: " << argv[0] << " --bench-leaderboard [entries]   (entries > 0)" << std::endl;
+            return 1;
+        }
+        return runLeaderboardBenchmark(count);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-movers") {
+        std::size_t count = 1000000;
+        if (argc >= 3 && !parseCount(argv[2], count)) {
+            std::cerr << "usage: " << argv[0] << " --bench-movers [actors]   (actors > 0)" << std::endl;
+            return 1;
+        }
+        return runMoverBenchmark(count);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-decisions") {
+        std::size_t count = 1000000;
+        if (argc >= 3 && !parseCount(argv[2], count)) {
+            std::cerr << "usage: " << argv[0] << " --bench-decisions [ghosts]   (ghosts > 0)" << std::endl;
+            return 1;
+        }
+        return runDecisionBenchmark(count);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-mazegen") {
+        int size = 1000;
+        if (argc >= 3 && !MazeGenerator::parseSide(argv[2], size)) {
+            std::cerr << "usage: " << argv[0] << " --bench-mazegen [side]   (side > 0)" << std::endl;
+            return 1;
+        }
+        return runMazeBenchmark(size);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "--bench-pellets") {
+        int size = 300;
+        if (argc >= 3 && !MazeGenerator::parseSide(argv[2], size)) {
+            std::cerr << "usage: " << argv[0] << " --bench-pellets [side]   (side > 0)" << std::endl;
+            return 1;
+        }
+        return runPelletBenchmark(size);
+    }
+    if (argc >= 3 && std::string(argv[1]) == "--telemetry-to-csv") {
+        std::vector<std::string> logs(argv + 2, argv + argc);
+        return Telemetry::toCsv(logs, std::cout) ? 0 : 1;
+    }
+    if (argc >= 3 && std::string(argv[1]) == "--render-test") {
+        bool record = false;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--record")
+                record = true;
+            if (arg == "--render-budgets" && i + 1 < argc && !RenderBudget::loadOverrides(argv[i + 1]))
+                return 1;
+        }
+        return runRenderTest(argv[2], record);
+    }
+
+    // --scale N sets the window to N times the 224x288 arcade screen
+    unsigned int scale = 3;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--scale")
+            scale = static_cast<unsigned int>(std::max(1ul, std::strtoul(argv[i + 1], nullptr, 10)));
+    }
+
+    Game game(scale);
+
+    // --input-script FILE plays synthetic input and prints input latency on exit;
+    // --latency measures real key presses the same way;
+    // --fps N / --vsync pick the frame pacing, --pacing-stats reports how steady it was;
+    // --levels FILE overrides the per-level tuning table;
+    // --maze FILE plays every round in a maze read from a text file, of any size;
+    // --generate-maze COLUMNSxROWS [--seed N] plays in a generated one instead;
+    // --audio null mixes without a sound card and reports on exit, --audio off mutes;
+    // --telemetry FILE streams gameplay events to a binary log;
+    // --metrics PORT|SOCKET serves health metrics on 127.0.0.1:PORT or a Unix socket;
+    // --render-budgets FILE overrides the per-state draw budgets, which a scripted
+    // run must keep to or exit with an error;
+    // --count-allocations reports every snapshot whose ticks or drawing used the heap
+    AudioEngine::Device audio = AudioEngine::Device::System;
+    std::string generatedSize;
+    std::uint32_t seed = 1;
+    bool telemetry = false;
+    bool scripted = false;
+    MetricsServer metrics;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--levels" && i + 1 < argc && !LevelTable::loadOverrides(argv[i + 1]))
+            return 1;
+        if (arg == "--maze" && i + 1 < argc) {
+            std::shared_ptr<const MazeLayout> maze = MazeLayout::loadText(argv[i + 1]);
+            if (!maze)
+                return 1;
+            MazeLayout::setCustom(maze);
+        }
+        if (arg == "--generate-maze" && i + 1 < argc)
+            generatedSize = argv[i + 1];
+        if (arg == "--seed" && i + 1 < argc)
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        if (arg == "--render-budgets" && i + 1 < argc && !RenderBudget::loadOverrides(argv[i + 1]))
+            return 1;
+        if (arg == "--input-script" && i + 1 < argc) {
+            if (!game.loadInputScript(argv[i + 1]))
+                return 1;
+            scripted = true;
+        }
+        if (arg == "--latency")
+            LatencyProbe::instance().setEnabled(true);
+        if (arg == "--fps" && i + 1 < argc)
+            game.setFrameRate(static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10)));
+        if (arg == "--vsync")
+            game.setVerticalSync(true);
+        if (arg == "--pacing-stats")
+            game.setPacingStats(true);
+        if (arg == "--count-allocations")
+            AllocCounter::enable();
+        if (arg == "--telemetry" && i + 1 < argc) {
+            telemetry = Telemetry::instance().start(argv[i + 1]);
+            if (!telemetry)
+                return 1;
+        }
+        if (arg == "--metrics" && i + 1 < argc && !metrics.start(argv[i + 1]))
+            return 1;
+        if (arg == "--audio" && i + 1 < argc) {
+            std::string device = argv[i + 1];
+            audio = device == "null" ? AudioEngine::Device::Null
+                : device == "off" ? AudioEngine::Device::Off
+                : AudioEngine::Device::System;
+        }
+    }
+
+    // "WxH", or one number for a square maze
+    if (!generatedSize.empty()) {
+        int columns = 0;
+        int rows = 0;
+        if (!MazeGenerator::parseSize(generatedSize, columns, rows)) {
+            std::cerr << "--generate-maze takes COLUMNSxROWS or one side, not \"" << generatedSize << "\"" << std::endl;
+            return 1;
+        }
+        MazeLayout::setCustom(MazeGenerator::generate(columns, rows, seed));
+    }
+
+    bool reportAudio = AudioEngine::instance().start(audio) == AudioEngine::Device::Null && audio == AudioEngine::Device::Null;
     game.run();
+    metrics.stop();
+    AudioEngine::instance().stop();
+    if (reportAudio)
+        AudioEngine::instance().report(std::cout);
+    if (telemetry) {
+        Telemetry::instance().stop();
+        Telemetry::instance().report(std::cout);
+    }
+    // scripted runs are the test runs: a render regression fails them
+    if (scripted && !game.withinBudget())
+        return 1;
     return 0;
 }